@@ -34,28 +34,39 @@ static int DDSIP_Leaf (void);
 static int DDSIP_GetCurNode (void);
 static int DDSIP_InitNewNodes (void);
 static int DDSIP_SetBounds (void);
+static int DDSIP_GrowNodes (void);
+static void DDSIP_HeapFix (int, int);
+static void DDSIP_FrontAdd (int);
+static void DDSIP_FrontReplace (int, int);
+static void DDSIP_FrontDelete (int);
+static int DDSIP_FrontSortBest (double);
+static double DDSIP_SelectGap (int);
 
 //==========================================================================
 // Select node and value for branching
 int
 DDSIP_GetCurNode (void)
 {
-    int i, change = 0;
+    int i, k, change = 0;
 
     // Unsolved nodes have priority (width first)
     if (DDSIP_param->boundstrat <= 1 || DDSIP_param->boundstrat == 3 || DDSIP_param->boundstrat > 4)
     {
-        for (i = 0; i < DDSIP_bb->nofront; i++)
-            if (!DDSIP_node[DDSIP_bb->front[i]]->solved)
-            {
-                DDSIP_bb->curnode = DDSIP_bb->front[i];
-                change = 1;
-                i = DDSIP_bb->nofront;
-            }
+        // The unsolved nodes are taken in the order of their numbers, i.e. of their generation, not in the order of the
+        // front array (where a deleted node is replaced by the last one). Nodes never become unsolved again,
+        // hence solved nodes and nodes no longer in the front are passed for good
+        while (DDSIP_bb->firstunsolved < DDSIP_bb->nonode &&
+                (DDSIP_node[DDSIP_bb->firstunsolved]->solved || DDSIP_node[DDSIP_bb->firstunsolved]->frontpos < 0))
+            DDSIP_bb->firstunsolved++;
+        if (DDSIP_bb->firstunsolved < DDSIP_bb->nonode)
+        {
+            DDSIP_bb->curnode = DDSIP_bb->firstunsolved;
+            change = 1;
+        }
     }
     if (!change)
     {
-        for (i = 0; i < DDSIP_bb->nofront; i++)
+        for (i = 0; i < DDSIP_bb->nofrontsorted; i++)
         {
             if (!DDSIP_Equal (DDSIP_node[DDSIP_bb->front_nodes_sorted[i]]->dispnorm, DDSIP_param->nulldisp) && !DDSIP_node[DDSIP_bb->front_nodes_sorted[i]]->leaf)
             {
@@ -65,6 +76,20 @@ DDSIP_GetCurNode (void)
             }
         }
     }
+    // The non-leaf front nodes which are not sorted have greater bounds than the sorted ones, take the least bound one among them
+    if (!change && DDSIP_bb->nofrontsorted < DDSIP_bb->nofront)
+    {
+        for (i = 0; i < DDSIP_bb->nofront; i++)
+        {
+            k = DDSIP_bb->front[i];
+            if (!DDSIP_Equal (DDSIP_node[k]->dispnorm, DDSIP_param->nulldisp) && !DDSIP_node[k]->leaf &&
+                    (!change || DDSIP_node[k]->bound < DDSIP_node[DDSIP_bb->curnode]->bound))
+            {
+                DDSIP_bb->curnode = k;
+                change = 1;
+            }
+        }
+    }
 
     if (!change)
         return 113;
@@ -72,39 +97,188 @@ DDSIP_GetCurNode (void)
     return 0;
 }
 
+//==========================================================================
+// Move the node at position pos of the front heap which up or down until the heap is ordered
+// (which = 0: least bound on top, which = 1: greatest bound on top)
+static void
+DDSIP_HeapFix (int which, int pos)
+{
+    int *heap = DDSIP_bb->fheap[which];
+    int nono = heap[pos], child;
+    double sign = which ? -1. : 1.;
+
+    while (pos && sign * DDSIP_node[nono]->bound < sign * DDSIP_node[heap[(pos - 1) / 2]]->bound)
+    {
+        heap[pos] = heap[(pos - 1) / 2];
+        DDSIP_node[heap[pos]]->heappos[which] = pos;
+        pos = (pos - 1) / 2;
+    }
+    while ((child = 2 * pos + 1) < DDSIP_bb->nofront)
+    {
+        if (child + 1 < DDSIP_bb->nofront && sign * DDSIP_node[heap[child + 1]]->bound < sign * DDSIP_node[heap[child]]->bound)
+            child++;
+        if (!(sign * DDSIP_node[heap[child]]->bound < sign * DDSIP_node[nono]->bound))
+            break;
+        heap[pos] = heap[child];
+        DDSIP_node[heap[pos]]->heappos[which] = pos;
+        pos = child;
+    }
+    heap[pos] = nono;
+    DDSIP_node[nono]->heappos[which] = pos;
+}
+
+//==========================================================================
+// Append node nono to the front
+static void
+DDSIP_FrontAdd (int nono)
+{
+    int which;
+
+    DDSIP_bb->front[DDSIP_bb->nofront] = nono;
+    DDSIP_node[nono]->frontpos = DDSIP_bb->nofront;
+    DDSIP_bb->nofront++;
+    for (which = 0; which < 2; which++)
+    {
+        DDSIP_bb->fheap[which][DDSIP_bb->nofront - 1] = nono;
+        DDSIP_HeapFix (which, DDSIP_bb->nofront - 1);
+    }
+}
+
+//==========================================================================
+// Node nono takes the place of node old in the front
+static void
+DDSIP_FrontReplace (int old, int nono)
+{
+    int which;
+
+    DDSIP_bb->front[DDSIP_node[old]->frontpos] = nono;
+    DDSIP_node[nono]->frontpos = DDSIP_node[old]->frontpos;
+    DDSIP_node[old]->frontpos = -1;
+    for (which = 0; which < 2; which++)
+    {
+        DDSIP_bb->fheap[which][DDSIP_node[old]->heappos[which]] = nono;
+        DDSIP_HeapFix (which, DDSIP_node[old]->heappos[which]);
+        DDSIP_node[old]->heappos[which] = -1;
+    }
+}
+
+//==========================================================================
+// Delete node nono from the front, the last front node takes its place
+static void
+DDSIP_FrontDelete (int nono)
+{
+    int which, last;
+
+    DDSIP_bb->nofront--;
+    last = DDSIP_bb->front[DDSIP_bb->nofront];
+    DDSIP_bb->front[DDSIP_node[nono]->frontpos] = last;
+    DDSIP_node[last]->frontpos = DDSIP_node[nono]->frontpos;
+    DDSIP_node[nono]->frontpos = -1;
+    for (which = 0; which < 2; which++)
+    {
+        last = DDSIP_bb->fheap[which][DDSIP_bb->nofront];
+        if (last != nono)
+        {
+            DDSIP_bb->fheap[which][DDSIP_node[nono]->heappos[which]] = last;
+            DDSIP_HeapFix (which, DDSIP_node[nono]->heappos[which]);
+        }
+        DDSIP_node[nono]->heappos[which] = -1;
+    }
+}
+
+//==========================================================================
+// Enlarge DDSIP_node, the suggestions and the front if the two new nodes do not fit
+static int
+DDSIP_GrowNodes (void)
+{
+    int i, cap, oldfront;
+    node_t **node;
+    sug_t **sug;
+    int *front;
+
+    if (DDSIP_bb->nonode + 1 < DDSIP_bb->nodecap)
+        return 0;
+    cap = (int) DDSIP_Dmin (2. * DDSIP_bb->nodecap, DDSIP_param->nodelim + 3.);
+    if (cap < DDSIP_bb->nonode + 2)
+    {
+        fprintf (stderr, "ERROR: Node limit exceeded (GrowNodes).\n");
+        return 1;
+    }
+
+    node = (node_t **) DDSIP_Alloc (sizeof (node_t *), cap, "node(GrowNodes)");
+    memcpy (node, DDSIP_node, sizeof (node_t *) * DDSIP_bb->nodecap);
+    DDSIP_Free ((void **) &(DDSIP_node));
+    DDSIP_node = node;
+
+    // sug[nodecap] holds the suggestion to be evaluated
+    sug = (sug_t **) DDSIP_Alloc (sizeof (sug_t *), cap + 1, "sug(GrowNodes)");
+    memcpy (sug, DDSIP_bb->sug, sizeof (sug_t *) * DDSIP_bb->nodecap);
+    sug[cap] = DDSIP_bb->sug[DDSIP_bb->nodecap];
+    DDSIP_Free ((void **) &(DDSIP_bb->sug));
+    DDSIP_bb->sug = sug;
+
+    oldfront = (int) ceil (0.5 * DDSIP_bb->nodecap) + 3;
+    front = (int *) DDSIP_Alloc (sizeof (int), (int) ceil (0.5 * cap) + 3, "front(GrowNodes)");
+    memcpy (front, DDSIP_bb->front, sizeof (int) * oldfront);
+    DDSIP_Free ((void **) &(DDSIP_bb->front));
+    DDSIP_bb->front = front;
+    for (i = 0; i < 2; i++)
+    {
+        front = (int *) DDSIP_Alloc (sizeof (int), (int) ceil (0.5 * cap) + 3, "fheap(GrowNodes)");
+        memcpy (front, DDSIP_bb->fheap[i], sizeof (int) * oldfront);
+        DDSIP_Free ((void **) &(DDSIP_bb->fheap[i]));
+        DDSIP_bb->fheap[i] = front;
+    }
+    DDSIP_Free ((void **) &(DDSIP_bb->frontbuf));
+    DDSIP_bb->frontbuf = (int *) DDSIP_Alloc (sizeof (int), (int) ceil (0.5 * cap) + 3, "frontbuf(GrowNodes)");
+    front = (int *) DDSIP_Alloc (sizeof (int), (int) ceil (0.5 * cap) + 3, "front_nodes_sorted(GrowNodes)");
+    memcpy (front, DDSIP_bb->front_nodes_sorted, sizeof (int) * oldfront);
+    DDSIP_Free ((void **) &(DDSIP_bb->front_nodes_sorted));
+    DDSIP_bb->front_nodes_sorted = front;
+    // the sort keys are set anew in each call of DDSIP_Bound
+    DDSIP_Free ((void **) &(DDSIP_bb->front_node_bound));
+    DDSIP_bb->front_node_bound = (double *) DDSIP_Alloc (sizeof (double), cap, "front_node_bound(GrowNodes)");
+
+    if (DDSIP_param->outlev > 2)
+        fprintf (DDSIP_bb->moreoutfile, "Room for nodes enlarged from %d to %d.\n", DDSIP_bb->nodecap, cap);
+    DDSIP_bb->nodecap = cap;
+    return 0;
+}
+
 //==========================================================================
 // Function initializes new nodes in b&b-tree
 int
 DDSIP_InitNewNodes (void)
 {
     int i, j, status, scen, cnt;
-    double branchval, lhs;
-    cutpool_t *currentCut;
+    int *first, *next, *cutind = NULL;
+    double branchval, *viol = NULL;
 
     if (DDSIP_param->outlev > 2)
     {
         fprintf (DDSIP_bb->moreoutfile, "\n----------------------\n");
         fprintf (DDSIP_bb->moreoutfile, "Branching node %d...\n", DDSIP_bb->curnode);
     }
+    if ((status = DDSIP_GrowNodes ()))
+        return status;
+    // The arrays of pruned nodes are reused
     DDSIP_node[DDSIP_bb->nonode] = (node_t *) DDSIP_Alloc (sizeof (node_t), 1, "DDSIP_node[nonode](InitNewNodes)");
     DDSIP_node[DDSIP_bb->nonode]->first_sol =
-        (double **) DDSIP_Alloc (sizeof (double *), DDSIP_param->scenarios, "DDSIP_node[nonode]->first_sol(InitNewNodes)");
-    for (i=0; i<DDSIP_param->scenarios;  DDSIP_node[DDSIP_bb->nonode]->first_sol[i++]=NULL);
+        (double **) DDSIP_PoolGet (pool_first_sol, sizeof (double *), DDSIP_param->scenarios, "DDSIP_node[nonode]->first_sol(InitNewNodes)");
     DDSIP_node[DDSIP_bb->nonode]->cursubsol =
-        (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios, "DDSIP_node[nonode]->cursubsol(InitNewNodes)");
-    DDSIP_node[DDSIP_bb->nonode]->mipstatus = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "DDSIP_node[nonode]->mipstatus(InitNewNodes)");
+        (double *) DDSIP_PoolGet (pool_cursubsol, sizeof (double), DDSIP_param->scenarios, "DDSIP_node[nonode]->cursubsol(InitNewNodes)");
+    DDSIP_node[DDSIP_bb->nonode]->mipstatus = (int *) DDSIP_PoolGet (pool_mipstatus, sizeof (int), DDSIP_param->scenarios, "DDSIP_node[nonode]->mipstatus(InitNewNodes)");
     DDSIP_node[DDSIP_bb->nonode]->ref_scenobj =
-        (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios, "DDSIP_node[nonode]->ref_scenobj(InitNewNodes)");
+        (double *) DDSIP_PoolGet (pool_ref_scenobj, sizeof (double), DDSIP_param->scenarios, "DDSIP_node[nonode]->ref_scenobj(InitNewNodes)");
     DDSIP_node[DDSIP_bb->nonode + 1] = (node_t *) DDSIP_Alloc (sizeof (node_t), 1, "DDSIP_node[nonode](InitNewNodes)");
     DDSIP_node[DDSIP_bb->nonode + 1]->first_sol =
-        (double **) DDSIP_Alloc (sizeof (double *), DDSIP_param->scenarios, "DDSIP_node[nonode+1]->first_sol(InitNewNodes)");
-    for (i=0; i<DDSIP_param->scenarios;  DDSIP_node[DDSIP_bb->nonode + 1]->first_sol[i++]=NULL);
+        (double **) DDSIP_PoolGet (pool_first_sol, sizeof (double *), DDSIP_param->scenarios, "DDSIP_node[nonode+1]->first_sol(InitNewNodes)");
     DDSIP_node[DDSIP_bb->nonode + 1]->cursubsol =
-        (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios, "DDSIP_node[nonode+1]->cursubsol(InitNewNodes)");
+        (double *) DDSIP_PoolGet (pool_cursubsol, sizeof (double), DDSIP_param->scenarios, "DDSIP_node[nonode+1]->cursubsol(InitNewNodes)");
     DDSIP_node[DDSIP_bb->nonode + 1]->mipstatus =
-        (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "DDSIP_node[nonode]->mipstatus(InitNewNodes)");
+        (int *) DDSIP_PoolGet (pool_mipstatus, sizeof (int), DDSIP_param->scenarios, "DDSIP_node[nonode]->mipstatus(InitNewNodes)");
     DDSIP_node[DDSIP_bb->nonode + 1]->ref_scenobj =
-        (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios, "DDSIP_node[nonode+1]->ref_scenobj(InitNewNodes)");
+        (double *) DDSIP_PoolGet (pool_ref_scenobj, sizeof (double), DDSIP_param->scenarios, "DDSIP_node[nonode+1]->ref_scenobj(InitNewNodes)");
     for (i = 0; i < DDSIP_param->scenarios; i++)
     {
         (DDSIP_node[DDSIP_bb->nonode]->cursubsol)[i] = DDSIP_infty;
@@ -146,7 +320,7 @@ DDSIP_InitNewNodes (void)
     {
         // DDSIP_Allocate memory for subsolutions and bound
         DDSIP_node[DDSIP_bb->nonode]->solut =
-            (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios * DDSIP_bb->total_int, "solut(InitNewNodes)");
+            (double *) DDSIP_PoolGet (pool_solut, sizeof (double), DDSIP_param->scenarios * DDSIP_bb->total_int, "solut(InitNewNodes)");
         // Initialization
         memcpy (DDSIP_node[DDSIP_bb->nonode]->solut, DDSIP_node[DDSIP_bb->curnode]->solut, sizeof (double) * DDSIP_param->scenarios * DDSIP_bb->total_int);
         DDSIP_node[DDSIP_bb->nonode + 1]->solut = DDSIP_node[DDSIP_bb->curnode]->solut;
@@ -154,7 +328,7 @@ DDSIP_InitNewNodes (void)
     }
     // Initialization of lower bounds
     DDSIP_node[DDSIP_bb->nonode]->subbound =
-        (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios, "DDSIP_node[nonode]->subbound(InitNewNodes)");
+        (double *) DDSIP_PoolGet (pool_subbound, sizeof (double), DDSIP_param->scenarios, "DDSIP_node[nonode]->subbound(InitNewNodes)");
     memcpy (DDSIP_node[DDSIP_bb->nonode]->subbound, DDSIP_node[DDSIP_bb->curnode]->subbound, sizeof (double) * DDSIP_param->scenarios);
     //DDSIP_node[DDSIP_bb->nonode + 1]->subbound =
     //  (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios, "DDSIP_node[nonode+1]->subbound(InitNewNodes)");
@@ -165,13 +339,13 @@ DDSIP_InitNewNodes (void)
     // Initialize multiplier in node
     if (DDSIP_param->cb)
     {
-        DDSIP_node[DDSIP_bb->nonode]->dual = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->dimdual + 3, "dual(InitNewNodes)");
+        DDSIP_node[DDSIP_bb->nonode]->dual = (double *) DDSIP_PoolGet (pool_dual, sizeof (double), DDSIP_bb->dimdual + 3, "dual(InitNewNodes)");
         memcpy (DDSIP_node[DDSIP_bb->nonode]->dual, DDSIP_node[DDSIP_bb->curnode]->dual, sizeof (double) * (DDSIP_bb->dimdual + 3));
         DDSIP_node[DDSIP_bb->nonode + 1]->dual = DDSIP_node[DDSIP_bb->curnode]->dual;
         DDSIP_node[DDSIP_bb->curnode]->dual = NULL;
 
         DDSIP_node[DDSIP_bb->nonode]->scenBoundsNoLag =
-            (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios, "DDSIP_node[nonode]->scenBoundsNoLag(InitNewNodes)");
+            (double *) DDSIP_PoolGet (pool_scenBoundsNoLag, sizeof (double), DDSIP_param->scenarios, "DDSIP_node[nonode]->scenBoundsNoLag(InitNewNodes)");
         memcpy (DDSIP_node[DDSIP_bb->nonode]->scenBoundsNoLag, DDSIP_node[DDSIP_bb->curnode]->scenBoundsNoLag, sizeof (double) * DDSIP_param->scenarios);
         DDSIP_node[DDSIP_bb->nonode + 1]->scenBoundsNoLag = DDSIP_node[DDSIP_bb->curnode]->scenBoundsNoLag;
         DDSIP_node[DDSIP_bb->curnode]->scenBoundsNoLag = NULL;
@@ -304,43 +478,34 @@ DDSIP_InitNewNodes (void)
         return 119;
 
     // Inherit scenario solutions of father node
+    // The decision is taken for the first scenario of a group sharing a solution, the others follow it
+    first = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "first(InitNewNodes)");
+    next = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "next(InitNewNodes)");
+    DDSIP_FirstSolGroups (DDSIP_node[DDSIP_bb->curnode]->first_sol, first, next);
+    // if cuts have been inserted test the distinct scenario solutions for violation
+    if (DDSIP_bb->cutpool.cnt && (DDSIP_node[DDSIP_bb->curnode])->cutAdded)
+    {
+        double **cand = (double **) DDSIP_Alloc (sizeof (double *), DDSIP_param->scenarios, "cand(InitNewNodes)");
+        cutind = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "cutind(InitNewNodes)");
+        viol = (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios, "viol(InitNewNodes)");
+        for (i = 0; i < DDSIP_param->scenarios; i++)
+            cand[i] = (first[i] == i) ? ((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i] : NULL;
+        DDSIP_CutPoolCheck (DDSIP_param->scenarios, cand, 1e-7, 0., cutind, viol);
+        DDSIP_Free ((void **) &(cand));
+    }
     for (i = 0; i < DDSIP_param->scenarios; i++)
     {
         if (!(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i]))
             continue;
         cnt = 0;
-        // if cuts have been inserted test the scenario solution for violation
-        if (DDSIP_bb->cutpool && (DDSIP_node[DDSIP_bb->curnode])->cutAdded)
+        if (cutind && cutind[first[i]] >= 0)
         {
-            currentCut = DDSIP_bb->cutpool;
-            while (currentCut)
-            {
-                lhs = 0.;
-                for (j = 0; j < DDSIP_bb->firstvar; j++)
-                {
-                    lhs += (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i])[j] * currentCut->matval[j];
-                }
-                if ((lhs -= currentCut->rhs) < - 1e-7)
-                {
-                    if (DDSIP_param->outlev > 23)
-                        fprintf (DDSIP_bb->moreoutfile,"  nodes %d and %d did not inherit solution of scenario %d from node %d due to added cut %d, violation %g.\n",
-                                 DDSIP_bb->nonode, DDSIP_bb->nonode + 1, i+1, DDSIP_bb->curnode, currentCut->number, -lhs);
-                    if ((cnt = (int) ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i])[DDSIP_bb->firstvar] - 0.9)))
-                        for (j = i + 1; cnt && j < DDSIP_param->scenarios; j++)
-                        {
-                            if (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]
-                                    && ((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i] == ((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j])
-                            {
-                                ((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j] = NULL;
-                                cnt--;
-                            }
-                        }
-                    DDSIP_Free ((void **) &(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i]));
-                    cnt = 1;
-                    break;
-                }
-                currentCut = currentCut->prev;
-            }
+            if (DDSIP_param->outlev > 23)
+                fprintf (DDSIP_bb->moreoutfile,"  nodes %d and %d did not inherit solution of scenario %d from node %d due to added cut %d, violation %g.\n",
+                         DDSIP_bb->nonode, DDSIP_bb->nonode + 1, i+1, DDSIP_bb->curnode, DDSIP_bb->cutpool.number[cutind[first[i]]], viol[first[i]]);
+            for (j = i; j >= 0; j = next[j])
+                DDSIP_FirstSolRelease (&(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]));
+            cnt = 1;
         }
         // skip to next scenario if the current solution violated one of the cuts
         if (cnt)
@@ -377,26 +542,19 @@ DDSIP_InitNewNodes (void)
                                  DDSIP_bb->nonode, i + 1, DDSIP_bb->curnode, (DDSIP_node[DDSIP_bb->nonode]->first_sol)[i][DDSIP_bb->firstvar]);
                     }
                     //do the same for identical solutions
-                    if ((cnt = (int) ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i])[DDSIP_bb->firstvar] - 0.9)))
-                        for (j = i + 1; cnt && j < DDSIP_param->scenarios; j++)
+                    for (j = next[i]; j >= 0; j = next[j])
+                    {
+                        (DDSIP_node[DDSIP_bb->nonode]->first_sol)[j] = (DDSIP_node[DDSIP_bb->curnode]->first_sol)[i];
+                        (DDSIP_node[DDSIP_bb->nonode]->cursubsol)[j] = (DDSIP_node[DDSIP_bb->curnode]->cursubsol)[j];
+                        (DDSIP_node[DDSIP_bb->nonode]->mipstatus)[j] = (DDSIP_node[DDSIP_bb->curnode]->mipstatus)[j];
+                        (DDSIP_node[DDSIP_bb->nonode]->ref_scenobj)[j] = (DDSIP_node[DDSIP_bb->curnode]->ref_scenobj)[j];
+                        (DDSIP_node[DDSIP_bb->curnode]->first_sol)[j] = NULL;
+                        if (DDSIP_param->outlev > 23)
                         {
-                            if (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]
-                                    && ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i]) == (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j])))
-                            {
-                                (DDSIP_node[DDSIP_bb->nonode]->first_sol)[j] = (DDSIP_node[DDSIP_bb->curnode]->first_sol)[i];
-                                (DDSIP_node[DDSIP_bb->nonode]->cursubsol)[j] = (DDSIP_node[DDSIP_bb->curnode]->cursubsol)[j];
-                                (DDSIP_node[DDSIP_bb->nonode]->mipstatus)[j] = (DDSIP_node[DDSIP_bb->curnode]->mipstatus)[j];
-                                (DDSIP_node[DDSIP_bb->nonode]->ref_scenobj)[j] = (DDSIP_node[DDSIP_bb->curnode]->ref_scenobj)[j];
-                                (DDSIP_node[DDSIP_bb->curnode]->first_sol)[j] = NULL;
-                                cnt--;
-                                if (DDSIP_param->outlev > 23)
-                                {
-                                    fprintf (DDSIP_bb->moreoutfile,"  node %d inherited solution of scenario %d from node %d (%g identical scen. solutions)\n",
-                                             DDSIP_bb->nonode, j + 1, DDSIP_bb->curnode, (DDSIP_node[DDSIP_bb->nonode]->first_sol)[j][DDSIP_bb->firstvar]);
-                                }
-                                (DDSIP_node[DDSIP_bb->curnode]->first_sol)[j] = NULL;
-                            }
+                            fprintf (DDSIP_bb->moreoutfile,"  node %d inherited solution of scenario %d from node %d (%g identical scen. solutions)\n",
+                                     DDSIP_bb->nonode, j + 1, DDSIP_bb->curnode, (DDSIP_node[DDSIP_bb->nonode]->first_sol)[j][DDSIP_bb->firstvar]);
                         }
+                    }
                     (DDSIP_node[DDSIP_bb->curnode]->first_sol)[i] = NULL;
                 }
                 else if (((DDSIP_node[DDSIP_bb->curnode])->first_sol[i])[DDSIP_node[DDSIP_bb->nonode]->neoind] >= DDSIP_node[DDSIP_bb->nonode + 1]->neolb)
@@ -419,26 +577,19 @@ DDSIP_InitNewNodes (void)
                                  DDSIP_bb->nonode+1, i + 1, DDSIP_bb->curnode, (DDSIP_node[DDSIP_bb->nonode+1]->first_sol)[i][DDSIP_bb->firstvar]);
                     }
                     //do the same for identical solutions
-                    if ((cnt = (int) ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i])[DDSIP_bb->firstvar] - 0.9)))
-                        for (j = i + 1; cnt && j < DDSIP_param->scenarios; j++)
+                    for (j = next[i]; j >= 0; j = next[j])
+                    {
+                        (DDSIP_node[DDSIP_bb->nonode + 1]->first_sol)[j] = (DDSIP_node[DDSIP_bb->curnode]->first_sol)[i];
+                        (DDSIP_node[DDSIP_bb->nonode + 1]->cursubsol)[j] = (DDSIP_node[DDSIP_bb->curnode]->cursubsol)[j];
+                        (DDSIP_node[DDSIP_bb->nonode + 1]->mipstatus)[j] = (DDSIP_node[DDSIP_bb->curnode]->mipstatus)[j];
+                        (DDSIP_node[DDSIP_bb->nonode + 1]->ref_scenobj)[j] = (DDSIP_node[DDSIP_bb->curnode]->ref_scenobj)[j];
+                        (DDSIP_node[DDSIP_bb->curnode]->first_sol)[j] = NULL;
+                        if (DDSIP_param->outlev > 23)
                         {
-                            if (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]
-                                    && ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i]) == (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j])))
-                            {
-                                (DDSIP_node[DDSIP_bb->nonode + 1]->first_sol)[j] = (DDSIP_node[DDSIP_bb->curnode]->first_sol)[i];
-                                (DDSIP_node[DDSIP_bb->nonode + 1]->cursubsol)[j] = (DDSIP_node[DDSIP_bb->curnode]->cursubsol)[j];
-                                (DDSIP_node[DDSIP_bb->nonode + 1]->mipstatus)[j] = (DDSIP_node[DDSIP_bb->curnode]->mipstatus)[j];
-                                (DDSIP_node[DDSIP_bb->nonode + 1]->ref_scenobj)[j] = (DDSIP_node[DDSIP_bb->curnode]->ref_scenobj)[j];
-                                (DDSIP_node[DDSIP_bb->curnode]->first_sol)[j] = NULL;
-                                cnt--;
-                                if (DDSIP_param->outlev > 23)
-                                {
-                                    fprintf (DDSIP_bb->moreoutfile,"  node %d inherited solution of scenario %d from node %d (%g identical scen. solutions)\n",
-                                             DDSIP_bb->nonode+1, j + 1, DDSIP_bb->curnode, (DDSIP_node[DDSIP_bb->nonode+1]->first_sol)[j][DDSIP_bb->firstvar]);
-                                }
-                                (DDSIP_node[DDSIP_bb->curnode]->first_sol)[j] = NULL;
-                            }
+                            fprintf (DDSIP_bb->moreoutfile,"  node %d inherited solution of scenario %d from node %d (%g identical scen. solutions)\n",
+                                     DDSIP_bb->nonode+1, j + 1, DDSIP_bb->curnode, (DDSIP_node[DDSIP_bb->nonode+1]->first_sol)[j][DDSIP_bb->firstvar]);
                         }
+                    }
                     (DDSIP_node[DDSIP_bb->curnode]->first_sol)[i] = NULL;
                 }
                 else
@@ -448,17 +599,8 @@ DDSIP_InitNewNodes (void)
                         fprintf (DDSIP_bb->moreoutfile,"##scenario %d solution not passed on (%g identical scen. solutions)\n",
                                  i+1, (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i])[DDSIP_bb->firstvar]);
                     }
-                    if ((cnt = (int) ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i])[DDSIP_bb->firstvar] - 0.9)))
-                        for (j = i + 1; cnt && j < DDSIP_param->scenarios; j++)
-                        {
-                            if (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]
-                                    && ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i]) == (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j])))
-                            {
-                                ((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j] = NULL;
-                                cnt--;
-                            }
-                        }
-                    DDSIP_Free ((void **) &(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i]));
+                    for (j = i; j >= 0; j = next[j])
+                        DDSIP_FirstSolRelease (&(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]));
                 }
             }
             else
@@ -468,17 +610,8 @@ DDSIP_InitNewNodes (void)
                     fprintf (DDSIP_bb->moreoutfile,"##scenario %d solution not passed on due to inheritance level (%g identical scen. solutions)\n",
                              i+1, (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i])[DDSIP_bb->firstvar]);
                 }
-                if ((cnt = (int) ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i])[DDSIP_bb->firstvar] - 0.9)))
-                    for (j = i + 1; cnt && j < DDSIP_param->scenarios; j++)
-                    {
-                        if (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]
-                                && ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i]) == (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j])))
-                        {
-                            ((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j] = NULL;
-                            cnt--;
-                        }
-                    }
-                DDSIP_Free ((void **) &(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i]));
+                for (j = i; j >= 0; j = next[j])
+                    DDSIP_FirstSolRelease (&(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]));
             }
         }
         else
@@ -495,19 +628,14 @@ DDSIP_InitNewNodes (void)
                     fprintf (DDSIP_bb->moreoutfile,"  !!! UNEXPECTED: nodes %d and %d did not inherit solution of scenario %d from node %d.\n",
                              DDSIP_bb->nonode, DDSIP_bb->nonode + 1, i + 1, DDSIP_bb->curnode);
             }
-            if ((cnt = (int) ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i])[DDSIP_bb->firstvar] - 0.9)))
-                for (j = i + 1; cnt && j < DDSIP_param->scenarios; j++)
-                {
-                    if (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]
-                            && ((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i] == ((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j])
-                    {
-                        ((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j] = NULL;
-                        cnt--;
-                    }
-                }
-            DDSIP_Free ((void **) &(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i]));
+            for (j = i; j >= 0; j = next[j])
+                DDSIP_FirstSolRelease (&(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]));
         }
     }
+    DDSIP_Free ((void **) &first);
+    DDSIP_Free ((void **) &next);
+    DDSIP_Free ((void **) &cutind);
+    DDSIP_Free ((void **) &viol);
     if (DDSIP_param->outlev > 4)
     {
         fprintf (DDSIP_bb->moreoutfile,"##**node %d inherited %d solutions from node %d\n",
@@ -531,16 +659,10 @@ DDSIP_InitNewNodes (void)
                  DDSIP_bb->firstindex[DDSIP_node[DDSIP_bb->nonode + 1]->neoind], DDSIP_node[DDSIP_bb->nonode + 1]->neolb, DDSIP_node[DDSIP_bb->nonode + 1]->neoub, DDSIP_bb->n_buffer);
     }
     // Update front tree
-    cnt = 0;
-    while (!(DDSIP_bb->front[cnt] == DDSIP_bb->curnode) && (cnt < DDSIP_bb->nofront))
-        cnt++;
-
-    DDSIP_bb->front[cnt] = DDSIP_bb->nonode;
-    DDSIP_bb->front[DDSIP_bb->nofront] = DDSIP_bb->nonode + 1;
-
+    DDSIP_FrontReplace (DDSIP_bb->curnode, DDSIP_bb->nonode);
+    DDSIP_FrontAdd (DDSIP_bb->nonode + 1);
 
     // Update current node numbers in tree and front tree
-    DDSIP_bb->nofront++;
     DDSIP_bb->no_reduced_front++;
     DDSIP_bb->nonode += 2;
 
@@ -559,77 +681,157 @@ DDSIP_InitNewNodes (void)
     // Select node for branching
     // Select right or left node according to branchdir for solving
     if (DDSIP_param->branchdir == -1)
-        DDSIP_bb->curnode = DDSIP_bb->front[cnt];
+        DDSIP_bb->curnode = DDSIP_bb->nonode - 2;
     else
-        DDSIP_bb->curnode = DDSIP_bb->front[DDSIP_bb->nofront - 1];
+        DDSIP_bb->curnode = DDSIP_bb->nonode - 1;
 
     return 0;
 }
 
 //==========================================================================
 // According to the node of the b&b tree, the function adds new bounds to problem.
+// The bounds of the previous node are updated: only the indices bounded in the nodes between
+// the common ancestor and the previous resp. current node are changed.
 int
 DDSIP_SetBounds (void)
 {
-    int i, k, change;
+    int i, j, k, l, p, a, cnt = 0, status = 0;
+    int *touched;
+    char *mark;
 
     if (DDSIP_param->outlev > 2)
     {
         fprintf (DDSIP_bb->moreoutfile, "\n----------------------\n");
         fprintf (DDSIP_bb->moreoutfile, "Prepare solving of node %d...\n", DDSIP_bb->curnode);
     }
-    // Initialize DDSIP_bb->curlb, DDSIP_bb->curub
-    for (i = 0; i < DDSIP_bb->firstvar; i++)
+    if (DDSIP_param->outlev)
     {
-        DDSIP_bb->curlb[i] = DDSIP_bb->lborg[i];
-        DDSIP_bb->curub[i] = DDSIP_bb->uborg[i];
+        fprintf (DDSIP_bb->moreoutfile, "depth %2d:  %d", DDSIP_node[DDSIP_bb->curnode]->depth, DDSIP_bb->curnode);
+        for (i = DDSIP_node[DDSIP_bb->curnode]->father; i > 0; i = DDSIP_node[i]->father)
+            fprintf (DDSIP_bb->moreoutfile, " -> %d", i);
     }
 
-    // Get all constraints in the upper tree
-    // First, the new constraint of the current node
-    DDSIP_bb->curind[0] = DDSIP_node[DDSIP_bb->curnode]->neoind;
-    DDSIP_bb->curlb[0] = DDSIP_node[DDSIP_bb->curnode]->neolb;
-    DDSIP_bb->curub[0] = DDSIP_node[DDSIP_bb->curnode]->neoub;
+    // Root node: the constraint of the node only
+    if (!DDSIP_bb->curnode)
+    {
+        for (k = 0; k < DDSIP_bb->curbdcnt; k++)
+        {
+            DDSIP_bb->curpos[DDSIP_bb->curind[k]] = -1;
+            DDSIP_bb->curcnt[DDSIP_bb->curind[k]] = 0;
+        }
+        DDSIP_bb->curind[0] = DDSIP_node[0]->neoind;
+        DDSIP_bb->curlb[0] = DDSIP_node[0]->neolb;
+        DDSIP_bb->curub[0] = DDSIP_node[0]->neoub;
+        DDSIP_bb->curbdcnt = 1;
+        DDSIP_bb->boundnode = -1;
+        return (DDSIP_bb->curlb[0] > DDSIP_bb->curub[0]) ? 115 : 0;
+    }
 
-    // Initialize
-    i = DDSIP_node[DDSIP_bb->curnode]->father;
-    DDSIP_bb->curbdcnt = 1;
-    if (DDSIP_param->outlev)
-        fprintf (DDSIP_bb->moreoutfile, "depth %2d:  %d", DDSIP_node[DDSIP_bb->curnode]->depth, DDSIP_bb->curnode);
+    // Start from the root without any bounds if the bounds of no previous node are known
+    if (DDSIP_bb->boundnode < 0)
+    {
+        for (k = 0; k < DDSIP_bb->curbdcnt; k++)
+        {
+            DDSIP_bb->curpos[DDSIP_bb->curind[k]] = -1;
+            DDSIP_bb->curcnt[DDSIP_bb->curind[k]] = 0;
+        }
+        DDSIP_bb->curbdcnt = 0;
+        p = 0;
+    }
+    else
+        p = DDSIP_bb->boundnode;
 
-    // While the father of the current node is greater than the root
-    while (i > 0)
+    // Common ancestor of the previous and the current node
+    a = p;
+    i = DDSIP_bb->curnode;
+    while (a != i)
     {
-        if (DDSIP_param->outlev)
-            fprintf (DDSIP_bb->moreoutfile, " -> %d", i);
-        k = 0;
-        change = 0;
+        if (DDSIP_node[a]->depth >= DDSIP_node[i]->depth)
+            a = DDSIP_node[a]->father;
+        else
+            i = DDSIP_node[i]->father;
+    }
+
+    touched = (int *) DDSIP_Alloc (sizeof (int), DDSIP_bb->firstvar, "touched(SetBounds)");
+    mark = (char *) DDSIP_Alloc (sizeof (char), DDSIP_bb->firstvar, "mark(SetBounds)");
 
-        // If the index has already occured, minima and maxima have to be calculated
-        while (k < DDSIP_bb->curbdcnt)
+    // Constraints of the nodes below the common ancestor on the previous path are dropped,
+    // those on the current path are added
+    for (i = p; i != a; i = DDSIP_node[i]->father)
+    {
+        j = DDSIP_node[i]->neoind;
+        DDSIP_bb->curcnt[j]--;
+        if (!mark[j])
+        {
+            mark[j] = 1;
+            touched[cnt++] = j;
+        }
+    }
+    for (i = DDSIP_bb->curnode; i != a; i = DDSIP_node[i]->father)
+    {
+        j = DDSIP_node[i]->neoind;
+        DDSIP_bb->curcnt[j]++;
+        if (!mark[j])
+        {
+            mark[j] = 1;
+            touched[cnt++] = j;
+        }
+    }
+
+    // Update the list of bounded indices
+    for (k = 0; k < cnt; k++)
+    {
+        j = touched[k];
+        if (DDSIP_bb->curcnt[j])
         {
-            if (DDSIP_bb->curind[k] == DDSIP_node[i]->neoind)
+            if (DDSIP_bb->curpos[j] < 0)
             {
-                DDSIP_bb->curlb[k] = DDSIP_Dmax (DDSIP_node[i]->neolb, DDSIP_bb->curlb[k]);
-                DDSIP_bb->curub[k] = DDSIP_Dmin (DDSIP_node[i]->neoub, DDSIP_bb->curub[k]);
-                // Actually, the next line should be superfluous
-                DDSIP_bb->curlb[k] = DDSIP_Dmin (DDSIP_bb->curlb[k], DDSIP_bb->curub[k]);
-                change = 1;
+                DDSIP_bb->curpos[j] = DDSIP_bb->curbdcnt;
+                DDSIP_bb->curind[DDSIP_bb->curbdcnt++] = j;
             }
-            k++;
+            DDSIP_bb->curlb[DDSIP_bb->curpos[j]] = -DDSIP_infty;
+            DDSIP_bb->curub[DDSIP_bb->curpos[j]] = DDSIP_infty;
         }
-
-        // If the index did not occur yet, a new one is introduced
-        if (!(change) && DDSIP_bb->curbdcnt < DDSIP_bb->firstvar)
+        else
         {
-            DDSIP_bb->curind[DDSIP_bb->curbdcnt] = DDSIP_node[i]->neoind;
-            DDSIP_bb->curlb[DDSIP_bb->curbdcnt] = DDSIP_node[i]->neolb;
-            DDSIP_bb->curub[DDSIP_bb->curbdcnt] = DDSIP_node[i]->neoub;
-            DDSIP_bb->curbdcnt++;
+            if ((l = DDSIP_bb->curpos[j]) >= 0)
+            {
+                DDSIP_bb->curbdcnt--;
+                DDSIP_bb->curind[l] = DDSIP_bb->curind[DDSIP_bb->curbdcnt];
+                DDSIP_bb->curlb[l] = DDSIP_bb->curlb[DDSIP_bb->curbdcnt];
+                DDSIP_bb->curub[l] = DDSIP_bb->curub[DDSIP_bb->curbdcnt];
+                DDSIP_bb->curpos[DDSIP_bb->curind[l]] = l;
+                DDSIP_bb->curpos[j] = -1;
+            }
+            mark[j] = 0;
         }
+    }
 
+    // The bounds of the changed indices are the minima and maxima along the path of the current node
+    i = DDSIP_bb->curnode;
+    do
+    {
+        j = DDSIP_node[i]->neoind;
+        if (mark[j])
+        {
+            k = DDSIP_bb->curpos[j];
+            DDSIP_bb->curlb[k] = DDSIP_Dmax (DDSIP_node[i]->neolb, DDSIP_bb->curlb[k]);
+            DDSIP_bb->curub[k] = DDSIP_Dmin (DDSIP_node[i]->neoub, DDSIP_bb->curub[k]);
+        }
         i = DDSIP_node[i]->father;
     }
+    while (i > 0);
+    for (k = 0; k < cnt; k++)
+    {
+        j = touched[k];
+        // Actually, the next line should be superfluous
+        if (mark[j] && DDSIP_bb->curcnt[j] > 1)
+            DDSIP_bb->curlb[DDSIP_bb->curpos[j]] = DDSIP_Dmin (DDSIP_bb->curlb[DDSIP_bb->curpos[j]], DDSIP_bb->curub[DDSIP_bb->curpos[j]]);
+    }
+    DDSIP_bb->boundnode = DDSIP_bb->curnode;
+
+    DDSIP_Free ((void **) &(touched));
+    DDSIP_Free ((void **) &(mark));
 
     // the depth of the current node may become the depth of the tree
     DDSIP_bb->depth = DDSIP_Imax (DDSIP_node[DDSIP_bb->curnode]->depth, DDSIP_bb->depth);
@@ -637,12 +839,12 @@ DDSIP_SetBounds (void)
     // A test on some errors
     for (i = 0; i < DDSIP_bb->curbdcnt; i++)
         if (DDSIP_bb->curlb[i] > DDSIP_bb->curub[i])
-            return 115;
+            status = 115;
 
     if (DDSIP_bb->curbdcnt > DDSIP_bb->firstvar)
-        return 117;
+        status = 117;
 
-    return 0;
+    return status;
 }
 
 //==========================================================================
@@ -688,6 +890,84 @@ DDSIP_Leaf (void)
     return 0;
 }
 
+//==========================================================================
+// Put the non-leaf front nodes with a bound not greater than limit into front_nodes_sorted, ascending wrt. bound.
+// They are taken from the top of the least bound heap (frontbuf holds the heap positions to be examined), so the
+// effort depends on their number only. If these are all non-leaf front nodes, the leaves are appended.
+// Returns the number of nodes put into front_nodes_sorted.
+static int
+DDSIP_FrontSortBest (double limit)
+{
+    int i, k, cnt = 0, nocand = 0;
+
+    if (DDSIP_bb->nofront)
+        DDSIP_bb->frontbuf[nocand++] = 0;
+    for (i = 0; i < nocand; i++)
+    {
+        k = DDSIP_bb->fheap[0][DDSIP_bb->frontbuf[i]];
+        if (DDSIP_node[k]->bound > limit)
+            continue;
+        if (2 * DDSIP_bb->frontbuf[i] + 1 < DDSIP_bb->nofront)
+            DDSIP_bb->frontbuf[nocand++] = 2 * DDSIP_bb->frontbuf[i] + 1;
+        if (2 * DDSIP_bb->frontbuf[i] + 2 < DDSIP_bb->nofront)
+            DDSIP_bb->frontbuf[nocand++] = 2 * DDSIP_bb->frontbuf[i] + 2;
+        if (!DDSIP_node[k]->leaf)
+        {
+            DDSIP_bb->front_nodes_sorted[cnt++] = k;
+            DDSIP_bb->front_node_bound[k] = DDSIP_node[k]->bound;
+        }
+    }
+    if (cnt > 1)
+        DDSIP_qsort_ins_A (DDSIP_bb->front_node_bound, DDSIP_bb->front_nodes_sorted, 0, cnt-1);
+    if (cnt == DDSIP_bb->no_reduced_front)
+    {
+        for (i = 0; i < DDSIP_bb->nofront; i++)
+            if (DDSIP_node[DDSIP_bb->front[i]]->leaf)
+                DDSIP_bb->front_nodes_sorted[cnt++] = DDSIP_bb->front[i];
+    }
+    return cnt;
+}
+
+//==========================================================================
+// Relative gap to the bestbound within which the front nodes are taken into account when selecting the next node
+// for BOUNDSTRAT 0..4 (see DDSIP_Bound)
+static double
+DDSIP_SelectGap (int callcnt)
+{
+    double rgap, relgap;
+
+    if (DDSIP_param->boundstrat)
+    {
+        if ((callcnt%DDSIP_param->period)>DDSIP_param->rgapsmall)
+        {
+            // DDSIP_param->rgapsmall  strategy - but half of the time branch the least-bound nodes
+            if (!DDSIP_Equal (fabs (DDSIP_bb->bestvalue), 0.0))
+                relgap = fabs ((DDSIP_bb->bestvalue - DDSIP_bb->bestbound) / DDSIP_bb->bestvalue);
+            else
+                relgap = fabs ((DDSIP_bb->bestvalue - DDSIP_bb->bestbound) / (fabs(DDSIP_bb->bestvalue) + DDSIP_param->accuracy));
+            if (relgap < 1e-4)
+                rgap = 0.1*relgap;
+            else
+                rgap = 0.02*relgap;
+        }
+        else
+        {
+            if ((callcnt%DDSIP_param->period)<DDSIP_param->rgapsmall/2)
+                rgap = 1.e-10;
+            else
+                rgap = 1.e-07;
+            rgap = DDSIP_Dmin (rgap, 0.1*fabs ((DDSIP_bb->bestvalue - DDSIP_bb->bestbound) / (fabs(DDSIP_bb->bestvalue) + DDSIP_param->accuracy)));
+        }
+    }
+    else
+    {
+        // best bound strategy
+        //rgap = 0.01*DDSIP_param->relgap;
+        rgap = 1.e-14;
+    }
+    return rgap;
+}
+
 //==========================================================================
 // Function gets new bound and fathoms nodes with higher nodevalue than
 // best solution
@@ -698,9 +978,9 @@ DDSIP_Leaf (void)
 int
 DDSIP_Bound (void)
 {
-    int i, j = 1, k, scen, cnt, status = 1;
+    int i, j = 1, k, cnt, nocand, depthfirst, status = 1;
     static int callcnt = 0;
-    double * front_node_bound, rgap, factor, worstBound;
+    double * front_node_bound, rgap = 0., factor, worstBound, prunebound, sortlimit = DDSIP_infty, threshold = 0.;
     double bestAmongTheLast;
     callcnt++;
     factor = (DDSIP_bb->bestvalue < 0.)? 1.-3.e-15 :  1.+3.e-15;
@@ -710,68 +990,80 @@ DDSIP_Bound (void)
         fprintf (DDSIP_bb->moreoutfile, "\n----------------------\n");
         fprintf (DDSIP_bb->moreoutfile, "Bounding...\n");
     }
-    // Fathom nodes in front tree
-    for (i = DDSIP_bb->nofront - 1; i >= 0; i--)
+    // The bound of the current node was changed by solving it
+    if (DDSIP_node[DDSIP_bb->curnode]->frontpos >= 0)
     {
-        // if a cut was added in the current node, mark all nodes in the front of the tree (to check cuts before solution passing)
-        if (DDSIP_bb->cutAdded)
+        DDSIP_HeapFix (0, DDSIP_node[DDSIP_bb->curnode]->heappos[0]);
+        DDSIP_HeapFix (1, DDSIP_node[DDSIP_bb->curnode]->heappos[1]);
+    }
+    // if a cut was added in the current node, mark all nodes in the front of the tree (to check cuts before solution passing)
+    if (DDSIP_bb->cutAdded)
+        for (i = 0; i < DDSIP_bb->nofront; i++)
             DDSIP_node[DDSIP_bb->front[i]]->cutAdded = 1;
-        if ((!(DDSIP_bb->found_optimal_node) && (DDSIP_node[DDSIP_bb->front[i]]->bound > DDSIP_bb->bestvalue*factor + DDSIP_bb->correct_bounding)
+    // Only nodes with a bound greater than prunebound can be fathomed. They are taken from the top of the
+    // heap with the greatest bound: frontbuf holds the heap positions to be examined, then the node numbers (-1: kept)
+    if (!(DDSIP_bb->found_optimal_node))
+        prunebound = DDSIP_bb->bestvalue*factor + DDSIP_bb->correct_bounding;
+    else
+        prunebound = DDSIP_Dmin (DDSIP_bb->bound_optimal_node + DDSIP_bb->correct_bounding, DDSIP_bb->bestvalue);
+    nocand = 0;
+    if (DDSIP_bb->nofront)
+        DDSIP_bb->frontbuf[nocand++] = 0;
+    for (i = 0; i < nocand; i++)
+    {
+        k = DDSIP_bb->fheap[1][DDSIP_bb->frontbuf[i]];
+        if (DDSIP_node[k]->bound > prunebound || DDSIP_Equal (DDSIP_node[k]->bound, DDSIP_infty))
+        {
+            if (2 * DDSIP_bb->frontbuf[i] + 1 < DDSIP_bb->nofront)
+                DDSIP_bb->frontbuf[nocand++] = 2 * DDSIP_bb->frontbuf[i] + 1;
+            if (2 * DDSIP_bb->frontbuf[i] + 2 < DDSIP_bb->nofront)
+                DDSIP_bb->frontbuf[nocand++] = 2 * DDSIP_bb->frontbuf[i] + 2;
+            DDSIP_bb->frontbuf[i] = k;
+        }
+        else
+            DDSIP_bb->frontbuf[i] = -1;
+    }
+    // Fathom nodes in front tree
+    for (i = 0; i < nocand; i++)
+    {
+        if ((k = DDSIP_bb->frontbuf[i]) < 0)
+            continue;
+        if ((!(DDSIP_bb->found_optimal_node) && (DDSIP_node[k]->bound > DDSIP_bb->bestvalue*factor + DDSIP_bb->correct_bounding)
             ) ||
-            ( (DDSIP_bb->found_optimal_node) && (DDSIP_bb->found_optimal_node != DDSIP_bb->front[i] || DDSIP_node[DDSIP_bb->front[i]]->bound > DDSIP_bb->bestvalue + 2.*DDSIP_bb->correct_bounding) &&
-             ((DDSIP_node[DDSIP_bb->front[i]]->violations && (DDSIP_node[DDSIP_bb->front[i]]->bound > DDSIP_bb->bound_optimal_node + DDSIP_bb->correct_bounding)) ||
-              (!(DDSIP_node[DDSIP_bb->front[i]]->violations) && (DDSIP_node[DDSIP_bb->front[i]]->bound > DDSIP_bb->bestvalue))
+            ( (DDSIP_bb->found_optimal_node) && (DDSIP_bb->found_optimal_node != k || DDSIP_node[k]->bound > DDSIP_bb->bestvalue + 2.*DDSIP_bb->correct_bounding) &&
+             ((DDSIP_node[k]->violations && (DDSIP_node[k]->bound > DDSIP_bb->bound_optimal_node + DDSIP_bb->correct_bounding)) ||
+              (!(DDSIP_node[k]->violations) && (DDSIP_node[k]->bound > DDSIP_bb->bestvalue))
              )
             ) ||
-            DDSIP_Equal (DDSIP_node[DDSIP_bb->front[i]]->bound, DDSIP_infty)
+            DDSIP_Equal (DDSIP_node[k]->bound, DDSIP_infty)
            )
         {
             // debug info
             if (DDSIP_param->outlev > 19)
             {
 #ifdef DEBUG
-                printf (" Bounding: delete node %d, bound: %.16g, bestvalue: %.16g, bestvalue*factor= %.16g, previous bestbound: %.16g\n", DDSIP_bb->front[i],
-                        DDSIP_node[DDSIP_bb->front[i]]->bound, DDSIP_bb->bestvalue, DDSIP_bb->bestvalue*factor, DDSIP_bb->bestbound);
-                printf ("                  node %d, bound - bestvalue = %.16g, bound - (bestvalue*factor(%.17g) + DDSIP_bb->correct_bounding(%g)) = %.16g, accuracy= %g\n", DDSIP_bb->front[i],
-                        DDSIP_node[DDSIP_bb->front[i]]->bound- DDSIP_bb->bestvalue, DDSIP_bb->bestvalue*factor,
-                        DDSIP_node[DDSIP_bb->front[i]]->bound- (DDSIP_bb->bestvalue*factor), DDSIP_bb->correct_bounding, DDSIP_param->accuracy);
+                printf (" Bounding: delete node %d, bound: %.16g, bestvalue: %.16g, bestvalue*factor= %.16g, previous bestbound: %.16g\n", k,
+                        DDSIP_node[k]->bound, DDSIP_bb->bestvalue, DDSIP_bb->bestvalue*factor, DDSIP_bb->bestbound);
+                printf ("                  node %d, bound - bestvalue = %.16g, bound - (bestvalue*factor(%.17g) + DDSIP_bb->correct_bounding(%g)) = %.16g, accuracy= %g\n", k,
+                        DDSIP_node[k]->bound- DDSIP_bb->bestvalue, DDSIP_bb->bestvalue*factor,
+                        DDSIP_node[k]->bound- (DDSIP_bb->bestvalue*factor), DDSIP_bb->correct_bounding, DDSIP_param->accuracy);
 #endif
-                fprintf (DDSIP_bb->moreoutfile, " Bounding: delete node %d, bound: %.16g, bestvalue: %.16g, previous bestbound: %.16g\n", DDSIP_bb->front[i],
-                         DDSIP_node[DDSIP_bb->front[i]]->bound, DDSIP_bb->bestvalue, DDSIP_bb->bestbound);
-                fprintf (DDSIP_bb->moreoutfile, "                  node %d, bound - bestvalue = %.16g, bound - (bestvalue*factor) = %.16g, accuracy= %g\n", DDSIP_bb->front[i],
-                        DDSIP_node[DDSIP_bb->front[i]]->bound- DDSIP_bb->bestvalue,
-                        DDSIP_node[DDSIP_bb->front[i]]->bound- (DDSIP_bb->bestvalue*factor), DDSIP_param->accuracy);
+                fprintf (DDSIP_bb->moreoutfile, " Bounding: delete node %d, bound: %.16g, bestvalue: %.16g, previous bestbound: %.16g\n", k,
+                         DDSIP_node[k]->bound, DDSIP_bb->bestvalue, DDSIP_bb->bestbound);
+                fprintf (DDSIP_bb->moreoutfile, "                  node %d, bound - bestvalue = %.16g, bound - (bestvalue*factor) = %.16g, accuracy= %g\n", k,
+                        DDSIP_node[k]->bound- DDSIP_bb->bestvalue,
+                        DDSIP_node[k]->bound- (DDSIP_bb->bestvalue*factor), DDSIP_param->accuracy);
             }
             // mark ist as a leaf
-            DDSIP_node[DDSIP_bb->front[i]]->leaf = 1;
+            DDSIP_node[k]->leaf = 1;
             // if a node previously seeming to be kept is now deleted, remove found_optimal_node info
-            if (DDSIP_bb->found_optimal_node == DDSIP_bb->front[i])
+            if (DDSIP_bb->found_optimal_node == k)
                 DDSIP_bb->found_optimal_node = 0;
             // Free the node's allocated arrays
-            for (scen = 0; scen < DDSIP_param->scenarios; scen++)
-            {
-                if (((DDSIP_node[DDSIP_bb->front[i]])->first_sol)[scen])
-                {
-                    if ((cnt = (int) ((((DDSIP_node[DDSIP_bb->front[i]])->first_sol)[scen])[DDSIP_bb->firstvar] - 0.9)))
-                    {
-                        for (j = scen + 1; cnt && j < DDSIP_param->scenarios; j++)
-                        {
-                            if (((DDSIP_node[DDSIP_bb->front[i]])->first_sol)[j]
-                                    && (((DDSIP_node[DDSIP_bb->front[i]])->first_sol)[scen] == ((DDSIP_node[DDSIP_bb->front[i]])->first_sol)[j]))
-                            {
-                                ((DDSIP_node[DDSIP_bb->front[i]])->first_sol)[j] = NULL;
-                                cnt--;
-                            }
-                        }
-                    }
-                }
-                DDSIP_Free ((void **) & ((DDSIP_node[DDSIP_bb->front[i]]->first_sol)[scen]));
-            }
-            DDSIP_FreeNode (DDSIP_bb->front[i]);
+            DDSIP_FreeNode (k);
 
             // Delete node from the front
-            DDSIP_bb->front[i] = DDSIP_bb->front[DDSIP_bb->nofront - 1];
-            DDSIP_bb->nofront--;
+            DDSIP_FrontDelete (k);
         }
     }
 
@@ -785,43 +1077,49 @@ DDSIP_Bound (void)
             if (DDSIP_node[DDSIP_bb->front[i]]->leaf)
                 DDSIP_bb->no_reduced_front--;
 
-        // sort front nodes ascending wrt. bound
-        DDSIP_Free ((void **) &DDSIP_bb->front_nodes_sorted);
-        DDSIP_bb->front_nodes_sorted = (int *) DDSIP_Alloc(sizeof(int), DDSIP_bb->nofront, "DDSIP_bb->front_nodes_sorted(Bound)");
-        front_node_bound = (double *) DDSIP_Alloc(sizeof(double), DDSIP_bb->nonode, "front_node_bound(Bound)");
-        for  (i = 0; i < DDSIP_bb->nofront; i++)
-        {
-            DDSIP_bb->front_nodes_sorted[i] = DDSIP_bb->front[i];
-            front_node_bound[DDSIP_bb->front_nodes_sorted[i]] =  DDSIP_node[DDSIP_bb->front_nodes_sorted[i]]->bound;
-        }
-        DDSIP_qsort_ins_A (front_node_bound, DDSIP_bb->front_nodes_sorted, 0, DDSIP_bb->nofront-1);
+        front_node_bound = DDSIP_bb->front_node_bound;
         // Update bestbound = lowest bound within front nodes
-        DDSIP_bb->bestbound = DDSIP_node[DDSIP_bb->front_nodes_sorted[0]]->bound;
-        worstBound = DDSIP_node[DDSIP_bb->front_nodes_sorted[DDSIP_bb->nofront-1]]->bound;
-        // Now sort leaf nodes to the end
-        for  (i = 0; i < DDSIP_bb->nofront; i++)
+        DDSIP_bb->bestbound = DDSIP_node[DDSIP_bb->fheap[0][0]]->bound;
+        worstBound = DDSIP_node[DDSIP_bb->fheap[1][0]]->bound;
+
+        if (DDSIP_param->boundstrat > 4 && DDSIP_param->boundstrat < 10 && DDSIP_bb->bestvalue < DDSIP_infty)
         {
-            DDSIP_bb->front_nodes_sorted[i] = DDSIP_bb->front[i];
-            front_node_bound[DDSIP_bb->front_nodes_sorted[i]] =  (DDSIP_node[DDSIP_bb->front_nodes_sorted[i]]->leaf) ? DDSIP_infty : DDSIP_node[DDSIP_bb->front_nodes_sorted[i]]->bound;
+            // feasible point found - switch to other bounding strategy
+            DDSIP_param->boundstrat -= 5;
         }
-        DDSIP_qsort_ins_A (front_node_bound, DDSIP_bb->front_nodes_sorted, 0, DDSIP_bb->nofront-1);
+        depthfirst = DDSIP_param->boundstrat > 4 && !(DDSIP_param->cb < 0 && ((DDSIP_bb->cutoff > 5) && (DDSIP_bb->no_reduced_front < 51) && (DDSIP_bb->noiter % -DDSIP_param->cb) < DDSIP_param->cbContinuous));
         cnt = 1;
-
-        // sort the least bound nodes according to the violations and depth
-        for  (i = 0; i < DDSIP_bb->nofront; i++)
+        if (depthfirst && DDSIP_bb->no_reduced_front > 6)
         {
-            front_node_bound[DDSIP_bb->front_nodes_sorted[i]] = !(DDSIP_node[DDSIP_bb->front_nodes_sorted[i]]->solved) ? -DDSIP_infty : 2*DDSIP_node[DDSIP_bb->front_nodes_sorted[i]]->violations + DDSIP_node[DDSIP_bb->front_nodes_sorted[i]]->dispnorm - DDSIP_node[DDSIP_bb->front[i]]->depth;
-            if ((DDSIP_node[DDSIP_bb->front_nodes_sorted[i]]->bound - DDSIP_bb->bestbound) / (fabs(DDSIP_bb->bestbound) + DDSIP_param->accuracy) > 1.e-12)
-                break;
+            // the selection rules below sort the whole front themselves
+            for  (i = 0; i < DDSIP_bb->nofront; i++)
+                DDSIP_bb->front_nodes_sorted[i] = DDSIP_bb->front[i];
+            DDSIP_bb->nofrontsorted = DDSIP_bb->nofront;
         }
-        DDSIP_qsort_ins_A (front_node_bound, DDSIP_bb->front_nodes_sorted, 0, i-1);
-
-        if (DDSIP_param->boundstrat > 4 && DDSIP_param->boundstrat < 10 && DDSIP_bb->bestvalue < DDSIP_infty)
+        else
         {
-            // feasible point found - switch to other bounding strategy
-            DDSIP_param->boundstrat -= 5;
+            // sort the front nodes ascending wrt. bound, as far as they are needed: the least bound nodes sorted
+            // according to the violations and depth below and the ones within the gap of the selection rule
+            sortlimit = DDSIP_bb->bestbound + 2.e-12 * (fabs(DDSIP_bb->bestbound) + DDSIP_param->accuracy);
+            if (!depthfirst)
+            {
+                rgap = DDSIP_SelectGap (callcnt);
+                threshold = DDSIP_bb->bestbound + fabs(DDSIP_bb->bestbound)*rgap;
+                sortlimit = DDSIP_Dmax (sortlimit, threshold);
+            }
+            DDSIP_bb->nofrontsorted = DDSIP_FrontSortBest (sortlimit);
+
+            // sort the least bound nodes according to the violations and depth
+            for  (i = 0; i < DDSIP_bb->nofrontsorted; i++)
+            {
+                front_node_bound[DDSIP_bb->front_nodes_sorted[i]] = !(DDSIP_node[DDSIP_bb->front_nodes_sorted[i]]->solved) ? -DDSIP_infty : 2*DDSIP_node[DDSIP_bb->front_nodes_sorted[i]]->violations + DDSIP_node[DDSIP_bb->front_nodes_sorted[i]]->dispnorm - DDSIP_node[DDSIP_bb->front[i]]->depth;
+                if ((DDSIP_node[DDSIP_bb->front_nodes_sorted[i]]->bound - DDSIP_bb->bestbound) / (fabs(DDSIP_bb->bestbound) + DDSIP_param->accuracy) > 1.e-12)
+                    break;
+            }
+            DDSIP_qsort_ins_A (front_node_bound, DDSIP_bb->front_nodes_sorted, 0, i-1);
         }
-        if (DDSIP_param->boundstrat > 4 && !(DDSIP_param->cb < 0 && ((DDSIP_bb->cutoff > 5) && (DDSIP_bb->no_reduced_front < 51) && (DDSIP_bb->noiter % -DDSIP_param->cb) < DDSIP_param->cbContinuous)))
+
+        if (depthfirst)
         {
             // depth first until a feasible point is found for boustrat 5..9
             // choose among the most recent nodes according to best bound
@@ -1007,46 +1305,8 @@ DDSIP_Bound (void)
         }
         else
         {
-            double threshold;
-            if (DDSIP_param->boundstrat)
-            {
-                if ((callcnt%DDSIP_param->period)>DDSIP_param->rgapsmall)
-                {
-                    // DDSIP_param->rgapsmall  strategy - but half of the time branch the least-bound nodes
-                    if (!DDSIP_Equal (fabs (DDSIP_bb->bestvalue), 0.0))
-                    {
-                        threshold = fabs ((DDSIP_bb->bestvalue - DDSIP_bb->bestbound) / DDSIP_bb->bestvalue);
-                        if (threshold < 1e-4)
-                            rgap = 0.1*threshold;
-                        else
-                            rgap = 0.02*threshold;
-                    }
-                    else
-                    {
-                        threshold = fabs ((DDSIP_bb->bestvalue - DDSIP_bb->bestbound) / (fabs(DDSIP_bb->bestvalue) + DDSIP_param->accuracy));
-                        if (threshold < 1e-4)
-                            rgap = 0.1*threshold;
-                        else
-                            rgap = 0.02*threshold;
-                    }
-                }
-                else
-                {
-                    if ((callcnt%DDSIP_param->period)<DDSIP_param->rgapsmall/2)
-                        rgap = 1.e-10;
-                    else
-                        rgap = 1.e-07;
-                    rgap = DDSIP_Dmin (rgap, 0.1*fabs ((DDSIP_bb->bestvalue - DDSIP_bb->bestbound) / (fabs(DDSIP_bb->bestvalue) + DDSIP_param->accuracy)));
-                }
-            }
-            else
-            {
-                // best bound strategy
-                //rgap = 0.01*DDSIP_param->relgap;
-                rgap = 1.e-14;
-            }
-            threshold = DDSIP_bb->bestbound + fabs(DDSIP_bb->bestbound)*rgap;
-            for (i = 1; i < DDSIP_bb->nofront; i++)
+            // rgap and threshold of the selection rule were determined when sorting the front nodes
+            for (i = 1; i < DDSIP_bb->nofrontsorted; i++)
             {
                 if (DDSIP_node[DDSIP_bb->front_nodes_sorted[i]]->bound > threshold)
                     break;
@@ -1131,10 +1391,22 @@ DDSIP_Bound (void)
             }
         }
 
-        DDSIP_Free ((void**) &front_node_bound);
         // Debugging information
         if (DDSIP_param->outlev > 4)
         {
+            // the list of all front nodes, the ones not sorted above follow ascending wrt. bound, leaf nodes to the end
+            if (DDSIP_bb->nofrontsorted < DDSIP_bb->nofront)
+            {
+                k = DDSIP_bb->nofrontsorted;
+                for (i = 0; i < DDSIP_bb->nofront; i++)
+                    if (DDSIP_node[DDSIP_bb->front[i]]->leaf || DDSIP_node[DDSIP_bb->front[i]]->bound > sortlimit)
+                    {
+                        DDSIP_bb->front_nodes_sorted[k++] = DDSIP_bb->front[i];
+                        front_node_bound[DDSIP_bb->front[i]] = (DDSIP_node[DDSIP_bb->front[i]]->leaf) ? DDSIP_infty : DDSIP_node[DDSIP_bb->front[i]]->bound;
+                    }
+                DDSIP_qsort_ins_A (front_node_bound, DDSIP_bb->front_nodes_sorted, DDSIP_bb->nofrontsorted, DDSIP_bb->nofront-1);
+                DDSIP_bb->nofrontsorted = DDSIP_bb->nofront;
+            }
             fprintf (DDSIP_bb->moreoutfile,
                      "No of front nodes: %d (including %d leaves)     found_optimal_node: %d, bestbound: %18.12g\n", DDSIP_bb->nofront, DDSIP_bb->nofront - DDSIP_bb->no_reduced_front, DDSIP_bb->found_optimal_node, DDSIP_bb->bestbound);
             fprintf (DDSIP_bb->moreoutfile, "     No.   bound             violations dispnorm  branchvar  lower bound   upper        range       depth isleaf solved cutAdded\n");
@@ -32,38 +32,38 @@ DDSIP_ChgBounds (int print)
 {
     int i, j, status;
 
-    int *index = (int *) DDSIP_Alloc (sizeof (int), DDSIP_bb->curbdcnt, "index(chgbounds)");
+    double *lb = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "lb(chgbounds)");
+    double *ub = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "ub(chgbounds)");
 
     DDSIP_bb->bestsol_in_curnode = 1;
 
-    for (i = 0; i < DDSIP_bb->curbdcnt; i++)
-        index[i] = DDSIP_bb->firstindex[DDSIP_bb->curind[i]];
     if (print && DDSIP_param->outlev > 3)
     {
         if (DDSIP_bb->curbdcnt)
             fprintf (DDSIP_bb->moreoutfile, "New bounds\n nr   fs-var  variable_index  .    lb                ub   variable_name\n");
         for (i = 0; i < DDSIP_bb->curbdcnt; i++)
         {
-            j = index[i];
+            j = DDSIP_bb->firstindex[DDSIP_bb->curind[i]];
             status = CPXgetcolname (DDSIP_env, DDSIP_lp, DDSIP_bb->name_buffer, DDSIP_bb->n_buffer, DDSIP_bb->n_buffer_len, &j, j, j);
             if (status)
                 fprintf (stderr," Error when querying name of variable %d: %d\n",j,status);
-            fprintf (DDSIP_bb->moreoutfile, "%3d  %6d  %6d  %16.14g  %16.14g   %s\n", i+1, DDSIP_bb->curind[i]+1, index[i], DDSIP_bb->curlb[i], DDSIP_bb->curub[i], DDSIP_bb->n_buffer);
+            fprintf (DDSIP_bb->moreoutfile, "%3d  %6d  %6d  %16.14g  %16.14g   %s\n", i+1, DDSIP_bb->curind[i]+1, DDSIP_bb->firstindex[DDSIP_bb->curind[i]], DDSIP_bb->curlb[i], DDSIP_bb->curub[i], DDSIP_bb->n_buffer);
         }
     }
 
-    status = CPXchgbds (DDSIP_env, DDSIP_lp, DDSIP_bb->curbdcnt, index, DDSIP_bb->lbident, DDSIP_bb->curlb);
-    if (status)
+    // Bounds of the node, only those differing from the bounds in DDSIP_lp are changed
+    memcpy (lb, DDSIP_bb->lborg, sizeof (double) * DDSIP_bb->firstvar);
+    memcpy (ub, DDSIP_bb->uborg, sizeof (double) * DDSIP_bb->firstvar);
+    for (i = 0; i < DDSIP_bb->curbdcnt; i++)
     {
-        fprintf (stderr, "ERROR: Failed to change lower bounds\n");
-        return status;
+        lb[DDSIP_bb->curind[i]] = DDSIP_bb->curlb[i];
+        ub[DDSIP_bb->curind[i]] = DDSIP_bb->curub[i];
     }
-
-    status = CPXchgbds (DDSIP_env, DDSIP_lp, DDSIP_bb->curbdcnt, index, DDSIP_bb->ubident, DDSIP_bb->curub);
+    status = DDSIP_ChgFirstBounds (lb, ub);
     if (status)
     {
-        fprintf (stderr, "ERROR: Failed to change upper bounds\n");
-        return status;
+        fprintf (stderr, "ERROR: Failed to change bounds\n");
+        goto TERMINATE;
     }
 
     // check whether the incumbent violates one of the changed bounds
@@ -78,96 +78,223 @@ DDSIP_ChgBounds (int print)
             }
     }
 
-    DDSIP_Free ((void **) &(index));
+TERMINATE:
+    DDSIP_Free ((void **) &(lb));
+    DDSIP_Free ((void **) &(ub));
     return status;
 }
 
 //==========================================================================
-// Function is used to change problem parameters for each scenario
-// scen is the number of the current scenarios
+// Set the first-stage bounds lb, ub in DDSIP_lp
+// Only the bounds differing from the ones set before are passed to cplex
 int
-DDSIP_ChgProb (int scen, int multipliers)
+DDSIP_ChgFirstBounds (const double *lb, const double *ub)
+{
+    int j, cnt = 0, status = 0;
+
+    int *index = (int *) DDSIP_Alloc (sizeof (int), 2 * DDSIP_bb->firstvar, "index(ChgFirstBounds)");
+    char *lu = (char *) DDSIP_Alloc (sizeof (char), 2 * DDSIP_bb->firstvar, "lu(ChgFirstBounds)");
+    double *bd = (double *) DDSIP_Alloc (sizeof (double), 2 * DDSIP_bb->firstvar, "bd(ChgFirstBounds)");
+
+    for (j = 0; j < DDSIP_bb->firstvar; j++)
+    {
+        if (!DDSIP_bb->lpbdknown || DDSIP_bb->lplb[j] != lb[j])
+        {
+            index[cnt] = DDSIP_bb->firstindex[j];
+            lu[cnt] = 'L';
+            bd[cnt++] = lb[j];
+        }
+        if (!DDSIP_bb->lpbdknown || DDSIP_bb->lpub[j] != ub[j])
+        {
+            index[cnt] = DDSIP_bb->firstindex[j];
+            lu[cnt] = 'U';
+            bd[cnt++] = ub[j];
+        }
+    }
+
+    if (cnt)
+    {
+        status = CPXchgbds (DDSIP_env, DDSIP_lp, cnt, index, lu, bd);
+        if (status)
+        {
+            fprintf (stderr, "ERROR: Failed to change bounds (ChgFirstBounds)\n");
+            DDSIP_bb->lpbdknown = 0;
+        }
+    }
+    if (!status)
+    {
+        memcpy (DDSIP_bb->lplb, lb, sizeof (double) * DDSIP_bb->firstvar);
+        memcpy (DDSIP_bb->lpub, ub, sizeof (double) * DDSIP_bb->firstvar);
+        DDSIP_bb->lpbdknown = 1;
+    }
+
+    DDSIP_Free ((void **) &(index));
+    DDSIP_Free ((void **) &(lu));
+    DDSIP_Free ((void **) &(bd));
+    return status;
+} // DDSIP_ChgFirstBounds
+
+//==========================================================================
+// Allocate the record of the scenario data loaded in a problem, nothing is known yet
+loaded_t *
+DDSIP_AllocLoaded (void)
 {
-    int j, i, status = 0;
     int m = DDSIP_Imax (DDSIP_param->stocmat, DDSIP_Imax (DDSIP_param->stocrhs, DDSIP_param->stoccost));
+    int n = DDSIP_bb->firstvar + DDSIP_bb->secvar;
+    loaded_t *loaded = (loaded_t *) DDSIP_Alloc (sizeof (loaded_t), 1, "loaded(AllocLoaded)");
+
+    loaded->rhs = (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->stocrhs, "rhs(AllocLoaded)");
+    loaded->matval = (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->stocmat, "matval(AllocLoaded)");
+    loaded->obj = (double *) DDSIP_Alloc (sizeof (double), n, "obj(AllocLoaded)");
+    loaded->objknown = (char *) DDSIP_Alloc (sizeof (char), n, "objknown(AllocLoaded)");
+    loaded->ind = (int *) DDSIP_Alloc (sizeof (int), m + DDSIP_bb->firstvar, "ind(AllocLoaded)");
+    loaded->colind = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->stocmat, "colind(AllocLoaded)");
+    loaded->val = (double *) DDSIP_Alloc (sizeof (double), m + DDSIP_bb->firstvar, "val(AllocLoaded)");
+    loaded->cost = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "cost(AllocLoaded)");
+    return loaded;
+} // DDSIP_AllocLoaded
+
+//==========================================================================
+void
+DDSIP_FreeLoaded (loaded_t **loaded)
+{
+    if (!*loaded)
+        return;
+    DDSIP_Free ((void **) &((*loaded)->rhs));
+    DDSIP_Free ((void **) &((*loaded)->matval));
+    DDSIP_Free ((void **) &((*loaded)->obj));
+    DDSIP_Free ((void **) &((*loaded)->objknown));
+    DDSIP_Free ((void **) &((*loaded)->ind));
+    DDSIP_Free ((void **) &((*loaded)->colind));
+    DDSIP_Free ((void **) &((*loaded)->val));
+    DDSIP_Free ((void **) &((*loaded)->cost));
+    DDSIP_Free ((void **) loaded);
+} // DDSIP_FreeLoaded
+
+//==========================================================================
+// The problem data were changed outside of DDSIP_ChgProbLp (objective for upper bounds, risk models),
+// the next call transfers all entries
+void
+DDSIP_InvalidateLoaded (loaded_t *loaded)
+{
+    if (!loaded)
+        return;
+    loaded->rhsknown = loaded->matknown = 0;
+    memset (loaded->objknown, 0, (DDSIP_bb->firstvar + DDSIP_bb->secvar) * sizeof (char));
+} // DDSIP_InvalidateLoaded
+
+//==========================================================================
+// The rhs and objective of problem to were copied from the problem of from (and the matrix if mat is set)
+void
+DDSIP_CopyLoaded (loaded_t *to, loaded_t *from, int mat)
+{
+    int n = DDSIP_bb->firstvar + DDSIP_bb->secvar;
+
+    to->rhsknown = from->rhsknown;
+    memcpy (to->rhs, from->rhs, DDSIP_param->stocrhs * sizeof (double));
+    memcpy (to->obj, from->obj, n * sizeof (double));
+    memcpy (to->objknown, from->objknown, n * sizeof (char));
+    if (mat)
+    {
+        to->matknown = from->matknown;
+        memcpy (to->matval, from->matval, DDSIP_param->stocmat * sizeof (double));
+    }
+} // DDSIP_CopyLoaded
+
+//==========================================================================
+// Function is used to change problem parameters for each scenario in the given problem
+// scen is the number of the current scenarios
+// Only the entries differing from those recorded in loaded are passed to CPLEX
+int
+DDSIP_ChgProbLp (CPXENVptr env, CPXLPptr lp, loaded_t *loaded, int scen, int multipliers)
+{
+    int j, i, k, cnt, status = 0, fscost = 0;
     double h;
 #ifdef DEBUG
     char **colname;
     char *colstore;
 #endif
 
-    double *value = (double *) DDSIP_Alloc (sizeof (double), m, "value(chgprob)");
-    double *cost = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "cost(chgprob)");
+    double *value = loaded->val;
+    double *cost = loaded->cost;
 
     // Change rhs
     if (DDSIP_param->stocrhs)
     {
-        if (scen == -1)
-            // Do this for ExpValProb
+        cnt = 0;
+        for (j = 0; j < DDSIP_param->stocrhs; j++)
         {
-            for (j = 0; j < DDSIP_param->stocrhs; j++)
+            if (scen == -1)
+                // Do this for ExpValProb
             {
-                value[j] = 0.0;
+                h = 0.0;
                 for (i = 0; i < DDSIP_param->scenarios; i++)
-                    value[j] += DDSIP_data->prob[i] * DDSIP_data->rhs[i * DDSIP_param->stocrhs + j];
+                    h += DDSIP_data->prob[i] * DDSIP_data->rhs[i * DDSIP_param->stocrhs + j];
                 // Numerical errors ?
-                if (DDSIP_Equal (value[j], 0.0))
-                    value[j] = 0.0;
+                if (DDSIP_Equal (h, 0.0))
+                    h = 0.0;
             }
-        }
-        else
-            // Do this for LowerBound, UB
-        {
-            for (j = 0; j < DDSIP_param->stocrhs; j++)
+            else
+                // Do this for LowerBound, UB
+                h = DDSIP_data->rhs[scen * DDSIP_param->stocrhs + j];
+            if (!loaded->rhsknown || h != loaded->rhs[j])
             {
-                value[j] = DDSIP_data->rhs[scen * DDSIP_param->stocrhs + j];
+                loaded->ind[cnt] = DDSIP_data->rhsind[j];
+                value[cnt++] = loaded->rhs[j] = h;
             }
         }
 
-        status = CPXchgrhs (DDSIP_env, DDSIP_lp, DDSIP_param->stocrhs, DDSIP_data->rhsind, value);
-        if (status)
+        loaded->rhsknown = 0;
+        if (cnt)
         {
-            fprintf (stderr, "ERROR: Failed to change rhs, return code %d\n", status);
-            return status;
+            status = CPXchgrhs (env, lp, cnt, loaded->ind, value);
+            if (status)
+            {
+                fprintf (stderr, "ERROR: Failed to change rhs, return code %d\n", status);
+                return status;
+            }
         }
-
+        loaded->rhsknown = 1;
     }
+#ifdef CONIC_BUNDLE
+    // With multipliers the first-stage costs are set below
+    fscost = (DDSIP_param->cb && DDSIP_bb->DDSIP_step != neobj && DDSIP_bb->DDSIP_step != adv && DDSIP_bb->DDSIP_step != eev);
+#endif
+    cnt = 0;
     // Change costs if required
     if (DDSIP_param->stoccost)
     {
-        if (scen == -1)
+        for (j = 0; j < DDSIP_param->stoccost; j++)
         {
-            // Do this for ExpValProb
-            for (j = 0; j < DDSIP_param->stoccost; j++)
+            if (scen == -1)
             {
-                value[j] = 0.0;
+                // Do this for ExpValProb
+                h = 0.0;
                 for (i = 0; i < DDSIP_param->scenarios; i++)
-                    value[j] += DDSIP_data->prob[i] * DDSIP_data->cost[i * DDSIP_param->stoccost + j];
+                    h += DDSIP_data->prob[i] * DDSIP_data->cost[i * DDSIP_param->stoccost + j];
                 // Numerical errors ?
-                if (DDSIP_Equal (value[j], 0.0))
-                    value[j] = 0.0;
+                if (DDSIP_Equal (h, 0.0))
+                    h = 0.0;
             }
-        }
-        else
-        {
             // Do this for LowerBound
-            for (j = 0; j < DDSIP_param->stoccost; j++)
-                if (DDSIP_param->riskmod == 3)
-                    value[j] = (1 - DDSIP_param->riskweight) * DDSIP_data->cost[scen * DDSIP_param->stoccost + j];
-                else
-                    value[j] = DDSIP_data->cost[scen * DDSIP_param->stoccost + j];
-        }
-
-        status = CPXchgobj (DDSIP_env, DDSIP_lp, DDSIP_param->stoccost, DDSIP_data->costind, value);
-        if (status)
-        {
-            fprintf (stderr, "ERROR: Failed to change objective, return code %d\n", status);
-            return status;
+            else if (DDSIP_param->riskmod == 3)
+                h = (1 - DDSIP_param->riskweight) * DDSIP_data->cost[scen * DDSIP_param->stoccost + j];
+            else
+                h = DDSIP_data->cost[scen * DDSIP_param->stoccost + j];
+            k = DDSIP_data->costind[j];
+            if (fscost && DDSIP_bb->firstindex_reverse[k] >= 0)
+                continue;
+            if (!loaded->objknown[k] || h != loaded->obj[k])
+            {
+                loaded->ind[cnt] = k;
+                value[cnt++] = loaded->obj[k] = h;
+                loaded->objknown[k] = 1;
+            }
         }
     }
 #ifdef CONIC_BUNDLE
     // Use multipliers passed by CB
-    if (DDSIP_param->cb && DDSIP_bb->DDSIP_step != neobj && DDSIP_bb->DDSIP_step != adv && DDSIP_bb->DDSIP_step != eev)
+    if (fscost)
     {
         // Original costs of the first-stage variables - maybe changed by stochstic costs
         for (i = 0; i < DDSIP_bb->firstvar; i++)
@@ -208,7 +335,7 @@ DDSIP_ChgProb (int scen, int multipliers)
             {
                 colname = (char **) DDSIP_Alloc (sizeof (char *), (DDSIP_bb->firstvar + DDSIP_bb->secvar), "colname(Change)");
                 colstore = (char *) DDSIP_Alloc (sizeof (char), (DDSIP_bb->firstvar + DDSIP_bb->secvar) * DDSIP_ln_varname, "colstore(Change)");
-                status = CPXgetcolname (DDSIP_env, DDSIP_lp, colname, colstore,
+                status = CPXgetcolname (env, lp, colname, colstore,
                                         (DDSIP_bb->firstvar + DDSIP_bb->secvar) * DDSIP_ln_varname, &j, 0, DDSIP_bb->firstvar + DDSIP_bb->secvar - 1);
                 if (status)
                 {
@@ -223,34 +350,22 @@ DDSIP_ChgProb (int scen, int multipliers)
             for (i = 0; i < DDSIP_bb->firstvar; i++)
             {
 #ifdef DEBUG
-                if (DDSIP_param->outlev > 50)
+                if (DDSIP_param->outlev > 50 && DDSIP_param->nonant != 3)
                 {
                     fprintf (DDSIP_bb->moreoutfile, " scen %d: first-stage variable %d nabeg[%d]= %d, nacnt= %d\n", scen+1, i, scen * DDSIP_bb->firstvar + i, DDSIP_data->nabeg[scen * DDSIP_bb->firstvar + i], DDSIP_data->nacnt[scen * DDSIP_bb->firstvar + i]);
-                }
-#endif
-                for (j = DDSIP_data->nabeg[scen * DDSIP_bb->firstvar + i];
-                        j < DDSIP_data->nabeg[scen * DDSIP_bb->firstvar + i] + DDSIP_data->nacnt[scen * DDSIP_bb->firstvar + i]; j++)
-                {
-                    //if (fabs (DDSIP_node[DDSIP_bb->curnode]->dual[DDSIP_data->naind[j]]) > 1.e-18)
+                    for (j = DDSIP_data->nabeg[scen * DDSIP_bb->firstvar + i];
+                            j < DDSIP_data->nabeg[scen * DDSIP_bb->firstvar + i] + DDSIP_data->nacnt[scen * DDSIP_bb->firstvar + i]; j++)
                     {
-#ifdef DEBUG
-                        if (DDSIP_param->outlev > 50)
-                        {
-                            fprintf (DDSIP_bb->moreoutfile, " first-stage var: %d ", i);
-                            fprintf (DDSIP_bb->moreoutfile, " (%s),", colname[DDSIP_bb->firstindex[i]]);
-                            fprintf (DDSIP_bb->moreoutfile, " scen: %d, \tnaind[%d]= %d: koeff: %g, dual=%g, \tcost add: %g\n", scen,j, DDSIP_data->naind[j],  DDSIP_data->naval[j], DDSIP_node[DDSIP_bb->curnode]->dual[DDSIP_data->naind[j]],  DDSIP_data->naval[j] * DDSIP_node[DDSIP_bb->curnode]->dual[DDSIP_data->naind[j]] / DDSIP_data->prob[scen]);
-                            fprintf (DDSIP_bb->moreoutfile, " \tcost %16.12g changed to", cost[i]);
-                        }
-#endif
-                        cost[i] += DDSIP_data->naval[j] * DDSIP_node[DDSIP_bb->curnode]->dual[DDSIP_data->naind[j]] / DDSIP_data->prob[scen];
-#ifdef DEBUG
-                        if (DDSIP_param->outlev > 50)
-                        {
-                            fprintf (DDSIP_bb->moreoutfile, " %16.12g\n", cost[i]);
-                        }
-#endif
+                        fprintf (DDSIP_bb->moreoutfile, " first-stage var: %d ", i);
+                        fprintf (DDSIP_bb->moreoutfile, " (%s),", colname[DDSIP_bb->firstindex[i]]);
+                        fprintf (DDSIP_bb->moreoutfile, " scen: %d, \tnaind[%d]= %d: koeff: %g, dual=%g, \tcost add: %g\n", scen,j, DDSIP_data->naind[j],  DDSIP_data->naval[j], DDSIP_node[DDSIP_bb->curnode]->dual[DDSIP_data->naind[j]],  DDSIP_data->naval_p[j] * DDSIP_node[DDSIP_bb->curnode]->dual[DDSIP_data->naind[j]]);
                     }
                 }
+                if (DDSIP_param->outlev > 50)
+                    fprintf (DDSIP_bb->moreoutfile, " \tcost %16.12g changed to %16.12g\n", cost[i], cost[i] + DDSIP_bb->lagcost[scen * DDSIP_bb->firstvar + i]);
+#endif
+                // computed for all scenarios by DDSIP_LagrangeCost
+                cost[i] += DDSIP_bb->lagcost[scen * DDSIP_bb->firstvar + i];
             }
 #ifdef DEBUG
             if (DDSIP_param->outlev > 50)
@@ -281,7 +396,7 @@ DDSIP_ChgProb (int scen, int multipliers)
                 if (DDSIP_param->outlev > 50)
                 {
                     fprintf (DDSIP_bb->moreoutfile, "******* changes to obj coefficients by Lagrangean\n");
-                    for (i = 0; i < DDSIP_bb->firstvar; i++)
+                    for (i = 0; i < DDSIP_bb->firstvar && DDSIP_param->nonant != 3; i++)
                     {
                         fprintf (DDSIP_bb->moreoutfile, " scen %d: first-stage variable %d nabeg[%d]= %d, nacnt= %d\n", scen+1, i, scen * DDSIP_bb->firstvar + i, DDSIP_data->nabeg[scen * DDSIP_bb->firstvar + i], DDSIP_data->nacnt[scen * DDSIP_bb->firstvar + i]);
                         for (j = DDSIP_data->nabeg[scen * DDSIP_bb->firstvar + i];
@@ -303,14 +418,7 @@ DDSIP_ChgProb (int scen, int multipliers)
             }
 #endif
             for (i = 0; i < DDSIP_bb->firstvar; i++)
-            {
-                h = 0.;
-                for (j = DDSIP_data->nabeg[scen * DDSIP_bb->firstvar + i];
-                        j < DDSIP_data->nabeg[scen * DDSIP_bb->firstvar + i] + DDSIP_data->nacnt[scen * DDSIP_bb->firstvar + i]; j++)
-                    h += DDSIP_data->naval[j] * DDSIP_node[DDSIP_bb->curnode]->dual[DDSIP_data->naind[j]] / DDSIP_data->prob[scen];
-
-                cost[i] += h;
-            }
+                cost[i] += DDSIP_bb->lagcost[scen * DDSIP_bb->firstvar + i];
 #ifdef DEBUG
             if (DDSIP_param->outlev > 50)
             {
@@ -321,43 +429,76 @@ DDSIP_ChgProb (int scen, int multipliers)
 #endif
         }
 
-        status = CPXchgobj (DDSIP_env, DDSIP_lp, DDSIP_bb->firstvar, DDSIP_bb->firstindex, cost);
+        for (i = 0; i < DDSIP_bb->firstvar; i++)
+        {
+            k = DDSIP_bb->firstindex[i];
+            if (!loaded->objknown[k] || cost[i] != loaded->obj[k])
+            {
+                loaded->ind[cnt] = k;
+                value[cnt++] = loaded->obj[k] = cost[i];
+                loaded->objknown[k] = 1;
+            }
+        }
+    }
+#endif
+    if (cnt)
+    {
+        status = CPXchgobj (env, lp, cnt, loaded->ind, value);
         if (status)
         {
-            fprintf (stderr, "ERROR: Failed to update objective coefficients\n");
+            fprintf (stderr, "ERROR: Failed to change objective, return code %d\n", status);
+            DDSIP_InvalidateLoaded (loaded);
             return status;
         }
     }
-#endif
     // Change matrix if required
     if (DDSIP_param->stocmat)
     {
-        if (scen == -1)
-            // Do this for ExpValProb
-            for (j = 0; j < DDSIP_param->stocmat; j++)
+        cnt = 0;
+        for (j = 0; j < DDSIP_param->stocmat; j++)
+        {
+            if (scen == -1)
+                // Do this for ExpValProb
             {
-                value[j] = 0.0;
+                h = 0.0;
                 for (i = 0; i < DDSIP_param->scenarios; i++)
-                    value[j] += DDSIP_data->prob[i] * DDSIP_data->matval[i * DDSIP_param->stocmat + j];
+                    h += DDSIP_data->prob[i] * DDSIP_data->matval[i * DDSIP_param->stocmat + j];
                 // Numerical errors ?
-                if (DDSIP_Equal (value[j], 0.0))
-                    value[j] = 0.0;
+                if (DDSIP_Equal (h, 0.0))
+                    h = 0.0;
             }
-        else
-            // Do this for LowerBound
-            for (j = 0; j < DDSIP_param->stocmat; j++)
-                value[j] = DDSIP_data->matval[scen * DDSIP_param->stocmat + j];
+            else
+                // Do this for LowerBound
+                h = DDSIP_data->matval[scen * DDSIP_param->stocmat + j];
+            if (!loaded->matknown || h != loaded->matval[j])
+            {
+                loaded->ind[cnt] = DDSIP_data->matrow[j];
+                loaded->colind[cnt] = DDSIP_data->matcol[j];
+                value[cnt++] = loaded->matval[j] = h;
+            }
+        }
 
-        status = CPXchgcoeflist (DDSIP_env, DDSIP_lp, DDSIP_param->stocmat, DDSIP_data->matrow, DDSIP_data->matcol, value);
-        if (status)
+        loaded->matknown = 0;
+        if (cnt)
         {
-            fprintf (stderr, "ERROR: Failed to change matrix, return code %d\n", status);
-            return status;
+            status = CPXchgcoeflist (env, lp, cnt, loaded->ind, loaded->colind, value);
+            if (status)
+            {
+                fprintf (stderr, "ERROR: Failed to change matrix, return code %d\n", status);
+                return status;
+            }
         }
+        loaded->matknown = 1;
     }
 
-    //DDSIP_Free ((void **) &(index));
-    DDSIP_Free ((void **) &(value));
-    DDSIP_Free ((void **) &(cost));
     return status;
 }
+
+//==========================================================================
+// Function is used to change problem parameters for each scenario
+// scen is the number of the current scenarios
+int
+DDSIP_ChgProb (int scen, int multipliers)
+{
+    return DDSIP_ChgProbLp (DDSIP_env, DDSIP_lp, DDSIP_bb->loaded, scen, multipliers);
+}
@@ -34,28 +34,107 @@
 
 #include <DDSIPconst.h>
 
+//==========================================================================
+// Lagrangean cost corrections (H^T dual)/p of the first-stage variables of all scenarios.
+// For NONANT 3 (rows x_j - sum p_s x_s for j < S-1) this is dual_s/p_s - sum_j dual_j in closed form.
+static void
+DDSIP_NonAntCost (const double *dual, double *cost)
+{
+    int scen, i, k, j;
+    double sum, *dualsum;
+
+    if (DDSIP_param->nonant == 3)
+    {
+        dualsum = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "dualsum(NonAntCost)");
+        for (scen = 0; scen < DDSIP_param->scenarios - 1; scen++)
+            for (i = 0; i < DDSIP_bb->firstvar; i++)
+                dualsum[i] += dual[scen * DDSIP_bb->firstvar + i];
+        for (scen = 0; scen < DDSIP_param->scenarios - 1; scen++)
+            for (i = 0; i < DDSIP_bb->firstvar; i++)
+                cost[scen * DDSIP_bb->firstvar + i] = dual[scen * DDSIP_bb->firstvar + i] / DDSIP_data->prob[scen] - dualsum[i];
+        for (i = 0; i < DDSIP_bb->firstvar; i++)
+            cost[scen * DDSIP_bb->firstvar + i] = -dualsum[i];
+        DDSIP_Free ((void **) &(dualsum));
+        return;
+    }
+    for (k = 0; k < DDSIP_bb->firstvar * DDSIP_param->scenarios; k++)
+    {
+        sum = 0.;
+        for (j = DDSIP_data->nabeg[k]; j < DDSIP_data->nabeg[k] + DDSIP_data->nacnt[k]; j++)
+            sum += DDSIP_data->naval_p[j] * dual[DDSIP_data->naind[j]];
+        cost[k] = sum;
+    }
+} // DDSIP_NonAntCost
+
 //==========================================================================
 int
 DDSIP_NonAnt (void)
 {
-    int status = 0, scen, i, k, j;
+    int status = 0, scen, i, k, j, *pos;
 
-    DDSIP_data->nabeg = (int *) DDSIP_Alloc (sizeof (int), DDSIP_bb->firstvar * DDSIP_param->scenarios, "nabeg(NonAnt)");
-    DDSIP_data->nacnt = (int *) DDSIP_Alloc (sizeof (int), DDSIP_bb->firstvar * DDSIP_param->scenarios, "nacnt(NonAnt)");
+    DDSIP_bb->lagcost = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar * DDSIP_param->scenarios, "lagcost(NonAnt)");
+    DDSIP_bb->lagdual = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->dimdual, "lagdual(NonAnt)");
 
+    // x_j = sum p_i x_i
+    // The matrix has firstvar*S*(S-1) nonzeros, it is not stored. DDSIP_NonAntTimes and DDSIP_NonAntCost
+    // apply it in closed form (weighted mean minus own value) in O(S*firstvar).
     if (DDSIP_param->nonant == 3)
     {
-        DDSIP_data->naind =
-            (int *) DDSIP_Alloc (sizeof (int), DDSIP_bb->firstvar * DDSIP_param->scenarios * (DDSIP_param->scenarios - 1), "naind(NonAnt)");
-        DDSIP_data->naval =
-            (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar * DDSIP_param->scenarios * (DDSIP_param->scenarios - 1), "naval(NonAnt)");
-    }
-    else
-    {
-        DDSIP_data->naind = (int *) DDSIP_Alloc (sizeof (int), 2 * DDSIP_bb->firstvar * DDSIP_param->scenarios, "naind(NonAnt)");
-        DDSIP_data->naval = (double *) DDSIP_Alloc (sizeof (double), 2 * DDSIP_bb->firstvar * DDSIP_param->scenarios, "naval(NonAnt)");
+#ifdef DEBUG
+        if (DDSIP_param->outlev)
+        {
+            // compare with the explicit matrix:
+            // column (scen,i) has the entry 1-p_scen in row scen*firstvar+i (scen < S-1) and -p_scen in the rows j*firstvar+i, j<S-1, j!=scen
+            double **x, *y, *lambda, *cost, h, diff = 0.;
+
+            x = (double **) DDSIP_Alloc (sizeof (double *), DDSIP_param->scenarios, "x(NonAnt)");
+            for (scen = 0; scen < DDSIP_param->scenarios; scen++)
+            {
+                x[scen] = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "x[scen](NonAnt)");
+                for (i = 0; i < DDSIP_bb->firstvar; i++)
+                    x[scen][i] = 1. + (scen * DDSIP_bb->firstvar + i) % 7;
+            }
+            lambda = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->dimdual, "lambda(NonAnt)");
+            for (j = 0; j < DDSIP_bb->dimdual; j++)
+                lambda[j] = 1. - 0.5 * (j % 5);
+            y = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->dimdual, "y(NonAnt)");
+            cost = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar * DDSIP_param->scenarios, "cost(NonAnt)");
+            DDSIP_NonAntTimes (x, y, NULL);
+            DDSIP_NonAntCost (lambda, cost);
+            for (scen = 0; scen < DDSIP_param->scenarios; scen++)
+                for (i = 0; i < DDSIP_bb->firstvar; i++)
+                {
+                    h = 0.;
+                    for (j = 0; j < DDSIP_param->scenarios - 1; j++)
+                    {
+                        if (j == scen)
+                            y[j * DDSIP_bb->firstvar + i] -= (1 - DDSIP_data->prob[scen]) * x[scen][i];
+                        else
+                            y[j * DDSIP_bb->firstvar + i] += DDSIP_data->prob[scen] * x[scen][i];
+                        h += (j == scen ? 1 - DDSIP_data->prob[scen] : -DDSIP_data->prob[scen]) * lambda[j * DDSIP_bb->firstvar + i];
+                    }
+                    diff = DDSIP_Dmax (diff, fabs (cost[scen * DDSIP_bb->firstvar + i] - h / DDSIP_data->prob[scen]));
+                }
+            for (j = 0; j < DDSIP_bb->dimdual; j++)
+                diff = DDSIP_Dmax (diff, fabs (y[j]));
+            fprintf (DDSIP_bb->moreoutfile, "\nNonanticipativity constraints: x_SCj - sum p_SCs * x_SCs = 0, j < %d\n", DDSIP_param->scenarios);
+            fprintf (DDSIP_bb->moreoutfile, "max. deviation of closed form from explicit matrix: %g\n", diff);
+            for (scen = 0; scen < DDSIP_param->scenarios; scen++)
+                DDSIP_Free ((void **) &(x[scen]));
+            DDSIP_Free ((void **) &(x));
+            DDSIP_Free ((void **) &(y));
+            DDSIP_Free ((void **) &(lambda));
+            DDSIP_Free ((void **) &(cost));
+        }
+#endif
+        return status;
     }
 
+    DDSIP_data->nabeg = (int *) DDSIP_Alloc (sizeof (int), DDSIP_bb->firstvar * DDSIP_param->scenarios, "nabeg(NonAnt)");
+    DDSIP_data->nacnt = (int *) DDSIP_Alloc (sizeof (int), DDSIP_bb->firstvar * DDSIP_param->scenarios, "nacnt(NonAnt)");
+    DDSIP_data->naind = (int *) DDSIP_Alloc (sizeof (int), 2 * DDSIP_bb->firstvar * DDSIP_param->scenarios, "naind(NonAnt)");
+    DDSIP_data->naval = (double *) DDSIP_Alloc (sizeof (double), 2 * DDSIP_bb->firstvar * DDSIP_param->scenarios, "naval(NonAnt)");
+
     // x1=x2, x2=x3 ... x(S-1)=xS
     if (DDSIP_param->nonant == 2)
     {
@@ -81,26 +160,6 @@ DDSIP_NonAnt (void)
                 }
             }
     }
-    // x_j = sum p_i x_i
-    else if (DDSIP_param->nonant == 3)
-    {
-        k = 0;
-        for (scen = 0; scen < DDSIP_param->scenarios; scen++)
-            for (i = 0; i < DDSIP_bb->firstvar; i++)
-            {
-                DDSIP_data->nabeg[scen * DDSIP_bb->firstvar + i] = k;
-                DDSIP_data->nacnt[scen * DDSIP_bb->firstvar + i] = DDSIP_param->scenarios - 1;
-
-                for (j = 0; j < DDSIP_param->scenarios-1; j++)
-                {
-                    DDSIP_data->naind[k] = j * DDSIP_bb->firstvar + i;
-                    if (j == scen)
-                        DDSIP_data->naval[k++] = 1 - DDSIP_data->prob[scen];
-                    else
-                        DDSIP_data->naval[k++] = -DDSIP_data->prob[scen];
-                }
-            }
-    }
     // x1=x2, x1=x3 ... x1=xS
     else
     {
@@ -128,6 +187,32 @@ DDSIP_NonAnt (void)
             }
     }
 
+    // The same matrix row-wise for the subgradient and scaled column-wise for the cost corrections,
+    // built once here for DDSIP_NonAntTimes and DDSIP_LagrangeCost
+    DDSIP_data->naval_p = (double *) DDSIP_Alloc (sizeof (double), k, "naval_p(NonAnt)");
+    DDSIP_data->narbeg = (int *) DDSIP_Alloc (sizeof (int), DDSIP_bb->dimdual + 1, "narbeg(NonAnt)");
+    DDSIP_data->narind = (int *) DDSIP_Alloc (sizeof (int), k, "narind(NonAnt)");
+    DDSIP_data->narval = (double *) DDSIP_Alloc (sizeof (double), k, "narval(NonAnt)");
+    pos = (int *) DDSIP_Alloc (sizeof (int), DDSIP_bb->dimdual + 1, "pos(NonAnt)");
+    for (scen = 0; scen < DDSIP_param->scenarios; scen++)
+        for (i = 0; i < DDSIP_bb->firstvar; i++)
+            for (j = DDSIP_data->nabeg[scen * DDSIP_bb->firstvar + i];
+                    j < DDSIP_data->nabeg[scen * DDSIP_bb->firstvar + i] + DDSIP_data->nacnt[scen * DDSIP_bb->firstvar + i]; j++)
+            {
+                DDSIP_data->naval_p[j] = DDSIP_data->naval[j] / DDSIP_data->prob[scen];
+                DDSIP_data->narbeg[DDSIP_data->naind[j] + 1]++;
+            }
+    for (j = 0; j < DDSIP_bb->dimdual; j++)
+        pos[j + 1] = DDSIP_data->narbeg[j + 1] += DDSIP_data->narbeg[j];
+    // the columns in ascending order, i.e. the scenarios of a row in the order of the former column-wise loops
+    for (k = 0; k < DDSIP_bb->firstvar * DDSIP_param->scenarios; k++)
+        for (j = DDSIP_data->nabeg[k]; j < DDSIP_data->nabeg[k] + DDSIP_data->nacnt[k]; j++)
+        {
+            DDSIP_data->narind[pos[DDSIP_data->naind[j]]] = k;
+            DDSIP_data->narval[pos[DDSIP_data->naind[j]]++] = DDSIP_data->naval[j];
+        }
+    DDSIP_Free ((void **) &(pos));
+
 #ifdef DEBUG
     if (DDSIP_param->outlev > 97)
     {
@@ -172,6 +257,188 @@ DDSIP_NonAnt (void)
     return status;
 }
 
+//==========================================================================
+// y = H x for the nonanticipativity matrix H and the first-stage solutions x[scen] of the scenarios,
+// maxval (if not NULL) returns the largest absolute value of the products summed up in each row
+void
+DDSIP_NonAntTimes (double **x, double *y, double *maxval)
+{
+    int scen, r, i, j, *arg;
+    double h, sum, *xall, *mean, *big, *big2;
+
+    if (DDSIP_param->nonant == 3)
+    {
+        // row j*firstvar+i, j < S-1: x_j,i - sum_s p_s x_s,i, the rows of the last scenario are empty.
+        // The largest product in a row is (1-p_j)|x_j,i| or the largest p_s|x_s,i| with s != j,
+        // so the two largest p_s|x_s,i| of each variable are kept.
+        mean = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "mean(NonAntTimes)");
+        big = big2 = NULL;
+        arg = NULL;
+        if (maxval)
+        {
+            big = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "big(NonAntTimes)");
+            big2 = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "big2(NonAntTimes)");
+            arg = (int *) DDSIP_Alloc (sizeof (int), DDSIP_bb->firstvar, "arg(NonAntTimes)");
+        }
+        for (scen = 0; scen < DDSIP_param->scenarios; scen++)
+            for (i = 0; i < DDSIP_bb->firstvar; i++)
+            {
+                h = DDSIP_data->prob[scen] * x[scen][i];
+                mean[i] += h;
+                if (maxval)
+                {
+                    h = fabs (h);
+                    if (h > big[i])
+                    {
+                        big2[i] = big[i];
+                        big[i] = h;
+                        arg[i] = scen;
+                    }
+                    else if (h > big2[i])
+                        big2[i] = h;
+                }
+            }
+        for (scen = 0; scen < DDSIP_param->scenarios - 1; scen++)
+            for (i = 0; i < DDSIP_bb->firstvar; i++)
+            {
+                r = scen * DDSIP_bb->firstvar + i;
+                y[r] = x[scen][i] - mean[i];
+                if (maxval)
+                    maxval[r] = DDSIP_Dmax ((1. - DDSIP_data->prob[scen]) * fabs (x[scen][i]), arg[i] == scen ? big2[i] : big[i]);
+            }
+        for (r = scen * DDSIP_bb->firstvar; r < DDSIP_bb->dimdual; r++)
+        {
+            y[r] = 0.;
+            if (maxval)
+                maxval[r] = 0.;
+        }
+        DDSIP_Free ((void **) &(mean));
+        DDSIP_Free ((void **) &(big));
+        DDSIP_Free ((void **) &(big2));
+        DDSIP_Free ((void **) &(arg));
+        return;
+    }
+    xall = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar * DDSIP_param->scenarios, "xall(NonAntTimes)");
+    for (scen = 0; scen < DDSIP_param->scenarios; scen++)
+        memcpy (xall + scen * DDSIP_bb->firstvar, x[scen], DDSIP_bb->firstvar * sizeof (double));
+    for (r = 0; r < DDSIP_bb->dimdual; r++)
+    {
+        sum = 0.;
+        if (maxval)
+        {
+            maxval[r] = 0.;
+            for (j = DDSIP_data->narbeg[r]; j < DDSIP_data->narbeg[r + 1]; j++)
+            {
+                h = DDSIP_data->narval[j] * xall[DDSIP_data->narind[j]];
+                sum += h;
+                maxval[r] = DDSIP_Dmax (maxval[r], fabs (h));
+            }
+        }
+        else
+            for (j = DDSIP_data->narbeg[r]; j < DDSIP_data->narbeg[r + 1]; j++)
+                sum += DDSIP_data->narval[j] * xall[DDSIP_data->narind[j]];
+        y[r] = sum;
+    }
+    DDSIP_Free ((void **) &(xall));
+} // DDSIP_NonAntTimes
+
+//==========================================================================
+// y = sum of H_s x[s] over the scenarios first <= s < last, H_s the columns of scenario s
+// in the nonanticipativity matrix (the part of the subgradient of a scenario group)
+static void
+DDSIP_NonAntColumns (double **x, int first, int last, double *y)
+{
+    int scen, i, j, k;
+    double *mean;
+
+    memset (y, '\0', sizeof (double) * DDSIP_bb->dimdual);
+    if (DDSIP_param->nonant == 3)
+    {
+        // column (scen,i): 1-p_scen in row scen*firstvar+i (scen < S-1), -p_scen in the other rows j*firstvar+i, j < S-1
+        mean = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "mean(NonAntColumns)");
+        for (scen = first; scen < last; scen++)
+            if (x[scen])
+                for (i = 0; i < DDSIP_bb->firstvar; i++)
+                    mean[i] += DDSIP_data->prob[scen] * x[scen][i];
+        for (scen = 0; scen < DDSIP_param->scenarios - 1; scen++)
+            for (i = 0; i < DDSIP_bb->firstvar; i++)
+                y[scen * DDSIP_bb->firstvar + i] = -mean[i];
+        for (scen = first; scen < last && scen < DDSIP_param->scenarios - 1; scen++)
+            if (x[scen])
+                for (i = 0; i < DDSIP_bb->firstvar; i++)
+                    y[scen * DDSIP_bb->firstvar + i] += x[scen][i];
+        DDSIP_Free ((void **) &(mean));
+        return;
+    }
+    for (scen = first; scen < last; scen++)
+        if (x[scen])
+            for (i = 0; i < DDSIP_bb->firstvar; i++)
+            {
+                k = scen * DDSIP_bb->firstvar + i;
+                for (j = DDSIP_data->nabeg[k]; j < DDSIP_data->nabeg[k] + DDSIP_data->nacnt[k]; j++)
+                    y[DDSIP_data->naind[j]] += DDSIP_data->naval[j] * x[scen][i];
+            }
+} // DDSIP_NonAntColumns
+
+//==========================================================================
+// Lagrangean cost corrections (H^T lambda)/p of the first-stage variables for all scenarios with the
+// multipliers of the current node, computed before the scenario problems are solved (DDSIP_ChgProbLp
+// uses them, also in the worker threads). Nothing is done if the multipliers did not change.
+void
+DDSIP_LagrangeCost (void)
+{
+    const double *dual = DDSIP_node[DDSIP_bb->curnode]->dual;
+
+    if (!memcmp (dual, DDSIP_bb->lagdual, DDSIP_bb->dimdual * sizeof (double)))
+        return;
+    memcpy (DDSIP_bb->lagdual, dual, DDSIP_bb->dimdual * sizeof (double));
+    DDSIP_NonAntCost (dual, DDSIP_bb->lagcost);
+} // DDSIP_LagrangeCost
+
+//==========================================================================
+// Empty the boxes of the first-stage solutions in the models of the functions first,...,last-1 (CBREUSE)
+static void
+DDSIP_DualResetBoxes (int first, int last)
+{
+    int j;
+
+    for (j = first * DDSIP_bb->firstvar; j < last * DDSIP_bb->firstvar; j++)
+    {
+        DDSIP_bb->cbsolmin[j] = DDSIP_infty;
+        DDSIP_bb->cbsolmax[j] = -DDSIP_infty;
+    }
+} // DDSIP_DualResetBoxes
+
+//==========================================================================
+// Extend the box of the first-stage solutions in the model of function g by the solutions of the
+// scenarios first,...,last-1 which gave its subgradient (CBREUSE)
+static void
+DDSIP_DualExtendBox (int g, int first, int last)
+{
+    int j, scen;
+    double *solmin = DDSIP_bb->cbsolmin + g * DDSIP_bb->firstvar;
+    double *solmax = DDSIP_bb->cbsolmax + g * DDSIP_bb->firstvar;
+
+    for (scen = first; scen < last; scen++)
+    {
+        // no solution behind the subgradient, the model cannot be kept for another node
+        if (DDSIP_bb->skip == 2 || !(DDSIP_node[DDSIP_bb->curnode]->first_sol)[scen])
+        {
+            for (j = 0; j < DDSIP_bb->firstvar; j++)
+            {
+                solmin[j] = -DDSIP_infty;
+                solmax[j] = DDSIP_infty;
+            }
+            return;
+        }
+        for (j = 0; j < DDSIP_bb->firstvar; j++)
+        {
+            solmin[j] = DDSIP_Dmin (solmin[j], (DDSIP_node[DDSIP_bb->curnode]->first_sol)[scen][j]);
+            solmax[j] = DDSIP_Dmax (solmax[j], (DDSIP_node[DDSIP_bb->curnode]->first_sol)[scen][j]);
+        }
+    }
+} // DDSIP_DualExtendBox
+
 //==========================================================================
 // This function is called by Helmbergs conic bundle method to update the subgradient
 // and the objective value
@@ -181,7 +448,7 @@ DDSIP_DualUpdate (void *function_key, double *dual, double relprec,
                   int max_new_subg, double *objective_value, int *new_subg,
                   double *subgval, double *subgradient, double *primal)
 {
-    int status, scen, i, j;
+    int status, scen, i;
     int k;
     double h;
 #ifdef CANCELLATION
@@ -269,20 +536,12 @@ ONCE_AGAIN:
             for (scen = 0; scen < DDSIP_param->scenarios; scen++)
                 printf (" %g|", DDSIP_bb->ref_risk[scen]);
         }
-        for (i = 0; i < DDSIP_bb->firstvar; i++)
+        DDSIP_NonAntTimes (DDSIP_node[DDSIP_bb->curnode]->first_sol, subgradient, NULL);
+        for (k = 0; k < DDSIP_bb->dimdual; k++)
         {
-            for (scen = 0; scen < DDSIP_param->scenarios; scen++)
-            {
-                for (j = DDSIP_data->nabeg[scen * DDSIP_bb->firstvar + i];
-                        j < DDSIP_data->nabeg[scen * DDSIP_bb->firstvar + i] + DDSIP_data->nacnt[scen * DDSIP_bb->firstvar + i]; j++)
-                {
-                    subgradient[DDSIP_data->naind[j]] -= DDSIP_data->naval[j] * (DDSIP_node[DDSIP_bb->curnode]->first_sol)[scen][i] / DDSIP_param->ref_scale[0];
-                    if (DDSIP_param->outlev > 29)
-                        printf (" Subgradient[%d]: Scenario %d, Variable %d (Werte: %g): -= %g\n", DDSIP_data->naind[j], scen, i,
-                                (DDSIP_node[DDSIP_bb->curnode]->first_sol)[scen][i],
-                                DDSIP_data->naval[j] * (DDSIP_node[DDSIP_bb->curnode]->first_sol)[scen][i] / DDSIP_param->ref_scale[0]);
-                }
-            }
+            subgradient[k] = -subgradient[k] / DDSIP_param->ref_scale[0];
+            if (DDSIP_param->outlev > 29)
+                printf (" Subgradient[%d]: %g\n", k, subgradient[k]);
         }
         if (DDSIP_param->outlev > 29)
         {
@@ -297,18 +556,13 @@ ONCE_AGAIN:
 #endif
         if (DDSIP_bb->violations)
         {
-            for (i = 0; i < DDSIP_bb->firstvar; i++)
-                for (scen = 0; scen < DDSIP_param->scenarios; scen++)
-                    for (j = DDSIP_data->nabeg[scen * DDSIP_bb->firstvar + i];
-                            j < DDSIP_data->nabeg[scen * DDSIP_bb->firstvar + i] + DDSIP_data->nacnt[scen * DDSIP_bb->firstvar + i]; j++)
-                    {
-			k = DDSIP_data->naind[j];
-                        h = DDSIP_data->naval[j] * (DDSIP_node[DDSIP_bb->curnode]->first_sol)[scen][i];
-                        subgradient[k] -= h;
 #ifdef CANCELLATION
-                        maxval[k] = DDSIP_Dmax (maxval[k], fabs (h));
+            DDSIP_NonAntTimes (DDSIP_node[DDSIP_bb->curnode]->first_sol, subgradient, maxval);
+#else
+            DDSIP_NonAntTimes (DDSIP_node[DDSIP_bb->curnode]->first_sol, subgradient, NULL);
 #endif
-                    }
+            for (k = 0; k < DDSIP_bb->dimdual; k++)
+                subgradient[k] = -subgradient[k];
         }
 #ifdef CANCELLATION
         {
@@ -394,6 +648,8 @@ ONCE_AGAIN:
     }
 //#endif
     *new_subg = 1;
+    if (DDSIP_param->cbreuse && DDSIP_param->cbfunctions < 2)
+        DDSIP_DualExtendBox (0, 0, DDSIP_param->scenarios);
     if (DDSIP_killsignal)
     {
         fprintf (DDSIP_outfile, "\nTermination signal received.\n");
@@ -405,6 +661,169 @@ ONCE_AGAIN:
     return 0;
 }
 
+//==========================================================================
+// First scenario of group g of the decomposed dual (the groups are consecutive ranges of scenarios)
+static int
+DDSIP_DualGroupBegin (int g)
+{
+    return (int) (((long long) g * DDSIP_param->scenarios) / DDSIP_param->cbfunctions);
+} // DDSIP_DualGroupBegin
+
+//==========================================================================
+// Function of a scenario group in the decomposed dual (CBFUNCTIONS > 1), called by ConicBundle
+// for each group at a point. The scenario problems are solved once per point by DDSIP_DualUpdate,
+// each group gets the share of its scenarios in the dual objective and the subgradient.
+int
+DDSIP_DualUpdateGroup (void *function_key, double *dual, double relprec,
+                       int max_new_subg, double *objective_value, int *new_subg,
+                       double *subgval, double *subgradient, double *primal)
+{
+    int g = *(int *) function_key, h, k, scen;
+    double obj, sum;
+
+    // a new point or the group is evaluated again at the same point (e.g. after a reinit of the model)
+    if (DDSIP_bb->cbserved[g] || memcmp (dual, DDSIP_bb->cbpoint, sizeof (double) * DDSIP_bb->dimdual))
+    {
+        memcpy (DDSIP_bb->cbpoint, dual, sizeof (double) * DDSIP_bb->dimdual);
+        memset (DDSIP_bb->cbserved, '\0', DDSIP_param->cbfunctions);
+        DDSIP_bb->cbstatus = DDSIP_DualUpdate (function_key, dual, relprec, max_new_subg, &obj, &(DDSIP_bb->cbnewsubg), subgval, subgradient, primal);
+        if (!DDSIP_bb->cbstatus)
+        {
+            // the first group takes what is not assigned to a scenario
+            sum = 0.;
+            for (h = 1; h < DDSIP_param->cbfunctions; h++)
+            {
+                DDSIP_bb->cbgroupobj[h] = 0.;
+                for (scen = DDSIP_DualGroupBegin (h); scen < DDSIP_DualGroupBegin (h + 1); scen++)
+                    DDSIP_bb->cbgroupobj[h] -= DDSIP_data->prob[scen] * (DDSIP_node[DDSIP_bb->curnode]->subbound)[scen];
+                sum += DDSIP_bb->cbgroupobj[h];
+            }
+            DDSIP_bb->cbgroupobj[0] = obj - sum;
+        }
+    }
+    DDSIP_bb->cbserved[g] = 1;
+    if (DDSIP_bb->cbstatus)
+    {
+        *new_subg = 0;
+        return DDSIP_bb->cbstatus;
+    }
+    *objective_value = DDSIP_bb->cbgroupobj[g];
+    subgval[0] = *objective_value;
+    *new_subg = DDSIP_bb->cbnewsubg;
+    // subgradient -H_g x_g of the group
+    if (DDSIP_bb->skip == 2)
+        memset (subgradient, '\0', sizeof (double) * DDSIP_bb->dimdual);
+    else
+    {
+        DDSIP_NonAntColumns (DDSIP_node[DDSIP_bb->curnode]->first_sol, DDSIP_DualGroupBegin (g), DDSIP_DualGroupBegin (g + 1), subgradient);
+        for (k = 0; k < DDSIP_bb->dimdual; k++)
+            subgradient[k] = -subgradient[k];
+    }
+    if (DDSIP_param->cbreuse)
+        DDSIP_DualExtendBox (g, DDSIP_DualGroupBegin (g), DDSIP_DualGroupBegin (g + 1));
+    if (DDSIP_param->outlev > 29)
+        fprintf (DDSIP_bb->moreoutfile, "   ## function %d (scenarios %d - %d): %.14g\n", g + 1, DDSIP_DualGroupBegin (g) + 1, DDSIP_DualGroupBegin (g + 1), *objective_value);
+    return 0;
+} // DDSIP_DualUpdateGroup
+
+//==========================================================================
+// Add the function(s) of the dual to the ConicBundle problem
+static int
+DDSIP_DualAddFunctions (cb_problemp p)
+{
+    int g;
+
+    if (DDSIP_param->cbfunctions < 2)
+    {
+        if (cb_add_function (p, (void *) DDSIP_DualUpdate, DDSIP_DualUpdate, 0, 0))
+            return 1;
+        cb_set_max_bundlesize (p, (void *) DDSIP_DualUpdate, DDSIP_param->cbbundlesz);
+        cb_set_max_new_subgradients (p, (void *) DDSIP_DualUpdate, DDSIP_param->cbmaxsubg);
+        return 0;
+    }
+    memset (DDSIP_bb->cbserved, 1, DDSIP_param->cbfunctions);
+    for (g = 0; g < DDSIP_param->cbfunctions; g++)
+    {
+        if (cb_add_function (p, (void *) (DDSIP_bb->cbkey + g), DDSIP_DualUpdateGroup, 0, 0))
+            return 1;
+        cb_set_max_bundlesize (p, (void *) (DDSIP_bb->cbkey + g), DDSIP_param->cbbundlesz);
+        cb_set_max_new_subgradients (p, (void *) (DDSIP_bb->cbkey + g), DDSIP_param->cbmaxsubg);
+    }
+    return 0;
+} // DDSIP_DualAddFunctions
+
+//==========================================================================
+// Reinitialize the cutting plane model(s) of the dual, the scenario problems are solved at the next point
+static int
+DDSIP_DualReinitModel (cb_problemp p)
+{
+    int g;
+
+    if (DDSIP_param->cbreuse)
+        DDSIP_DualResetBoxes (0, DDSIP_param->cbfunctions);
+    if (DDSIP_param->cbfunctions < 2)
+        return cb_reinit_function_model (p, (void *) DDSIP_DualUpdate);
+    memset (DDSIP_bb->cbserved, 1, DDSIP_param->cbfunctions);
+    for (g = 0; g < DDSIP_param->cbfunctions; g++)
+        if (cb_reinit_function_model (p, (void *) (DDSIP_bb->cbkey + g)))
+            return 1;
+    return 0;
+} // DDSIP_DualReinitModel
+
+//==========================================================================
+// Continue with the ConicBundle problem kept from the last node (CBREUSE). A cutting plane of a function
+// stems from scenario solutions x_s with D(lambda) <= L(x_s,lambda) for all lambda as long as x_s is
+// feasible, so the model of a function stays valid if the box of its solutions lies within the
+// first-stage bounds of the current node and no cuts were added meanwhile. The other models are
+// reinitialized, all functions are evaluated again at the next point.
+static int
+DDSIP_DualReuseModel (cb_problemp p)
+{
+    int g, j, k, status = 0, kept = 0;
+    double *nodelb, *nodeub, *solmin, *solmax;
+
+    nodelb = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "nodelb(DualReuseModel)");
+    nodeub = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "nodeub(DualReuseModel)");
+    memcpy (nodelb, DDSIP_bb->lborg, sizeof (double) * DDSIP_bb->firstvar);
+    memcpy (nodeub, DDSIP_bb->uborg, sizeof (double) * DDSIP_bb->firstvar);
+    for (k = 0; k < DDSIP_bb->curbdcnt; k++)
+    {
+        nodelb[DDSIP_bb->curind[k]] = DDSIP_bb->curlb[k];
+        nodeub[DDSIP_bb->curind[k]] = DDSIP_bb->curub[k];
+    }
+    if (DDSIP_param->cbfunctions > 1)
+        memset (DDSIP_bb->cbserved, 1, DDSIP_param->cbfunctions);
+    for (g = 0; g < DDSIP_param->cbfunctions; g++)
+    {
+        solmin = DDSIP_bb->cbsolmin + g * DDSIP_bb->firstvar;
+        solmax = DDSIP_bb->cbsolmax + g * DDSIP_bb->firstvar;
+        // cuts added meanwhile may cut off the solutions
+        if (DDSIP_bb->cbcuts != DDSIP_bb->cutNumber)
+            j = -1;
+        else
+            for (j = 0; j < DDSIP_bb->firstvar; j++)
+                if (solmin[j] < nodelb[j] - 1.e-9 * (fabs (nodelb[j]) + 1.) || solmax[j] > nodeub[j] + 1.e-9 * (fabs (nodeub[j]) + 1.))
+                    break;
+        if (j < DDSIP_bb->firstvar)
+        {
+            DDSIP_DualResetBoxes (g, g + 1);
+            if (DDSIP_param->cbfunctions < 2)
+                status = cb_reinit_function_model (p, (void *) DDSIP_DualUpdate);
+            else
+                status = cb_reinit_function_model (p, (void *) (DDSIP_bb->cbkey + g));
+            if (status)
+                break;
+        }
+        else
+            kept++;
+    }
+    if (DDSIP_param->outlev)
+        fprintf (DDSIP_bb->moreoutfile, "   reusing the ConicBundle problem of the last node: kept the models of %d of %d functions\n", kept, DDSIP_param->cbfunctions);
+    DDSIP_Free ((void **) &(nodelb));
+    DDSIP_Free ((void **) &(nodeub));
+    return status;
+} // DDSIP_DualReuseModel
+
 //==========================================================================
 // Main procedure of Helmbergs conic bundle implementation
 int
@@ -421,6 +840,7 @@ DDSIP_DualOpt (void)
     double old_cpxrelgap = 1.e-16, old_cpxtimelim = 1000000., old_cpxrelgap2 = 1.e-16, old_cpxtimelim2 = 1000000., last_weight, next_weight;
     double reduction_factor = 0.50;
     double nfactor;
+    int    reused;
     minfirst = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar,
                "minfirst(DualOpt)");
     maxfirst = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar,
@@ -459,53 +879,70 @@ DDSIP_DualOpt (void)
         }
     }
 
-    p = cb_construct_problem (0);
-    if (p == 0)
-    {
-        fprintf (stderr, "ERROR: construct_problem failed\n");
-        DDSIP_Free ((void **) &(minfirst));
-        DDSIP_Free ((void **) &(maxfirst));
-        DDSIP_Free ((void **) &(center_point));
-        return 1;
-    }
-    DDSIP_bb->dualProblem = p;
-    cb_clear (p);
-    cb_set_defaults (p);
-    if (cb_init_problem (p, DDSIP_bb->dimdual, NULL, NULL))
+    // continue with the problem of the last node if ConicBundle did not terminate it, otherwise a new problem
+    p = NULL;
+    reused = 0;
+    if (DDSIP_bb->cbkept)
     {
-        fprintf (stderr, "ERROR: init_problem failed\n");
-        cb_destruct_problem (&p);
-        DDSIP_Free ((void **) &(minfirst));
-        DDSIP_Free ((void **) &(maxfirst));
-        DDSIP_Free ((void **) &(center_point));
-        return 1;
-    }
-    if (cb_add_function (p, (void *) DDSIP_DualUpdate, DDSIP_DualUpdate, 0, 0))
-    {
-        fprintf (stderr, "ERROR: add DUAL_UPDATE failed\n");
-        cb_destruct_problem (&p);
-        DDSIP_Free ((void **) &(minfirst));
-        DDSIP_Free ((void **) &(maxfirst));
-        DDSIP_Free ((void **) &(center_point));
-        return 1;
+        DDSIP_bb->cbkept = 0;
+        if (!cb_termination_code (DDSIP_bb->dualProblem) && !DDSIP_DualReuseModel (DDSIP_bb->dualProblem))
+        {
+            p = DDSIP_bb->dualProblem;
+            reused = 1;
+        }
+        else
+            cb_destruct_problem (&(DDSIP_bb->dualProblem));
     }
-    if (cb_reinit_function_model(p, (void *) DDSIP_DualUpdate))
+    if (!p)
     {
-        fprintf (stderr, "ERROR: reinit_function_model failed\n");
-        cb_destruct_problem (&p);
-        DDSIP_Free ((void **) &(minfirst));
-        DDSIP_Free ((void **) &(maxfirst));
-        DDSIP_Free ((void **) &(center_point));
-        return 1;
+        DDSIP_bb->cbevals = 0;
+        p = cb_construct_problem (0);
+        if (p == 0)
+        {
+            fprintf (stderr, "ERROR: construct_problem failed\n");
+            DDSIP_Free ((void **) &(minfirst));
+            DDSIP_Free ((void **) &(maxfirst));
+            DDSIP_Free ((void **) &(center_point));
+            return 1;
+        }
+        DDSIP_bb->dualProblem = p;
+        cb_clear (p);
+        cb_set_defaults (p);
+        if (cb_init_problem (p, DDSIP_bb->dimdual, NULL, NULL))
+        {
+            fprintf (stderr, "ERROR: init_problem failed\n");
+            cb_destruct_problem (&p);
+            DDSIP_Free ((void **) &(minfirst));
+            DDSIP_Free ((void **) &(maxfirst));
+            DDSIP_Free ((void **) &(center_point));
+            return 1;
+        }
+        if (DDSIP_DualAddFunctions (p))
+        {
+            fprintf (stderr, "ERROR: add DUAL_UPDATE failed\n");
+            cb_destruct_problem (&p);
+            DDSIP_Free ((void **) &(minfirst));
+            DDSIP_Free ((void **) &(maxfirst));
+            DDSIP_Free ((void **) &(center_point));
+            return 1;
+        }
+        if (DDSIP_DualReinitModel (p))
+        {
+            fprintf (stderr, "ERROR: reinit_function_model failed\n");
+            cb_destruct_problem (&p);
+            DDSIP_Free ((void **) &(minfirst));
+            DDSIP_Free ((void **) &(maxfirst));
+            DDSIP_Free ((void **) &(center_point));
+            return 1;
+        }
     }
     DDSIP_bb->dualObjVal = -DDSIP_infty;
     old_obj = DDSIP_node[DDSIP_bb->curnode]->bound;
 
     cb_set_print_level (p, DDSIP_param->cbprint);
     cb_set_term_relprec (p, DDSIP_param->cbrelgap);
-    cb_set_eval_limit (p, DDSIP_param->cbtotalitlim);
-    cb_set_max_bundlesize (p, (void *) DDSIP_DualUpdate, DDSIP_param->cbbundlesz);
-    cb_set_max_new_subgradients (p, (void *) DDSIP_DualUpdate, DDSIP_param->cbmaxsubg);
+    // the evaluations of a kept problem are counted since its construction
+    cb_set_eval_limit (p, (DDSIP_param->cbtotalitlim < DDSIP_bigint - DDSIP_bb->cbevals) ? DDSIP_bb->cbevals + DDSIP_param->cbtotalitlim : DDSIP_bigint);
     cb_set_inner_update_limit 	(p, DDSIP_param->cb_maxsteps + 2);
     
     // The choice of the starting weight influences the convergence and results of Conic Bundle.
@@ -586,16 +1023,7 @@ fprintf(DDSIP_bb->moreoutfile, "### new start_weight= %.8g\n", start_weight);
             {
                 if (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[cpu_hrs])
                 {
-                    if ((cnt = (int) ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[cpu_hrs])[DDSIP_bb->firstvar] - 0.9)))
-                        for (j = cpu_hrs + 1; cnt && j < DDSIP_param->scenarios; j++)
-                        {
-                            if ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[cpu_hrs]) == (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]))
-                            {
-                                ((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j] = NULL;
-                                cnt--;
-                            }
-                        }
-                    DDSIP_Free ((void **) &(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[cpu_hrs]));
+                    DDSIP_FirstSolRelease (&(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[cpu_hrs]));
                 }
             }
             memcpy (DDSIP_node[DDSIP_bb->curnode]->dual, DDSIP_bb->startinfo_multipliers, sizeof (double) * (DDSIP_bb->dimdual+3));
@@ -633,16 +1061,7 @@ fprintf(DDSIP_bb->moreoutfile, "### new start_weight= %.8g\n", start_weight);
         {
             if (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[cpu_hrs])
             {
-                if ((cnt = (int) ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[cpu_hrs])[DDSIP_bb->firstvar] - 0.9)))
-                    for (j = cpu_hrs + 1; cnt && j < DDSIP_param->scenarios; j++)
-                    {
-                        if ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[cpu_hrs]) == (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]))
-                        {
-                            ((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j] = NULL;
-                            cnt--;
-                        }
-                    }
-                DDSIP_Free ((void **) &(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[cpu_hrs]));
+                DDSIP_FirstSolRelease (&(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[cpu_hrs]));
             }
         }
         if ((status = cb_set_new_center_point (p, DDSIP_bb->startinfo_multipliers)))
@@ -722,6 +1141,21 @@ fprintf(DDSIP_bb->moreoutfile, "### new start_weight= %.8g\n", start_weight);
             }
         }
     }
+    // the center of a kept problem has to be evaluated in this node
+    if (reused && !DDSIP_bb->dualitcnt)
+    {
+        if ((status = cb_set_new_center_point (p, DDSIP_node[DDSIP_bb->curnode]->dual)))
+        {
+            fprintf (stderr, "set_new_center_point returned %d\n", status);
+            if (DDSIP_param->outlev)
+                fprintf (DDSIP_bb->moreoutfile, "set_new_center_point returned %d\n", status);
+            cb_destruct_problem (&p);
+            DDSIP_Free ((void **) &(minfirst));
+            DDSIP_Free ((void **) &(maxfirst));
+            DDSIP_Free ((void **) &(center_point));
+            return status;
+        }
+    }
     DDSIP_bb->multipliers = 1;
     obj = DDSIP_bb->dualObjVal;
     if (obj > old_obj)
@@ -908,7 +1342,7 @@ fprintf(DDSIP_bb->moreoutfile, "### new start_weight= %.8g\n", start_weight);
         if (DDSIP_bb->cutAdded)
         {
             // reinit model
-            if (cb_reinit_function_model(p, (void *) DDSIP_DualUpdate))
+            if (DDSIP_DualReinitModel (p))
             {
                 fprintf (stderr, "ERROR: reinit_function_model failed\n");
                 cb_destruct_problem (&p);
@@ -1007,7 +1441,7 @@ fprintf(DDSIP_bb->moreoutfile, "### new start_weight= %.8g\n", start_weight);
                 {
                     DDSIP_bb->cutAdded = 0;
                     // reinit model
-                    if (cb_reinit_function_model(p, (void *) DDSIP_DualUpdate))
+                    if (DDSIP_DualReinitModel (p))
                     {
                         fprintf (stderr, "ERROR: reinit_function_model failed\n");
                         cb_destruct_problem (&p);
@@ -2178,16 +2612,7 @@ NEXT_TRY:
                             {
                                 if (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j])
                                 {
-                                    if ((cnt = (int) ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j])[DDSIP_bb->firstvar] - 0.9)))
-                                        for (i_scen = j + 1; cnt && i_scen < DDSIP_param->scenarios; i_scen++)
-                                        {
-                                            if ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]) == (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i_scen]))
-                                            {
-                                                ((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i_scen] = NULL;
-                                                cnt--;
-                                            }
-                                        }
-                                    DDSIP_Free ((void **) &(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]));
+                                    DDSIP_FirstSolRelease (&(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]));
                                 }
                                 DDSIP_node[DDSIP_bb->curnode]->first_sol[j]   = (DDSIP_bb->bestfirst[j]).first_sol;
                                 (DDSIP_node[DDSIP_bb->curnode]->cursubsol)[j] = (DDSIP_bb->bestfirst[j]).cursubsol;
@@ -3343,7 +3768,15 @@ while (tmp1_bestdual)
         fprintf (DDSIP_bb->moreoutfile, "\n");
     }
 
-    cb_destruct_problem (&p);
+    if (DDSIP_param->cbreuse)
+    {
+        // keep the problem with its bundle for the next node
+        DDSIP_bb->cbkept = 1;
+        DDSIP_bb->cbevals += DDSIP_bb->dualitcnt;
+        DDSIP_bb->cbcuts = DDSIP_bb->cutNumber;
+    }
+    else
+        cb_destruct_problem (&p);
     for (j = 0; j < DDSIP_bb->firstvar; j++)
     {
         minfirst[j] = DDSIP_infty;
@@ -3356,16 +3789,7 @@ while (tmp1_bestdual)
         {
             if (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j])
             {
-                if ((cnt = (int) ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j])[DDSIP_bb->firstvar] - 0.9)))
-                    for (i_scen = j + 1; cnt && i_scen < DDSIP_param->scenarios; i_scen++)
-                    {
-                        if ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]) == (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i_scen]))
-                        {
-                            ((DDSIP_node[DDSIP_bb->curnode])->first_sol)[i_scen] = NULL;
-                            cnt--;
-                        }
-                    }
-                DDSIP_Free ((void **) &(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]));
+                DDSIP_FirstSolRelease (&(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]));
             }
             DDSIP_node[DDSIP_bb->curnode]->first_sol[j]   = (DDSIP_bb->bestfirst[j]).first_sol;
             (DDSIP_node[DDSIP_bb->curnode]->cursubsol)[j] = (DDSIP_bb->bestfirst[j]).cursubsol;
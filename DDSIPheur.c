@@ -38,6 +38,8 @@ static int  DDSIP_MinSum (void);
 static int  DDSIP_MaxSum (void);
 static int  DDSIP_OneTenth (int, int);
 static int  DDSIP_All (int, int);
+static void DDSIP_AllSugAlloc (void);
+static void DDSIP_AllSuggest (int);
 static void DDSIP_BoundConsistent (void);
 
 
@@ -51,10 +53,10 @@ DDSIP_RoundDown (double *average)
     for (j = 0; j < DDSIP_bb->firstvar; j++)
     {
         if (DDSIP_bb->firsttype[j] == 'B' || DDSIP_bb->firsttype[j] == 'I' || DDSIP_bb->firsttype[j] == 'N') {
-            ((DDSIP_bb->sug[DDSIP_param->nodelim + 2])->firstval)[j] = floor (average[j] + 0.00001);
+            ((DDSIP_bb->sug[DDSIP_bb->nodecap])->firstval)[j] = floor (average[j] + 0.00001);
         }
         else
-            ((DDSIP_bb->sug[DDSIP_param->nodelim + 2])->firstval)[j] = average[j];
+            ((DDSIP_bb->sug[DDSIP_bb->nodecap])->firstval)[j] = average[j];
     }
     DDSIP_bb->from_scenario = -1;
 }
@@ -69,10 +71,10 @@ DDSIP_RoundUp (double *average)
     for (j = 0; j < DDSIP_bb->firstvar; j++)
     {
         if (DDSIP_bb->firsttype[j] == 'B' || DDSIP_bb->firsttype[j] == 'I' || DDSIP_bb->firsttype[j] == 'N') {
-            (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[j] = ceil (average[j]-0.00001);
+            (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[j] = ceil (average[j]-0.00001);
         }
         else
-            (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[j] = average[j];
+            (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[j] = average[j];
     }
     DDSIP_bb->from_scenario = -1;
 }
@@ -87,10 +89,10 @@ DDSIP_RoundNear (double *average)
     for (j = 0; j < DDSIP_bb->firstvar; j++)
     {
         if (DDSIP_bb->firsttype[j] == 'B' || DDSIP_bb->firsttype[j] == 'I' || DDSIP_bb->firsttype[j] == 'N') {
-            (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[j] = floor (average[j] + 0.50001);
+            (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[j] = floor (average[j] + 0.50001);
         }
         else
-            (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[j] = average[j];
+            (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[j] = average[j];
     }
     DDSIP_bb->from_scenario = -1;
 }
@@ -114,7 +116,7 @@ DDSIP_Frequent (void)
             fprintf (DDSIP_bb->moreoutfile, "... multiple suggestion (node %.0f).\n", (DDSIP_node[DDSIP_bb->curnode]->first_sol)[k][DDSIP_bb->firstvar + 2]);
         return 1;
     }
-    memcpy (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[k], sizeof (double) * DDSIP_bb->firstvar);
+    memcpy (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[k], sizeof (double) * DDSIP_bb->firstvar);
     DDSIP_bb->from_scenario = k;
     return 0;
 }
@@ -125,28 +127,19 @@ DDSIP_Frequent (void)
 int
 DDSIP_Probable (void)
 {
-    int i, j, k;
+    int i, k;
     double * prob;
+    int *first, *next;
     prob = (double *) DDSIP_Alloc(sizeof (double), DDSIP_param->scenarios, "prob(All)");
+    first = (int *) DDSIP_Alloc(sizeof (int), DDSIP_param->scenarios, "first(Probable)");
+    next = (int *) DDSIP_Alloc(sizeof (int), DDSIP_param->scenarios, "next(Probable)");
 
     //sum up probabilities of (equal) scenario solutions
-    prob[0] = DDSIP_data->prob[0];
-    for (i = 1; i < DDSIP_param->scenarios; i++)
-    {
-        k = i;
-        if ((DDSIP_node[DDSIP_bb->curnode]->first_sol)[i][DDSIP_bb->firstvar] > 1)
-        {
-            for (j = 0; j < i; j++)
-            {
-                if ((DDSIP_node[DDSIP_bb->curnode]->first_sol)[i] == (DDSIP_node[DDSIP_bb->curnode]->first_sol)[j])
-                {
-                    k = j;
-                    break;
-                }
-            }
-        }
-        prob[k] += DDSIP_data->prob[i];
-    }
+    DDSIP_FirstSolGroups (DDSIP_node[DDSIP_bb->curnode]->first_sol, first, next);
+    for (i = 0; i < DDSIP_param->scenarios; i++)
+        prob[first[i]] += DDSIP_data->prob[i];
+    DDSIP_Free ((void **) &(first));
+    DDSIP_Free ((void **) &(next));
     // determine the solution with maximal probability
     k = DDSIP_param->scenarios - 1;
     for (i = DDSIP_param->scenarios - 2; i >= 0; i--)
@@ -164,7 +157,7 @@ DDSIP_Probable (void)
             fprintf (DDSIP_bb->moreoutfile, "... multiple suggestion (node %.0f).\n", (DDSIP_node[DDSIP_bb->curnode]->first_sol)[k][DDSIP_bb->firstvar + 2]);
         return 1;
     }
-    memcpy (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[k], sizeof (double) * DDSIP_bb->firstvar);
+    memcpy (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[k], sizeof (double) * DDSIP_bb->firstvar);
     DDSIP_Free((void **) &prob);
     DDSIP_bb->from_scenario = k;
     return 0;
@@ -200,7 +193,7 @@ DDSIP_CloseToAverage (double *average)
             fprintf (DDSIP_bb->moreoutfile, "... multiple suggestion (node %.0f).\n", (DDSIP_node[DDSIP_bb->curnode]->first_sol)[minind][DDSIP_bb->firstvar + 2]);
         return 1;
     }
-    memcpy (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[minind], sizeof (double) * DDSIP_bb->firstvar);
+    memcpy (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[minind], sizeof (double) * DDSIP_bb->firstvar);
     DDSIP_bb->from_scenario = minind;
     return 0;
 }
@@ -227,7 +220,7 @@ DDSIP_SmallValue (void)
             fprintf (DDSIP_bb->moreoutfile, "... multiple suggestion (node %.0f).\n", (DDSIP_node[DDSIP_bb->curnode]->first_sol)[i][DDSIP_bb->firstvar + 2]);
         return 1;
     }
-    memcpy (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[i], sizeof (double) * DDSIP_bb->firstvar);
+    memcpy (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[i], sizeof (double) * DDSIP_bb->firstvar);
     DDSIP_bb->from_scenario = i;
     return 0;
 }
@@ -254,7 +247,7 @@ DDSIP_LargeValue (void)
             fprintf (DDSIP_bb->moreoutfile, "... multiple suggestion (node %.0f).\n", (DDSIP_node[DDSIP_bb->curnode]->first_sol)[i][DDSIP_bb->firstvar + 2]);
         return 1;
     }
-    memcpy (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[i], sizeof (double) * DDSIP_bb->firstvar);
+    memcpy (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[i], sizeof (double) * DDSIP_bb->firstvar);
     DDSIP_bb->from_scenario = i;
     return 0;
 }
@@ -297,7 +290,7 @@ DDSIP_MinSum (void)
             fprintf (DDSIP_bb->moreoutfile, "... multiple suggestion (node %.0f).\n", (DDSIP_node[DDSIP_bb->curnode]->first_sol)[minind][DDSIP_bb->firstvar + 2]);
         return 1;
     }
-    memcpy (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[minind], sizeof (double) * DDSIP_bb->firstvar);
+    memcpy (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[minind], sizeof (double) * DDSIP_bb->firstvar);
     DDSIP_bb->from_scenario = minind;
     return 0;
 }
@@ -340,22 +333,80 @@ DDSIP_MaxSum (void)
             fprintf (DDSIP_bb->moreoutfile, "... multiple suggestion (node %.0f).\n", (DDSIP_node[DDSIP_bb->curnode]->first_sol)[maxind][DDSIP_bb->firstvar + 2]);
         return 1;
     }
-    memcpy (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[maxind], sizeof (double) * DDSIP_bb->firstvar);
+    memcpy (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[maxind], sizeof (double) * DDSIP_bb->firstvar);
     DDSIP_bb->from_scenario = maxind;
     return 0;
 }
 
+//==========================================================================
+// Provide sug[nodecap] for a suggestion of heuristic 12, DDSIP_UpperBound moves an evaluated one to the list of the node
+static void
+DDSIP_AllSugAlloc (void)
+{
+    sug_t *tmp;
+
+    tmp = DDSIP_bb->sug[DDSIP_bb->nodecap];
+    if (!tmp)
+    {
+        // DDSIP_Allocate memory for heuristics suggestion if there is none yet
+        tmp = (sug_t *)DDSIP_Alloc (sizeof (sug_t), 1, "sug[i](Heuristic)");
+        tmp->firstval = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "sug[i]->firstval(Heuristic)");
+        tmp->next = NULL;
+        DDSIP_bb->sug[DDSIP_bb->nodecap] = tmp;
+    }
+    else
+    {
+        if (tmp->next != NULL)
+            printf("\n\n FEHLER: !!!!!!!!!!!!!!!!!!!!! DDSIP_bb->sug[DDSIP_bb->nodecap]->next = %p\n\n",DDSIP_bb->sug[DDSIP_bb->nodecap]->next);
+    }
+} // DDSIP_AllSugAlloc
+
+//==========================================================================
+// Put the solution of scenario scen into sug[nodecap] as a suggestion of heuristic 12
+static void
+DDSIP_AllSuggest (int scen)
+{
+    int ii;
+
+    DDSIP_AllSugAlloc ();
+    memcpy (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[scen], sizeof (double) * DDSIP_bb->firstvar);
+
+    if (DDSIP_param->relax)
+        for (ii = 0; ii < DDSIP_bb->firstvar; ii++)
+            if (DDSIP_bb->firsttype[ii] == 'B' || DDSIP_bb->firsttype[ii] == 'I' || DDSIP_bb->firsttype[ii] == 'N')
+                (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[ii] = floor (((DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[ii] + 0.5));
+
+    // Consistent?
+    DDSIP_BoundConsistent ();
+
+    // In case of worst-case risk measure change value of aux var to worst_case_lb for heuristics
+    if (abs(DDSIP_param->riskmod) == 4 && !DDSIP_bb->skip && !DDSIP_param->riskalg && !DDSIP_param->scalarization)
+    {
+        double worst_case_lb = -DDSIP_infty;
+        for (ii=0; ii<DDSIP_param->scenarios; ii++)
+        {
+            worst_case_lb = DDSIP_Dmax((DDSIP_node[DDSIP_bb->curnode]->first_sol)[ii][DDSIP_bb->firstvar-1], worst_case_lb);
+        }
+        (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[DDSIP_bb->firstvar - 1] = worst_case_lb + DDSIP_param->accuracy;
+    }
+} // DDSIP_AllSuggest
+
 //==========================================================================
 // All suggests successively all scenario problem solutions  Heur. 12
 int
 DDSIP_All (int nrScenarios, int feasCheckOnly)
 {
-    int i, ii, j, status;
+    int i, ii, k, status;
     int cnt;
+    int *drop, *order;
+    double **cand, *sum;
     int *unind = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "unind(All)");
-    sug_t *tmp;
+    int *first = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "first(All)");
+    int *next = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "next(All)");
 
-    j = cnt = 0;
+    DDSIP_FirstSolGroups (DDSIP_node[DDSIP_bb->curnode]->first_sol, first, next);
+    DDSIP_Free ((void **) &(next));
+    cnt = 0;
     for (i = DDSIP_param->scenarios-1; i > -1; i--)
     {
         if (!DDSIP_param->heuristic_auto)
@@ -367,18 +418,15 @@ DDSIP_All (int nrScenarios, int feasCheckOnly)
                 continue;
             }
         }
-        for (j = i - 1; j > -1; j--)
+        if (first[i] != i)
         {
-            if ((DDSIP_node[DDSIP_bb->curnode]->first_sol)[i] == (DDSIP_node[DDSIP_bb->curnode]->first_sol)[j])
-            {
-                if (DDSIP_param->outlev > 49)
-                    fprintf (DDSIP_bb->moreoutfile, "  Heuristic 12: solution of scenario %3d is the same as that of scenario %d\n", i, j);
-                break;
-            }
+            if (DDSIP_param->outlev > 49)
+                fprintf (DDSIP_bb->moreoutfile, "  Heuristic 12: solution of scenario %3d is the same as that of scenario %d\n", i, first[i]);
+            continue;
         }
-        if (j==-1)
-            unind[cnt++] = i;
+        unind[cnt++] = i;
     }
+    DDSIP_Free ((void **) &(first));
 
     if (!cnt)
     {
@@ -389,66 +437,96 @@ DDSIP_All (int nrScenarios, int feasCheckOnly)
         return 1;
     }
 
+    // Prepare the suggestions evaluated here (all but the last one)
+    cand = (double **) DDSIP_Alloc (sizeof (double *), cnt, "cand(All)");
+    drop = (int *) DDSIP_Alloc (sizeof (int), cnt, "drop(All)");
+    sum = (double *) DDSIP_Alloc (sizeof (double), cnt, "sum(All)");
+    order = (int *) DDSIP_Alloc (sizeof (int), cnt, "order(All)");
     for (i = cnt-1; i > 0; i--)
     {
-        if (DDSIP_killsignal)
-        {
-            DDSIP_Free ((void **) &(unind));
-            return 1;
-        }
-        tmp = DDSIP_bb->sug[DDSIP_param->nodelim + 2];
-        if (!tmp)
-        {
-            // DDSIP_Allocate memory for heuristics suggestion if there is none yet
-            tmp = (sug_t *)DDSIP_Alloc (sizeof (sug_t), 1, "sug[i](Heuristic)");
-            tmp->firstval = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "sug[i]->firstval(Heuristic)");
-            tmp->next = NULL;
-            DDSIP_bb->sug[DDSIP_param->nodelim + 2] = tmp;
-        }
-        else
-        {
-            if (tmp->next != NULL)
-                printf("\n\n FEHLER: !!!!!!!!!!!!!!!!!!!!! DDSIP_bb->sug[DDSIP_param->nodelim + 2]->next = %p\n\n",DDSIP_bb->sug[DDSIP_param->nodelim + 2]->next);
-        }
-
-        memcpy (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[unind[i]], sizeof (double) * DDSIP_bb->firstvar);
-
-        if (DDSIP_param->cpxubscr||DDSIP_param->outlev > 7)
-            printf ("Heuristic 12: suggested first stage solution of scen. %3d\n", unind[i]+1);
-        if(DDSIP_param->outlev)
-            fprintf (DDSIP_bb->moreoutfile, "\nHeuristic 12: suggested first stage solution of scen. %3d", unind[i]+1);
-
-        if (DDSIP_param->relax)
-            for (ii = 0; ii < DDSIP_bb->firstvar; ii++)
-                if (DDSIP_bb->firsttype[ii] == 'B' || DDSIP_bb->firsttype[ii] == 'I' || DDSIP_bb->firsttype[ii] == 'N')
-                    (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[ii] = floor (((DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[ii] + 0.5));
+        DDSIP_AllSuggest (unind[i]);
+        cand[i] = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "cand[i](All)");
+        memcpy (cand[i], DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval, sizeof (double) * DDSIP_bb->firstvar);
+        order[i] = i;
+    }
 
-        // Consistent?
-        DDSIP_BoundConsistent ();
+    // Evaluate the first ones scenario by scenario, the calls of DDSIP_UpperBound below take the results from the cache
+    // of upper bound results. Suggestions which cannot improve the best value are left out, the others are evaluated
+    // in the order of the expectation computed.
+    if (feasCheckOnly < 1 && DDSIP_param->threads < 2 && cnt > 2)
+    {
+        int nocand = 0, skip = DDSIP_bb->skip;
+        double viol, **bcand = (double **) DDSIP_Alloc (sizeof (double *), cnt, "bcand(All)");
+        int *bind = (int *) DDSIP_Alloc (sizeof (int), cnt, "bind(All)");
 
-        // In case of worst-case risk measure change value of aux var to worst_case_lb for heuristics
-        if (abs(DDSIP_param->riskmod) == 4 && !DDSIP_bb->skip && !DDSIP_param->riskalg && !DDSIP_param->scalarization)
+        for (i = cnt-1; i > 0 && nocand < DDSIP_bb->ubcachecap; i--)
         {
-            double worst_case_lb = -DDSIP_infty;
-            for (ii=0; ii<DDSIP_param->scenarios; ii++)
+            // suggestions rejected by DDSIP_SolChk are not evaluated
+            if (skip != -1)
             {
-                worst_case_lb = DDSIP_Dmax((DDSIP_node[DDSIP_bb->curnode]->first_sol)[ii][DDSIP_bb->firstvar-1], worst_case_lb);
+                memcpy (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval, cand[i], sizeof (double) * DDSIP_bb->firstvar);
+                if (!DDSIP_SolChk (&viol, 0))
+                {
+                    drop[i] = 1;
+                    continue;
+                }
             }
-            (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[DDSIP_bb->firstvar - 1] = worst_case_lb + DDSIP_param->accuracy;
+            bind[nocand] = i;
+            bcand[nocand++] = cand[i];
         }
+        DDSIP_bb->skip = skip;
+        if (nocand > 1)
+        {
+            int *bdrop = (int *) DDSIP_Alloc (sizeof (int), nocand, "bdrop(All)");
+            double *bsum = (double *) DDSIP_Alloc (sizeof (double), nocand, "bsum(All)");
+            if ((status = DDSIP_UpperBoundBatch (nocand, bcand, bdrop, bsum)))
+            {
+                fprintf (stderr, "ERROR: Failed to perform UpperBoundBatch (All)\n");
+                DDSIP_Free ((void **) &(bdrop));
+                DDSIP_Free ((void **) &(bsum));
+                DDSIP_Free ((void **) &(bcand));
+                DDSIP_Free ((void **) &(bind));
+                goto TERMINATE;
+            }
+            for (ii = 0; ii < nocand; ii++)
+            {
+                drop[bind[ii]] = (bdrop[ii] == 1);
+                sum[bind[ii]] = bsum[ii];
+            }
+            // descending order of the sums, the loop below starts at the end
+            DDSIP_qsort_ins_D (sum, order, bind[nocand - 1], cnt - 1);
+            DDSIP_Free ((void **) &(bdrop));
+            DDSIP_Free ((void **) &(bsum));
+        }
+        DDSIP_Free ((void **) &(bcand));
+        DDSIP_Free ((void **) &(bind));
+    }
 
-        DDSIP_bb->from_scenario = unind[i];
+    for (i = cnt-1; i > 0; i--)
+    {
         if (DDSIP_killsignal)
         {
-            DDSIP_Free ((void **) &(unind));
-            return 1;
+            status = 1;
+            goto TERMINATE;
         }
+        k = order[i];
+        if (drop[k])
+            continue;
+        DDSIP_AllSugAlloc ();
+        memcpy (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval, cand[k], sizeof (double) * DDSIP_bb->firstvar);
+
+        if (DDSIP_param->cpxubscr||DDSIP_param->outlev > 7)
+            printf ("Heuristic 12: suggested first stage solution of scen. %3d\n", unind[k]+1);
+        if(DDSIP_param->outlev)
+            fprintf (DDSIP_bb->moreoutfile, "\nHeuristic 12: suggested first stage solution of scen. %3d", unind[k]+1);
+
+        DDSIP_bb->from_scenario = unind[k];
         if ((status = DDSIP_UpperBound (nrScenarios, feasCheckOnly)))
         {
             if (status < 100000)
             {
                 fprintf (stderr, "ERROR: Failed to perform UpperBound (All)\n");
-                return status;
+                goto TERMINATE;
             }
             else if (DDSIP_param->interrupt_heur > 0)
             {
@@ -458,25 +536,26 @@ DDSIP_All (int nrScenarios, int feasCheckOnly)
             }
         }
     }
+    status = 0;
+
+TERMINATE:
+    for (i = cnt-1; i > 0; i--)
+        DDSIP_Free ((void **) &(cand[i]));
+    DDSIP_Free ((void **) &(cand));
+    DDSIP_Free ((void **) &(drop));
+    DDSIP_Free ((void **) &(sum));
+    DDSIP_Free ((void **) &(order));
+    if (status)
+    {
+        DDSIP_Free ((void **) &(unind));
+        return status;
+    }
 
 // the last scenario
     if (cnt)
     {
-        tmp = DDSIP_bb->sug[DDSIP_param->nodelim + 2];
-        if (!tmp)
-        {
-            // DDSIP_Allocate memory for heuristics suggestion if there is none yet
-            tmp = (sug_t *)DDSIP_Alloc (sizeof (sug_t), 1, "sug[i](Heuristic)");
-            tmp->firstval = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "sug[i]->firstval(Heuristic)");
-            tmp->next = NULL;
-            DDSIP_bb->sug[DDSIP_param->nodelim + 2] = tmp;
-        }
-        else
-        {
-            if (tmp->next != NULL)
-                printf("\n\n FEHLER: !!!!!!!!!!!!!!!!!!!!! DDSIP_bb->sug[DDSIP_param->nodelim + 2]->next = %p\n\n",DDSIP_bb->sug[DDSIP_param->nodelim + 2]->next);
-        }
-        memcpy (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[unind[0]], sizeof (double) * DDSIP_bb->firstvar);
+        DDSIP_AllSugAlloc ();
+        memcpy (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[unind[0]], sizeof (double) * DDSIP_bb->firstvar);
 
         if(DDSIP_param->outlev)
             fprintf (DDSIP_bb->moreoutfile, "\nHeuristic 12: suggested first stage solution of scen. %3d", unind[0]+1);
@@ -486,9 +565,9 @@ DDSIP_All (int nrScenarios, int feasCheckOnly)
     }
     else
     {
-        if (DDSIP_bb->sug[DDSIP_param->nodelim + 2])
-            DDSIP_Free ((void **) &(DDSIP_bb->sug[DDSIP_param->nodelim + 2]));
-        DDSIP_bb->sug[DDSIP_param->nodelim + 2] = NULL;
+        if (DDSIP_bb->sug[DDSIP_bb->nodecap])
+            DDSIP_Free ((void **) &(DDSIP_bb->sug[DDSIP_bb->nodecap]));
+        DDSIP_bb->sug[DDSIP_bb->nodecap] = NULL;
     }
     DDSIP_Free ((void **) &(unind));
 
@@ -500,13 +579,17 @@ DDSIP_All (int nrScenarios, int feasCheckOnly)
 int
 DDSIP_OneTenth (int nrScenarios, int feasCheckOnly)
 {
-    int i, ii, j, status, threshold;
+    int i, ii, status, threshold;
     int cnt;
     int *unind = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "unind(OneTenth)");
+    int *first = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "first(OneTenth)");
+    int *next = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "next(OneTenth)");
     sug_t *tmp;
 
+    DDSIP_FirstSolGroups (DDSIP_node[DDSIP_bb->curnode]->first_sol, first, next);
+    DDSIP_Free ((void **) &(next));
     threshold = DDSIP_Imax (2, DDSIP_param->scenarios/10);
-    j = cnt = 0;
+    cnt = 0;
     for (i = DDSIP_param->scenarios-1; i > -1; i--)
     {
         if (DDSIP_node[DDSIP_bb->curnode]->first_sol[i][DDSIP_bb->firstvar] < threshold)
@@ -520,18 +603,15 @@ DDSIP_OneTenth (int nrScenarios, int feasCheckOnly)
                 continue;
             }
         }
-        for (j = i - 1; j > -1; j--)
+        if (first[i] != i)
         {
-            if ((DDSIP_node[DDSIP_bb->curnode]->first_sol)[i] == (DDSIP_node[DDSIP_bb->curnode]->first_sol)[j])
-            {
-                if (DDSIP_param->outlev > 49)
-                    fprintf (DDSIP_bb->moreoutfile, "  Heuristic 11: solution of scenario %3d is the same as that of scenario %d\n", i, j);
-                break;
-            }
+            if (DDSIP_param->outlev > 49)
+                fprintf (DDSIP_bb->moreoutfile, "  Heuristic 11: solution of scenario %3d is the same as that of scenario %d\n", i, first[i]);
+            continue;
         }
-        if (j==-1)
-            unind[cnt++] = i;
+        unind[cnt++] = i;
     }
+    DDSIP_Free ((void **) &(first));
 
     if (!cnt)
     {
@@ -557,29 +637,29 @@ DDSIP_OneTenth (int nrScenarios, int feasCheckOnly)
         }
         //if (DDSIP_node[DDSIP_bb->curnode]->first_sol[unind[i]][DDSIP_bb->firstvar] >= threshold)
         {
-            tmp = DDSIP_bb->sug[DDSIP_param->nodelim + 2];
+            tmp = DDSIP_bb->sug[DDSIP_bb->nodecap];
             if (!tmp)
             {
                 // DDSIP_Allocate memory for heuristics suggestion if there is none yet
                 tmp = (sug_t *)DDSIP_Alloc (sizeof (sug_t), 1, "sug[i](Heuristic)");
                 tmp->firstval = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "sug[i]->firstval(Heuristic)");
                 tmp->next = NULL;
-                DDSIP_bb->sug[DDSIP_param->nodelim + 2] = tmp;
+                DDSIP_bb->sug[DDSIP_bb->nodecap] = tmp;
             }
             else
             {
                 if (tmp->next != NULL)
-                    printf("\n\n FEHLER: !!!!!!!!!!!!!!!!!!!!! DDSIP_bb->sug[DDSIP_param->nodelim + 2]->next = %p\n\n",DDSIP_bb->sug[DDSIP_param->nodelim + 2]->next);
+                    printf("\n\n FEHLER: !!!!!!!!!!!!!!!!!!!!! DDSIP_bb->sug[DDSIP_bb->nodecap]->next = %p\n\n",DDSIP_bb->sug[DDSIP_bb->nodecap]->next);
             }
 
             if(DDSIP_param->outlev)
                 fprintf (DDSIP_bb->moreoutfile, "\nHeuristic 11: suggested first stage solution of scen. %3d  (%g identical scen. sols) ", unind[i]+1, DDSIP_node[DDSIP_bb->curnode]->first_sol[unind[i]][DDSIP_bb->firstvar]);
-            memcpy (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[unind[i]], sizeof (double) * DDSIP_bb->firstvar);
+            memcpy (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[unind[i]], sizeof (double) * DDSIP_bb->firstvar);
 
             if (DDSIP_param->relax)
                 for (ii = 0; ii < DDSIP_bb->firstvar; ii++)
                     if (DDSIP_bb->firsttype[ii] == 'B' || DDSIP_bb->firsttype[ii] == 'I' || DDSIP_bb->firsttype[ii] == 'N')
-                        (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[ii] = floor (((DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[ii] + 0.5));
+                        (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[ii] = floor (((DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[ii] + 0.5));
 
             // Consistent?
             DDSIP_BoundConsistent ();
@@ -592,7 +672,7 @@ DDSIP_OneTenth (int nrScenarios, int feasCheckOnly)
                 {
                     worst_case_lb = DDSIP_Dmax((DDSIP_node[DDSIP_bb->curnode]->first_sol)[ii][DDSIP_bb->firstvar-1], worst_case_lb);
                 }
-                (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[DDSIP_bb->firstvar - 1] = worst_case_lb + DDSIP_param->accuracy;
+                (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[DDSIP_bb->firstvar - 1] = worst_case_lb + DDSIP_param->accuracy;
             }
 
             DDSIP_bb->from_scenario = unind[i];
@@ -614,16 +694,16 @@ DDSIP_OneTenth (int nrScenarios, int feasCheckOnly)
     }
 
     DDSIP_Free ((void **) &(unind));
-    if (DDSIP_bb->sug[DDSIP_param->nodelim + 2])
+    if (DDSIP_bb->sug[DDSIP_bb->nodecap])
     {
-        DDSIP_Free ((void **) &(DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval));
-        DDSIP_Free ((void **) &(DDSIP_bb->sug[DDSIP_param->nodelim + 2]));
+        DDSIP_Free ((void **) &(DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval));
+        DDSIP_Free ((void **) &(DDSIP_bb->sug[DDSIP_bb->nodecap]));
     }
 
     return 1;
 }
 
-// Function returns a suggestion in the first components of sug[DDSIP_param->nodelim + 2]
+// Function returns a suggestion in the first components of sug[DDSIP_bb->nodecap]
 int
 DDSIP_Heuristics (int *comb, int nrScenarios, int feasCheckOnly)
 {
@@ -632,7 +712,7 @@ DDSIP_Heuristics (int *comb, int nrScenarios, int feasCheckOnly)
 
     double *average = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "average(Heuristic)");
     double *average_eq = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "average_eq(Heuristic)");
-    tmp = DDSIP_bb->sug[DDSIP_param->nodelim + 2];
+    tmp = DDSIP_bb->sug[DDSIP_bb->nodecap];
     if (!tmp)
     {
         // DDSIP_Allocate memory for heuristics suggestion if there is none yet
@@ -640,13 +720,13 @@ DDSIP_Heuristics (int *comb, int nrScenarios, int feasCheckOnly)
         tmp->firstval = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "sug[i]->firstval(Heuristic)");
         for (i = 0; i < DDSIP_bb->firstvar; (tmp->firstval)[i++] = DDSIP_infty);
         tmp->next = NULL;
-        DDSIP_bb->sug[DDSIP_param->nodelim + 2] = tmp;
+        DDSIP_bb->sug[DDSIP_bb->nodecap] = tmp;
     }
     else
     {
         for (i = 0; i < DDSIP_bb->firstvar; (tmp->firstval)[i++] = DDSIP_infty);
         if (tmp->next != NULL)
-            printf("\n\n ERROR: !!!!!!!!!!!!!!!!!!!!! DDSIP_bb->sug[DDSIP_param->nodelim + 2]->next = %p\n\n",DDSIP_bb->sug[DDSIP_param->nodelim + 2]->next);
+            printf("\n\n ERROR: !!!!!!!!!!!!!!!!!!!!! DDSIP_bb->sug[DDSIP_bb->nodecap]->next = %p\n\n",DDSIP_bb->sug[DDSIP_bb->nodecap]->next);
         //tmp->next = NULL;
     }
     if (DDSIP_param->outlev)
@@ -788,14 +868,14 @@ DDSIP_Heuristics (int *comb, int nrScenarios, int feasCheckOnly)
 
     if (status)
         return status;
-    if (DDSIP_bb->sug[DDSIP_param->nodelim + 2])
+    if (DDSIP_bb->sug[DDSIP_bb->nodecap])
     {
         // round resulting values for integer first stage vars
         if (DDSIP_param->relax)
             for (i = 0; i < DDSIP_bb->firstvar; i++)
                 if (DDSIP_bb->firsttype[i] == 'I' || DDSIP_bb->firsttype[i] == 'B' || DDSIP_bb->firsttype[i] == 'N')
                 {
-                    (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[i] = floor (((DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[i] + .5));
+                    (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[i] = floor (((DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[i] + .5));
                 }
         // Consistent ?
         DDSIP_BoundConsistent ();
@@ -809,7 +889,7 @@ DDSIP_Heuristics (int *comb, int nrScenarios, int feasCheckOnly)
         {
             worst_case_lb = DDSIP_Dmax((DDSIP_node[DDSIP_bb->curnode]->first_sol)[i][DDSIP_bb->firstvar-1], worst_case_lb);
         }
-        (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[DDSIP_bb->firstvar - 1] = worst_case_lb + DDSIP_param->accuracy;
+        (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[DDSIP_bb->firstvar - 1] = worst_case_lb + DDSIP_param->accuracy;
     }
 
     return 0;
@@ -822,33 +902,33 @@ DDSIP_BoundConsistent (void)
 int i;
     for (i = 0; i < DDSIP_bb->firstvar; i++)
     {
-        if (((DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval[i] - DDSIP_bb->uborg[i])/(fabs(DDSIP_bb->uborg[i])+ 1.)) > 1.e-9)
+        if (((DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval[i] - DDSIP_bb->uborg[i])/(fabs(DDSIP_bb->uborg[i])+ 1.)) > 1.e-9)
         {
             printf ("   high suggestion for variable %d: sug=%20.18f ub=%20.18f, difference=%lg\n",i,
-                    (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[i],DDSIP_bb->uborg[i],(DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[i]-DDSIP_bb->uborg[i]);
+                    (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[i],DDSIP_bb->uborg[i],(DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[i]-DDSIP_bb->uborg[i]);
             if (DDSIP_param->outlev &&
-                (((DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval[i] - DDSIP_bb->uborg[i])/(fabs(DDSIP_bb->uborg[i])+ 1.e+2)) > DDSIP_param->accuracy))
+                (((DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval[i] - DDSIP_bb->uborg[i])/(fabs(DDSIP_bb->uborg[i])+ 1.e+2)) > DDSIP_param->accuracy))
             {
                 fprintf (DDSIP_bb->moreoutfile,"   high suggestion for variable %d: sug=%20.18f ub=%20.18f, difference=%lg\n",i,
-                         (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[i],DDSIP_bb->uborg[i],(DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[i]-DDSIP_bb->uborg[i]);
+                         (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[i],DDSIP_bb->uborg[i],(DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[i]-DDSIP_bb->uborg[i]);
             }
-            DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval[i] = DDSIP_bb->uborg[i];
+            DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval[i] = DDSIP_bb->uborg[i];
         }
-        if (((DDSIP_bb->lborg[i] - DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval[i])/(fabs(DDSIP_bb->lborg[i])+ 1.)) > 1.e-9)
+        if (((DDSIP_bb->lborg[i] - DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval[i])/(fabs(DDSIP_bb->lborg[i])+ 1.)) > 1.e-9)
         {
             // in the root node the lower bound for the additional variable for worst case costs was updated - emit no warning
             if (DDSIP_bb->curnode || !(i == DDSIP_data->firstvar && (abs(DDSIP_param->riskmod) != 4 || abs(DDSIP_param->riskmod) != 5)))
             {
                 printf ("   low suggestion for variable %d: sug=%16.8g lb=%16.8g, difference=%lg\n",i,
-                        (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[i],DDSIP_bb->lborg[i],(DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[i]-DDSIP_bb->lborg[i]);
+                        (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[i],DDSIP_bb->lborg[i],(DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[i]-DDSIP_bb->lborg[i]);
                 if (DDSIP_param->outlev &&
-                    (((DDSIP_bb->lborg[i] - DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval[i])/(fabs(DDSIP_bb->lborg[i])+ 1.e+2)) > DDSIP_param->accuracy))
+                    (((DDSIP_bb->lborg[i] - DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval[i])/(fabs(DDSIP_bb->lborg[i])+ 1.e+2)) > DDSIP_param->accuracy))
                 {
                     fprintf (DDSIP_bb->moreoutfile,"   low suggestion for variable %d: sug=%16.10g lb=%16.10g, difference=%lg\n",i,
-                             (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[i],DDSIP_bb->lborg[i],(DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[i]-DDSIP_bb->lborg[i]);
+                             (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[i],DDSIP_bb->lborg[i],(DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[i]-DDSIP_bb->lborg[i]);
                 }
             }
-            (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[i] = DDSIP_bb->lborg[i];
+            (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[i] = DDSIP_bb->lborg[i];
         }
     }
 } // end DDSIP_BoundConsistent
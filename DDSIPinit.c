@@ -29,90 +29,228 @@
 static int DDSIP_SortScen (void);
 
 //==========================================================================
-// Function sets cplex parameters, different parameters could be used in LB, UB etc.
-int
-DDSIP_SetCpxPara (const int cnt, const int * isdbl, const int * which, const double * what)
+// Parameters changed outside of the parameter sets (ADVIND, PREIND, CUTUP) or directly in the dual
+// method (TILIM, EPGAP), they are set in every call of DDSIP_SetCpxParaEnv
+static int
+DDSIP_CpxParaVolatile (int which)
 {
-    int i;
-    int status = 0;
+    return (which == CPX_PARAM_TILIM || which == CPX_PARAM_EPGAP || which == CPX_PARAM_ADVIND || which == CPX_PARAM_PREIND ||
+            which == CPX_PARAM_CUTUP);
+} // DDSIP_CpxParaVolatile
 
-    status = CPXsetdefaults (DDSIP_env);
-    if (status)
-    {
-        fprintf (stderr, "ERROR: Failed to set default parameters\n");
+//==========================================================================
+// Set one cplex parameter of the given type
+static int
+DDSIP_SetCpxParam (CPXENVptr env, const int isdbl, const int which, const double what)
+{
+    if (isdbl == 1)
+        return CPXsetdblparam (env, which, what);
+    else if (isdbl == 0)
+        return CPXsetintparam (env, which, (int) floor (what + 0.1));
+    else if (isdbl == 3)
+        return CPXsetlongparam (env, which, (long) floor (what + 0.1));
+    fprintf (stderr,"Error: unexpected parameter type for parameter %d\n", which);
+    return 1;
+} // DDSIP_SetCpxParam
+
+//==========================================================================
+// Set a cplex parameter to the value it has without section parameters:
+// kappa statistics, general section, minimal tolerances or CPLEX default
+static int
+DDSIP_SetCpxParaBase (CPXENVptr env, const int which)
+{
+    int i, type, status, idef, imin, imax;
+    double ddef, dmin, dmax;
+    CPXLONG ldef, lmin, lmax;
+
+    if (DDSIP_param->watchkappa && which == CPX_PARAM_MIPKAPPASTATS)
+        return CPXsetintparam (env, which, DDSIP_param->watchkappa);
+    for (i = DDSIP_param->cpxno - 1; i >= 0; i--)
+        if (DDSIP_param->cpxwhich[i] == which)
+            return DDSIP_SetCpxParam (env, DDSIP_param->cpxisdbl[i], which, DDSIP_param->cpxwhat[i]);
+    if (which == CPX_PARAM_EPRHS || which == CPX_PARAM_EPOPT)
+        return CPXsetdblparam (env, which, 1e-8);
+    if (which == CPX_PARAM_EPINT)
+        return CPXsetdblparam (env, which, 0.0);
+
+    if ((status = CPXgetparamtype (env, which, &type)))
         return status;
-    }
-    // if not changed by user, we require minimal feasibilty, optimality and integrality tolerances
-    if ((status = CPXsetdblparam (DDSIP_env, CPX_PARAM_EPRHS, 1e-8)))
+    if (type == CPX_PARAMTYPE_INT)
     {
-        fprintf (stderr, "ERROR: Failed to set minimal feasibility tolerance\n");
-        return status;
+        if (!(status = CPXinfointparam (env, which, &idef, &imin, &imax)))
+            status = CPXsetintparam (env, which, idef);
     }
-    if ((status = CPXsetdblparam (DDSIP_env, CPX_PARAM_EPOPT, 1e-8)))
+    else if (type == CPX_PARAMTYPE_DOUBLE)
     {
-        fprintf (stderr, "ERROR: Failed to set minimal optimality tolerance\n");
-        return status;
+        if (!(status = CPXinfodblparam (env, which, &ddef, &dmin, &dmax)))
+            status = CPXsetdblparam (env, which, ddef);
     }
-    if ((status = CPXsetdblparam (DDSIP_env, CPX_PARAM_EPINT, 0.0)))
+    else if (type == CPX_PARAMTYPE_LONG)
     {
-        fprintf (stderr, "ERROR: Failed to set minimal integrality tolerance\n");
-        return status;
+        if (!(status = CPXinfolongparam (env, which, &ldef, &lmin, &lmax)))
+            status = CPXsetlongparam (env, which, ldef);
     }
+    return status;
+} // DDSIP_SetCpxParaBase
+
+//==========================================================================
+// Function sets cplex parameters in the given environment, different parameters could be used in LB, UB etc.
+// state records the parameter set applied before: if it is known, only the parameters differing
+// between that set and the new one are changed (NULL: all parameters are set)
+int
+DDSIP_SetCpxParaEnv (CPXENVptr env, cpxstate_t *state, const int cnt, const int * isdbl, const int * which, const double * what)
+{
+    int i, j, k;
+    int status = 0;
 
-    if (which != DDSIP_param->cpxwhich)
+    if (state && state->valid)
     {
-        for (i = 0; i < DDSIP_param->cpxno; i++)
+        // Parameters of the previous set not contained in the new one
+        for (j = 0; j < state->cnt && !status; j++)
         {
-            if (DDSIP_param->cpxisdbl[i] == 1)
-                status = CPXsetdblparam (DDSIP_env, DDSIP_param->cpxwhich[i], DDSIP_param->cpxwhat[i]);
-            else if (DDSIP_param->cpxisdbl[i] == 0)
-                status = CPXsetintparam (DDSIP_env, DDSIP_param->cpxwhich[i], (int) floor (DDSIP_param->cpxwhat[i] + 0.1));
-            else if (DDSIP_param->cpxisdbl[i] == 3)
-                status = CPXsetlongparam (DDSIP_env, DDSIP_param->cpxwhich[i], (long) floor (DDSIP_param->cpxwhat[i] + 0.1));
-            else
+            for (i = 0; i < cnt && which[i] != state->which[j]; i++)
+                ;
+            if (i >= cnt && !DDSIP_CpxParaVolatile (state->which[j]))
+                status = DDSIP_SetCpxParaBase (env, state->which[j]);
+        }
+        // Parameters of the new set with a different value (the last occurrence counts)
+        for (i = 0; i < cnt && !status; i++)
+        {
+            for (k = i + 1; k < cnt && which[k] != which[i]; k++)
+                ;
+            if (k < cnt)
+                continue;
+            for (j = state->cnt - 1; j >= 0 && state->which[j] != which[i]; j--)
+                ;
+            if (j < 0 || state->isdbl[j] != isdbl[i] || state->what[j] != what[i] || DDSIP_CpxParaVolatile (which[i]) ||
+                    (DDSIP_param->watchkappa && which[i] == CPX_PARAM_MIPKAPPASTATS))
+                status = DDSIP_SetCpxParam (env, isdbl[i], which[i], what[i]);
+        }
+        // Parameters possibly changed elsewhere
+        for (k = 0; k < 5 && !status; k++)
+        {
+            j = (k == 0 ? CPX_PARAM_TILIM : (k == 1 ? CPX_PARAM_EPGAP : (k == 2 ? CPX_PARAM_ADVIND : (k == 3 ? CPX_PARAM_PREIND : CPX_PARAM_CUTUP))));
+            for (i = 0; i < cnt && which[i] != j; i++)
+                ;
+            if (i >= cnt)
+                status = DDSIP_SetCpxParaBase (env, j);
+        }
+        if (!status && DDSIP_param->watchkappa)
+            status = CPXsetintparam (env, CPX_PARAM_MIPKAPPASTATS, DDSIP_param->watchkappa);
+        if (status)
+        {
+            fprintf (stderr, "ERROR: Failed to change cplex parameters.\n");
+            state->valid = 0;
+            return status;
+        }
+    }
+    else
+    {
+        status = CPXsetdefaults (env);
+        if (status)
+        {
+            fprintf (stderr, "ERROR: Failed to set default parameters\n");
+            return status;
+        }
+        // if not changed by user, we require minimal feasibilty, optimality and integrality tolerances
+        if ((status = CPXsetdblparam (env, CPX_PARAM_EPRHS, 1e-8)))
+        {
+            fprintf (stderr, "ERROR: Failed to set minimal feasibility tolerance\n");
+            return status;
+        }
+        if ((status = CPXsetdblparam (env, CPX_PARAM_EPOPT, 1e-8)))
+        {
+            fprintf (stderr, "ERROR: Failed to set minimal optimality tolerance\n");
+            return status;
+        }
+        if ((status = CPXsetdblparam (env, CPX_PARAM_EPINT, 0.0)))
+        {
+            fprintf (stderr, "ERROR: Failed to set minimal integrality tolerance\n");
+            return status;
+        }
+
+        if (which != DDSIP_param->cpxwhich)
+        {
+            for (i = 0; i < DDSIP_param->cpxno; i++)
             {
-                fprintf (stderr,"Error: unexpected parameter type for parameter (general) %d\n", DDSIP_param->cpxwhich[i]);
-                status = 1;
+                status = DDSIP_SetCpxParam (env, DDSIP_param->cpxisdbl[i], DDSIP_param->cpxwhich[i], DDSIP_param->cpxwhat[i]);
+                if (status)
+                {
+                    fprintf (stderr, "ERROR: Failed to set cplex parameter %d (general).\n", DDSIP_param->cpxwhich[i]);
+                    return status;
+                }
             }
-
+        }
+        for (i = 0; i < cnt; i++)
+        {
+            status = DDSIP_SetCpxParam (env, isdbl[i], which[i], what[i]);
             if (status)
             {
-                fprintf (stderr, "ERROR: Failed to set cplex parameter %d (general).\n", DDSIP_param->cpxwhich[i]);
+                fprintf (stderr, "ERROR: Failed to set cplex parameter %d (section).\n", which[i]);
                 return status;
             }
         }
-    }
-    for (i = 0; i < cnt; i++)
-    {
-        if (isdbl[i] == 1)
-            status = CPXsetdblparam (DDSIP_env, which[i], what[i]);
-        else if (isdbl[i] == 0)
-            status = CPXsetintparam (DDSIP_env, which[i], (int) floor (what[i] + 0.1));
-        else if (isdbl[i] == 3)
-            status = CPXsetlongparam (DDSIP_env, which[i], (long) floor (what[i] + 0.1));
-        else
-        {
-            fprintf (stderr,"Error: unexpected parameter type for parameter (section) %d\n", which[i]);
-            status = 1;
-        }
-
-        if (status)
+        if (DDSIP_param->watchkappa)
         {
-            fprintf (stderr, "ERROR: Failed to set cplex parameter %d (section).\n", which[i]);
-            return status;
+            if ((status = CPXsetintparam (env, CPX_PARAM_MIPKAPPASTATS, DDSIP_param->watchkappa)))
+            {
+                fprintf (stderr, "ERROR: Failed to set kappastats\n");
+                return status;
+            }
         }
     }
-    if (DDSIP_param->watchkappa)
+
+    // Record the set (a copy, values of the sets are changed in the dual method)
+    if (state)
     {
-        if ((status = CPXsetintparam (DDSIP_env, CPX_PARAM_MIPKAPPASTATS, DDSIP_param->watchkappa)))
+        if (!state->which)
         {
-            fprintf (stderr, "ERROR: Failed to set kappastats\n");
-            return status;
+            state->isdbl = (int *) DDSIP_Alloc (sizeof (int), DDSIP_maxparam, "isdbl(SetCpxParaEnv)");
+            state->which = (int *) DDSIP_Alloc (sizeof (int), DDSIP_maxparam, "which(SetCpxParaEnv)");
+            state->what = (double *) DDSIP_Alloc (sizeof (double), DDSIP_maxparam, "what(SetCpxParaEnv)");
         }
+        state->valid = (cnt <= DDSIP_maxparam);
+        state->cnt = DDSIP_Imin (cnt, DDSIP_maxparam);
+        memcpy (state->isdbl, isdbl, state->cnt * sizeof (int));
+        memcpy (state->which, which, state->cnt * sizeof (int));
+        memcpy (state->what, what, state->cnt * sizeof (double));
     }
     return 0;
+} // DDSIP_SetCpxParaEnv
+
+//==========================================================================
+void
+DDSIP_FreeCpxState (cpxstate_t *state)
+{
+    DDSIP_Free ((void **) &(state->isdbl));
+    DDSIP_Free ((void **) &(state->which));
+    DDSIP_Free ((void **) &(state->what));
+    state->valid = state->cnt = 0;
+} // DDSIP_FreeCpxState
+
+//==========================================================================
+// Function sets cplex parameters, different parameters could be used in LB, UB etc.
+int
+DDSIP_SetCpxPara (const int cnt, const int * isdbl, const int * which, const double * what)
+{
+    return DDSIP_SetCpxParaEnv (DDSIP_env, &DDSIP_cpxstate, cnt, isdbl, which, what);
 } // DDSIP_SetCpxPara
 
+//==========================================================================
+// Set the objective cutoff for the next optimization if it is below the current one,
+// old returns the current value to be restored after the optimization
+int
+DDSIP_SetCpxCutoff (double cutoff, double *old)
+{
+    int status;
+
+    if ((status = CPXgetdblparam (DDSIP_env, CPX_PARAM_CUTUP, old)))
+        return status;
+    if (cutoff < *old)
+        status = CPXsetdblparam (DDSIP_env, CPX_PARAM_CUTUP, cutoff);
+    return status;
+} // DDSIP_SetCpxCutoff
+
 //==========================================================================
 // Produce some output
 int
@@ -279,59 +417,98 @@ DDSIP_InitCpxPara (void)
 } // DDSIP_InitCpxPara
 
 //==========================================================================
-// The function sorts the scenario according to a certain criteria
+// The function determines the order of the scenarios in lb_scen_order and ub_scen_order (PREPRO)
+// 1: ascending sum of the stochastic rhs entries
+// 2: nearest-neighbour tour through the scenario data, starting with the scenario of smallest sum.
+//    Consecutive scenarios differ in as few stochastic entries (rhs, costs, matrix) as possible,
+//    so DDSIP_ChgProb has to pass few changes to CPLEX.
 int
 DDSIP_SortScen (void)
 {
-    int i, j, chg;
-
-    double tmp;
+    int i, j, k, scen, next;
+    double dist, diff, mindist;
 
     double *sum = (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios,
                                           "sum(SortScen)");
+    int *order = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios,
+                                      "order(SortScen)");
+    char *done;
 
     if (DDSIP_param->outlev > 3)
-        fprintf (DDSIP_bb->moreoutfile, "Sorting scenarios according to sum of entries.\n");
+        fprintf (DDSIP_bb->moreoutfile, "Sorting scenarios according to %s.\n", DDSIP_param->prepro == 1 ? "sum of entries" : "differences of entries");
 
     // Sum of entries
     if (DDSIP_param->outlev > 7)
         fprintf (DDSIP_bb->moreoutfile, "\tOriginal Sums\n");
 
-    if (DDSIP_param->stocrhs)
+    for (i = 0; i < DDSIP_param->scenarios; i++)
     {
-        for (i = 0; i < DDSIP_param->scenarios; i++)
-        {
-            sum[i] = DDSIP_data->rhs[i * DDSIP_param->stocrhs];
-            for (j = 1; j < DDSIP_param->stocrhs; j++)
-                sum[i] += DDSIP_data->rhs[i * DDSIP_param->stocrhs + j];
-            if (DDSIP_param->outlev > 7)
-                fprintf (DDSIP_bb->moreoutfile, "\tSum(%d)=%2.2f\n", i, sum[i]);
-        }
+        order[i] = i;
+        sum[i] = 0.;
+        for (j = 0; j < DDSIP_param->stocrhs; j++)
+            sum[i] += DDSIP_data->rhs[i * DDSIP_param->stocrhs + j];
+        if (DDSIP_param->outlev > 7)
+            fprintf (DDSIP_bb->moreoutfile, "\tSum(%d)=%2.2f\n", i, sum[i]);
+    }
+    DDSIP_qsort_ins_A (sum, order, 0, DDSIP_param->scenarios - 1);
 
-        // Bubble sort
-        chg = 1;
-        while (chg)
+    if (DDSIP_param->prepro > 1)
+    {
+        done = (char *) DDSIP_Alloc (sizeof (char), DDSIP_param->scenarios, "done(SortScen)");
+        done[order[0]] = 1;
+        for (k = 1; k < DDSIP_param->scenarios; k++)
         {
-            chg = 0;
-            for (i = 0; i < DDSIP_param->scenarios - 1; i++)
-                if (sum[i] > sum[i + 1])
-                {
-                    tmp = sum[i];
-                    sum[i] = sum[i + 1];
-                    sum[i + 1] = tmp;
-
-                    for (j = 0; j < DDSIP_param->stocrhs; j++)
+            // The distance is the number of differing entries, ties are broken by the (scaled) sum of the differences
+            scen = order[k - 1];
+            next = -1;
+            mindist = DDSIP_infty;
+            for (i = 0; i < DDSIP_param->scenarios; i++)
+            {
+                if (done[i])
+                    continue;
+                dist = diff = 0.;
+                for (j = 0; j < DDSIP_param->stocrhs; j++)
+                    if (DDSIP_data->rhs[i * DDSIP_param->stocrhs + j] != DDSIP_data->rhs[scen * DDSIP_param->stocrhs + j])
+                    {
+                        dist += 1.;
+                        diff += fabs (DDSIP_data->rhs[i * DDSIP_param->stocrhs + j] - DDSIP_data->rhs[scen * DDSIP_param->stocrhs + j]);
+                    }
+                for (j = 0; j < DDSIP_param->stoccost; j++)
+                    if (DDSIP_data->cost[i * DDSIP_param->stoccost + j] != DDSIP_data->cost[scen * DDSIP_param->stoccost + j])
                     {
-                        tmp = DDSIP_data->rhs[i * DDSIP_param->stocrhs + j];
-                        DDSIP_data->rhs[i * DDSIP_param->stocrhs + j] = DDSIP_data->rhs[ (i + 1) * DDSIP_param->stocrhs + j];
-                        DDSIP_data->rhs[ (i + 1) * DDSIP_param->stocrhs + j] = tmp;
+                        dist += 1.;
+                        diff += fabs (DDSIP_data->cost[i * DDSIP_param->stoccost + j] - DDSIP_data->cost[scen * DDSIP_param->stoccost + j]);
                     }
-                    chg = 1;
+                for (j = 0; j < DDSIP_param->stocmat; j++)
+                    if (DDSIP_data->matval[i * DDSIP_param->stocmat + j] != DDSIP_data->matval[scen * DDSIP_param->stocmat + j])
+                    {
+                        dist += 1.;
+                        diff += fabs (DDSIP_data->matval[i * DDSIP_param->stocmat + j] - DDSIP_data->matval[scen * DDSIP_param->stocmat + j]);
+                    }
+                dist += diff / (1. + diff);
+                if (dist < mindist)
+                {
+                    mindist = dist;
+                    next = i;
                 }
+            }
+            order[k] = next;
+            done[next] = 1;
         }
+        DDSIP_Free ((void **) &(done));
+    }
+
+    for (i = 0; i < DDSIP_param->scenarios; i++)
+        DDSIP_bb->lb_scen_order[i] = DDSIP_bb->ub_scen_order[i] = order[i];
+    if (DDSIP_param->outlev > 7)
+    {
+        fprintf (DDSIP_bb->moreoutfile, "\tScenario order\n");
+        for (i = 0; i < DDSIP_param->scenarios; i++)
+            fprintf (DDSIP_bb->moreoutfile, "\t%4d: Scen %4d\n", i + 1, order[i] + 1);
     }
 
     DDSIP_Free ((void **) &(sum));
+    DDSIP_Free ((void **) &(order));
     return 0;
 } // DDSIP_SortScen
 
@@ -420,14 +597,18 @@ DDSIP_BbTypeInit (void)
 
     DDSIP_bb->lbident = (char *) DDSIP_Alloc (sizeof (char), DDSIP_bb->firstvar, "lbident(BbTypeInit)");
     DDSIP_bb->ubident = (char *) DDSIP_Alloc (sizeof (char), DDSIP_bb->firstvar, "ubident(BbTypeInit)");
-    j = (int) ceil (0.5 * DDSIP_param->nodelim) + 3;
+    j = (int) ceil (0.5 * DDSIP_bb->nodecap) + 3;
     DDSIP_bb->front = (int *) DDSIP_Alloc (sizeof (int), j, "front(BbTypeInit)");
+    DDSIP_bb->fheap[0] = (int *) DDSIP_Alloc (sizeof (int), j, "fheap[0](BbTypeInit)");
+    DDSIP_bb->fheap[1] = (int *) DDSIP_Alloc (sizeof (int), j, "fheap[1](BbTypeInit)");
+    DDSIP_bb->frontbuf = (int *) DDSIP_Alloc (sizeof (int), j, "frontbuf(BbTypeInit)");
 
     DDSIP_bb->bestsol = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "bestsol(BbTypeInit)");
     DDSIP_bb->lborg = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "lborg(BbTypeInit)");
     DDSIP_bb->uborg = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "uborg(BbTypeInit)");
 
     DDSIP_bb->objcontrib = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->novar, "objcontrib(BbTypeInit)");
+    DDSIP_bb->loaded = DDSIP_AllocLoaded ();
     DDSIP_bb->secstage = (double **) DDSIP_Alloc (sizeof (double *), DDSIP_param->scenarios, "secstage(BbTypeInit)");
     DDSIP_bb->cur_secstage = (double **) DDSIP_Alloc (sizeof (double *), DDSIP_param->scenarios, "cur_secstage(BbTypeInit)");
     for (i = 0; i < DDSIP_param->scenarios; i++)
@@ -436,6 +617,12 @@ DDSIP_BbTypeInit (void)
         DDSIP_bb->cur_secstage[i] = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->secvar, "cur_secstage[i](BbTypeInit)");
     }
     DDSIP_bb->subsol = (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios, "subsol(BbTypeInit)");
+    for (DDSIP_bb->firsthashsize = 16; DDSIP_bb->firsthashsize < 2 * DDSIP_param->scenarios; DDSIP_bb->firsthashsize *= 2)
+        ;
+    DDSIP_bb->firsthead = (int *) DDSIP_Alloc (sizeof (int), DDSIP_bb->firsthashsize, "firsthead(BbTypeInit)");
+    DDSIP_bb->firstent = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "firstent(BbTypeInit)");
+    DDSIP_bb->firstnext = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "firstnext(BbTypeInit)");
+    DDSIP_bb->firsthash = (unsigned int *) DDSIP_Alloc (sizeof (unsigned int), DDSIP_param->scenarios, "firsthash(BbTypeInit)");
 
     // Lower bounds in root node and upper bounds in best node are needed
     // to calculate best target
@@ -444,10 +631,34 @@ DDSIP_BbTypeInit (void)
     DDSIP_bb->curind = (int *) DDSIP_Alloc (sizeof (int), DDSIP_bb->firstvar, "curind(BbTypeInit)");
     DDSIP_bb->curlb = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "curlb(BbTypeInit)");
     DDSIP_bb->curub = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "curub(BbTypeInit)");
+    DDSIP_bb->curpos = (int *) DDSIP_Alloc (sizeof (int), DDSIP_bb->firstvar, "curpos(BbTypeInit)");
+    DDSIP_bb->curcnt = (int *) DDSIP_Alloc (sizeof (int), DDSIP_bb->firstvar, "curcnt(BbTypeInit)");
+    for (i = 0; i < DDSIP_bb->firstvar; i++)
+        DDSIP_bb->curpos[i] = -1;
+    DDSIP_bb->lplb = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "lplb(BbTypeInit)");
+    DDSIP_bb->lpub = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "lpub(BbTypeInit)");
 
-    DDSIP_bb->sug = (sug_t **) DDSIP_Alloc (sizeof (sug_t *), DDSIP_param->nodelim + 3, "sug(BbTypeInit)");
-    for (i = 0; i < DDSIP_param->nodelim + 2; i++)
+    DDSIP_bb->sug = (sug_t **) DDSIP_Alloc (sizeof (sug_t *), DDSIP_bb->nodecap + 1, "sug(BbTypeInit)");
+    for (i = 0; i < DDSIP_bb->nodecap; i++)
         DDSIP_bb->sug[i] = NULL;
+    DDSIP_bb->sughashsize = 1024;
+    DDSIP_bb->sugcnt = 0;
+    DDSIP_bb->sughead = (sug_t **) DDSIP_Alloc (sizeof (sug_t *), DDSIP_bb->sughashsize, "sughead(BbTypeInit)");
+    // as many suggestions as fit into DDSIP_ubcachemem, the arrays of an entry are allocated on first use
+    // (no cache if not even one fits)
+    DDSIP_bb->ubcachecap = DDSIP_Imin (64, DDSIP_ubcachemem / (DDSIP_param->scenarios * (DDSIP_bb->novar + 3)));
+    DDSIP_bb->ubcache = DDSIP_bb->ubcachefirst = DDSIP_bb->ubcachelast = NULL;
+    if (DDSIP_bb->ubcachecap > 0)
+    {
+        DDSIP_bb->ubcache = (ubcache_t *) DDSIP_Alloc (sizeof (ubcache_t), DDSIP_bb->ubcachecap, "ubcache(BbTypeInit)");
+        for (i = 0; i < DDSIP_bb->ubcachecap; i++)
+        {
+            DDSIP_bb->ubcache[i].prev = i ? DDSIP_bb->ubcache + i - 1 : NULL;
+            DDSIP_bb->ubcache[i].next = i < DDSIP_bb->ubcachecap - 1 ? DDSIP_bb->ubcache + i + 1 : NULL;
+        }
+        DDSIP_bb->ubcachefirst = DDSIP_bb->ubcache;
+        DDSIP_bb->ubcachelast = DDSIP_bb->ubcache + DDSIP_bb->ubcachecap - 1;
+    }
     //For Conic Bundle: space to save best scenario solutions
     if (DDSIP_param->cb)
         DDSIP_bb->bestfirst = (bestfirst_t *) DDSIP_Alloc (sizeof (bestfirst_t), DDSIP_param->scenarios, "bestfirst(BbTypeInit)");
@@ -476,12 +687,16 @@ DDSIP_BbTypeInit (void)
     DDSIP_bb->no_reduced_front = 1;
     DDSIP_bb->curnode = 0;
     DDSIP_bb->curbdcnt = 0;
+    DDSIP_bb->boundnode = -1;
+    DDSIP_bb->lpbdknown = 0;
 
     DDSIP_bb->lboutcnt = 1;
     DDSIP_bb->uboutcnt = 1;
     // The  depth of the b&b tree
     DDSIP_bb->depth = 1;
     DDSIP_bb->front[0] = 0;
+    DDSIP_bb->fheap[0][0] = DDSIP_bb->fheap[1][0] = 0;
+    DDSIP_bb->firstunsolved = 0;
 
     DDSIP_bb->cutoff = 0;
 
@@ -496,6 +711,29 @@ DDSIP_BbTypeInit (void)
             DDSIP_bb->dimdual = DDSIP_bb->firstvar * DDSIP_param->scenarios;
         else
             DDSIP_bb->dimdual = DDSIP_bb->firstvar * (DDSIP_param->scenarios - 1);
+        if (DDSIP_param->cbfunctions > 1)
+        {
+            DDSIP_bb->cbkey = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->cbfunctions, "cbkey(BbTypeInit)");
+            for (i = 0; i < DDSIP_param->cbfunctions; i++)
+                DDSIP_bb->cbkey[i] = i;
+            DDSIP_bb->cbpoint = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->dimdual, "cbpoint(BbTypeInit)");
+            DDSIP_bb->cbgroupobj = (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->cbfunctions, "cbgroupobj(BbTypeInit)");
+            DDSIP_bb->cbserved = (char *) DDSIP_Alloc (sizeof (char), DDSIP_param->cbfunctions, "cbserved(BbTypeInit)");
+        }
+        if (DDSIP_param->cbkeep > 0.)
+        {
+            DDSIP_bb->cbrefcost = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar * DDSIP_param->scenarios, "cbrefcost(BbTypeInit)");
+            DDSIP_bb->cbrefbound = (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios, "cbrefbound(BbTypeInit)");
+            DDSIP_bb->cbrefsubsol = (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios, "cbrefsubsol(BbTypeInit)");
+            DDSIP_bb->cbrefnode = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "cbrefnode(BbTypeInit)");
+            for (i = 0; i < DDSIP_param->scenarios; i++)
+                DDSIP_bb->cbrefnode[i] = -1;
+        }
+        if (DDSIP_param->cbreuse)
+        {
+            DDSIP_bb->cbsolmin = (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->cbfunctions * DDSIP_bb->firstvar, "cbsolmin(BbTypeInit)");
+            DDSIP_bb->cbsolmax = (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->cbfunctions * DDSIP_bb->firstvar, "cbsolmax(BbTypeInit)");
+        }
     }
 #endif
 
@@ -512,6 +750,8 @@ DDSIP_BbTypeInit (void)
     DDSIP_node[0]->dispnorm = DDSIP_infty;
     DDSIP_node[0]->leaf = 0;
     DDSIP_node[0]->cbReturn32 = 0;
+    DDSIP_node[0]->frontpos = 0;
+    DDSIP_node[0]->heappos[0] = DDSIP_node[0]->heappos[1] = 0;
 
     if (DDSIP_param->riskmod == 3)
         DDSIP_node[0]->target = -DDSIP_infty;
@@ -545,8 +785,10 @@ DDSIP_BbTypeInit (void)
     }
     DDSIP_bb->lb_sorted = 0;
     DDSIP_bb->ub_sorted = 0;
-    DDSIP_bb->front_nodes_sorted = (int *) DDSIP_Alloc (sizeof (int), 1, "DDSIP_bb->front_nodes_sorted(BbInit)");
+    DDSIP_bb->front_nodes_sorted = (int *) DDSIP_Alloc (sizeof (int), (int) ceil (0.5 * DDSIP_bb->nodecap) + 3, "DDSIP_bb->front_nodes_sorted(BbInit)");
     DDSIP_bb->front_nodes_sorted[0] = 0;
+    DDSIP_bb->nofrontsorted = 1;
+    DDSIP_bb->front_node_bound = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->nodecap, "DDSIP_bb->front_node_bound(BbInit)");
     DDSIP_bb->meanGapLB = DDSIP_bb->meanGapCBLB = DDSIP_bb->meanGapUB = 0.;
     DDSIP_bb->bestBound = DDSIP_bb->newTry = DDSIP_bb->cutCntr = DDSIP_bb->cutNumber = DDSIP_bb->cutAdded = 0;
     DDSIP_bb->bestsol_in_curnode = 1;
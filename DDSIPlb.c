@@ -33,6 +33,10 @@
 static int DDSIP_SkipUB (void);
 static int DDSIP_Warm (int);
 static int DDSIP_LowerBoundWriteLp (int);
+static void DDSIP_FirstHashAdd (int, unsigned int);
+static void DDSIP_FirstHashInit (void);
+static int DDSIP_FirstHashFind (double *, int);
+static void DDSIP_FirstHashDrop (int);
 
 
 //==========================================================================
@@ -1216,6 +1220,94 @@ DDSIP_LowerBoundWriteLp (int scen)
     return 0;
 } // DDSIP_LowerBoundWriteLp
 
+//==========================================================================
+// Enter the first-stage solution of scenario scen with the given hash value as a new one
+static void
+DDSIP_FirstHashAdd (int scen, unsigned int hash)
+{
+    int k = DDSIP_bb->firstcnt++;
+
+    DDSIP_bb->firstent[k] = scen;
+    DDSIP_bb->firsthash[k] = hash;
+    DDSIP_bb->firstnext[k] = DDSIP_bb->firsthead[hash & (DDSIP_bb->firsthashsize - 1)];
+    DDSIP_bb->firsthead[hash & (DDSIP_bb->firsthashsize - 1)] = k;
+} // DDSIP_FirstHashAdd
+
+//==========================================================================
+// Enter the distinct first-stage solutions already present in the current node (inherited ones)
+static void
+DDSIP_FirstHashInit (void)
+{
+    int k, scen;
+    unsigned int hash;
+
+    for (k = 0; k < DDSIP_bb->firsthashsize; k++)
+        DDSIP_bb->firsthead[k] = -1;
+    DDSIP_bb->firstcnt = 0;
+    for (scen = 0; scen < DDSIP_param->scenarios; scen++)
+    {
+        if (!(DDSIP_node[DDSIP_bb->curnode]->first_sol)[scen])
+            continue;
+        hash = DDSIP_FirstHash ((DDSIP_node[DDSIP_bb->curnode]->first_sol)[scen], NULL);
+        // Scenarios sharing the solution are represented by the first one
+        for (k = DDSIP_bb->firsthead[hash & (DDSIP_bb->firsthashsize - 1)]; k >= 0; k = DDSIP_bb->firstnext[k])
+            if ((DDSIP_node[DDSIP_bb->curnode]->first_sol)[DDSIP_bb->firstent[k]] == (DDSIP_node[DDSIP_bb->curnode]->first_sol)[scen])
+                break;
+        if (k < 0)
+            DDSIP_FirstHashAdd (scen, hash);
+    }
+} // DDSIP_FirstHashInit
+
+//==========================================================================
+// Find the scenario with least index whose first-stage solution equals the one in mipx.
+// If there is none, -1 is returned and the solution of scenario scen (to be stored by the caller) is entered.
+static int
+DDSIP_FirstHashFind (double *mipx, int scen)
+{
+    int j, k, kfound = -1, i_scen = -1;
+    unsigned int hash = DDSIP_FirstHash (mipx, DDSIP_bb->firstindex);
+
+    for (k = DDSIP_bb->firsthead[hash & (DDSIP_bb->firsthashsize - 1)]; k >= 0; k = DDSIP_bb->firstnext[k])
+    {
+        // An entry of scen itself would be a solution of an earlier solve (see DDSIP_FirstHashDrop)
+        if (DDSIP_bb->firsthash[k] != hash || DDSIP_bb->firstent[k] == scen || (i_scen >= 0 && DDSIP_bb->firstent[k] > i_scen))
+            continue;
+        for (j = 0; j < DDSIP_bb->firstvar; j++)
+        {
+            if (!DDSIP_Equal (mipx[DDSIP_bb->firstindex[j]], (DDSIP_node[DDSIP_bb->curnode]->first_sol)[DDSIP_bb->firstent[k]][j]))
+                break;
+        }
+        if (j >= DDSIP_bb->firstvar)
+        {
+            i_scen = DDSIP_bb->firstent[k];
+            kfound = k;
+        }
+    }
+    if (i_scen < 0)
+        DDSIP_FirstHashAdd (scen, hash);
+    else if (scen < i_scen)
+        // scen will share the solution, it represents it from now on
+        DDSIP_bb->firstent[kfound] = scen;
+    return i_scen;
+} // DDSIP_FirstHashFind
+
+//==========================================================================
+// Remove the solution of scenario scen entered last by DDSIP_FirstHashFind and release it, since the scenario
+// problem is solved again (scenario reevaluation after adding Benders cuts)
+static void
+DDSIP_FirstHashDrop (int scen)
+{
+    int k = DDSIP_bb->firstcnt - 1;
+
+    // The entry was added last, hence it is the head of its bucket
+    if (k >= 0 && DDSIP_bb->firstent[k] == scen)
+    {
+        DDSIP_bb->firsthead[DDSIP_bb->firsthash[k] & (DDSIP_bb->firsthashsize - 1)] = DDSIP_bb->firstnext[k];
+        DDSIP_bb->firstcnt--;
+    }
+    DDSIP_FirstSolRelease (&((DDSIP_node[DDSIP_bb->curnode]->first_sol)[scen]));
+} // DDSIP_FirstHashDrop
+
 //==========================================================================
 // Function solves scenario problems in b&b tree and calculates new bounds
 int
@@ -1231,6 +1323,7 @@ DDSIP_LowerBound (void)
     int wall_hrs, wall_mins,cpu_hrs, cpu_mins;
     int nodes_1st = -1, nodes_2nd = -1;
     int nrCuts;
+    int threadres = 0;
 
     int *indices = (int *) DDSIP_Alloc (sizeof (int), (DDSIP_bb->firstvar + DDSIP_bb->secvar),
                                         "indices (LowerBound)");
@@ -1243,7 +1336,7 @@ DDSIP_LowerBound (void)
     char *type = (char *) DDSIP_Alloc (sizeof (char), DDSIP_bb->firstvar, "type(LowerBound)");
     int    *ordind  = NULL;
     double *scensol = NULL;
-    double sumprob, maxdispersion, rest_bound, factor;
+    double sumprob, maxdispersion, rest_bound, factor, cutoff, oldcutoff;
     char **colname;
     char *colstore;
     sug_t *tmp;
@@ -1365,6 +1458,26 @@ DDSIP_LowerBound (void)
     //****************************************************************************
     maxGap = meanGap = 0.;
     nrCuts = DDSIP_bb->cutCntr;
+#ifdef CONIC_BUNDLE
+    // Lagrangean cost corrections of all scenarios for the multipliers of the node
+    if (DDSIP_param->cb && DDSIP_bb->multipliers)
+        DDSIP_LagrangeCost ();
+#endif
+    DDSIP_ThreadsRoundReset ();
+    // Solve the scenario problems concurrently, the results are processed in the loop below
+    if (DDSIP_param->threads > 1 && DDSIP_bb->DDSIP_step == solve && !relax && DDSIP_param->files < 3 && !DDSIP_param->watchkappa)
+    {
+        status = DDSIP_ThreadsLowerBound (rest_bound);
+        if (status)
+        {
+            fprintf (stderr, "ERROR: Failed to solve scenario problems concurrently (LowerBound) \n");
+            fprintf (DDSIP_outfile, "ERROR: Failed to solve scenario problems concurrently (LowerBound) \n");
+            if (DDSIP_param->outlev)
+                fprintf (DDSIP_bb->moreoutfile, "ERROR: Failed to solve scenario problems concurrently (LowerBound) \n");
+            goto TERMINATE;
+        }
+    }
+    DDSIP_FirstHashInit ();
     for (iscen = 0; iscen < DDSIP_param->scenarios; iscen++)
     {
         int nrFeasCheck = 0;
@@ -1530,6 +1643,31 @@ DDSIP_LowerBound (void)
         else
         {
             nodes_1st = nodes_2nd = -1;
+            // Has the problem been solved by a worker thread?
+            threadres = DDSIP_ThreadsLBResult (scen, mipx, &optstatus, &mipstatus, &objval, &bobjval, &nodes_1st, &nodes_2nd, &wr);
+            if (!threadres && (k = DDSIP_ThreadsLBStopped (&d)))
+            {
+                if (k > 0)
+                {
+                    // A worker thread found an infeasible scenario problem, handle it now
+                    scen = k - 1;
+                    for (iscen = 0; DDSIP_bb->lb_scen_order[iscen] != scen; iscen++)
+                        ;
+                    threadres = DDSIP_ThreadsLBResult (scen, mipx, &optstatus, &mipstatus, &objval, &bobjval, &nodes_1st, &nodes_2nd, &wr);
+                }
+                else
+                {
+                    // The worker threads stopped since the node can be fathomed
+                    DDSIP_node[DDSIP_bb->curnode]->bound = d;
+                    DDSIP_bb->skip = 2;
+                    if (DDSIP_param->outlev)
+                    {
+                        fprintf (DDSIP_bb->moreoutfile, "\tLower bound of node %d >= %18.16g (-bestvalue = %g) cutoff after evaluation of %d scenarios, skip=%d (threads)\n", DDSIP_bb->curnode, DDSIP_node[DDSIP_bb->curnode]->bound, DDSIP_node[DDSIP_bb->curnode]->bound - DDSIP_bb->bestvalue,iscen,DDSIP_bb->skip);
+                    }
+                    DDSIP_node[DDSIP_bb->curnode]->leaf = 1;
+                    goto TERMINATE;
+                }
+            }
             // Output
             if (DDSIP_param->outlev || DDSIP_param->cpxscr)
             {
@@ -1549,6 +1687,12 @@ NEXT_TRY:
                     fprintf (DDSIP_bb->moreoutfile, "ERROR: Failed to change problem \n");
                 goto TERMINATE;
             }
+            if (threadres)
+            {
+                DDSIP_bb->scenLBIters++;
+                time_start = DDSIP_GetCpuTime () - wr;
+                goto THREAD_RESULT;
+            }
 
             // Warm starts
             status = DDSIP_Warm (iscen);
@@ -1573,11 +1717,49 @@ NEXT_TRY:
                     printf ("   -- 1st optimization time limit: %gs, rel. gap: %g%% --\n",we,wr*100.0);
                 }
 #endif
+                // Objective cutoff: a value of the scenario problem above it would give rise to fathoming the node
+                cutoff = DDSIP_infty;
+                if (rest_bound > -DDSIP_infty && tmpbestbound < DDSIP_infty && DDSIP_bb->bestvalue < DDSIP_infty && !DDSIP_param->riskalg &&
+                    iscen < DDSIP_param->scenarios-1 && !DDSIP_param->scalarization && DDSIP_data->prob[scen] > 0.)
+                {
+                    factor = (DDSIP_bb->bestvalue < 0.)? 1.-2.e-15 :  1.+2.e-15;
+                    cutoff = (DDSIP_bb->bestvalue*factor - tmpbestbound - rest_bound) / DDSIP_data->prob[scen];
+                    if (DDSIP_SetCpxCutoff (cutoff, &oldcutoff) || cutoff >= oldcutoff)
+                        cutoff = DDSIP_infty;
+                }
                 // Optimize MIP
                 DDSIP_bb->scenLBIters++;
                 optstatus = CPXmipopt (DDSIP_env, DDSIP_lp);
                 mipstatus = CPXgetstat (DDSIP_env, DDSIP_lp);
                 nodes_1st = CPXgetnodecnt (DDSIP_env,DDSIP_lp);
+                if (cutoff < DDSIP_infty)
+                {
+                    CPXsetdblparam (DDSIP_env, CPX_PARAM_CUTUP, oldcutoff);
+                    if (!optstatus && mipstatus == CPXMIP_INFEASIBLE)
+                    {
+                        // No solution below the cutoff, the node can be fathomed
+                        DDSIP_node[DDSIP_bb->curnode]->bound = tmpbestbound + DDSIP_data->prob[scen] * cutoff + rest_bound;
+                        DDSIP_bb->skip = 2;
+                        if (DDSIP_param->outlev)
+                        {
+                            fprintf (DDSIP_bb->moreoutfile, "%4d Scenario %4.0d:  value above cutoff %-20.14g (n:%5d)\n", iscen + 1, scen + 1, cutoff, nodes_1st);
+                            fprintf (DDSIP_bb->moreoutfile, "\tLower bound of node %d >= %18.16g (-bestvalue = %g) cutoff after evaluation of %d scenarios, skip=%d\n", DDSIP_bb->curnode, DDSIP_node[DDSIP_bb->curnode]->bound, DDSIP_node[DDSIP_bb->curnode]->bound - DDSIP_bb->bestvalue,iscen+1,DDSIP_bb->skip);
+                        }
+                        DDSIP_node[DDSIP_bb->curnode]->leaf = 1;
+                        goto TERMINATE;
+                    }
+                    else if (!optstatus && (mipstatus == CPXMIP_TIME_LIM_INFEAS || mipstatus == CPXMIP_NODE_LIM_INFEAS || mipstatus == CPXMIP_MEM_LIM_INFEAS))
+                    {
+                        // A limit was reached before a solution below the cutoff was found, this gives no bound for fathoming
+                        // and no solution - solve again without the cutoff
+                        if (DDSIP_param->outlev)
+                            fprintf (DDSIP_bb->moreoutfile, "%4d Scenario %4.0d:  no solution below cutoff %-20.14g (n:%5d, Stat.%3.0d), solving again without cutoff\n", iscen + 1, scen + 1, cutoff, nodes_1st, mipstatus);
+                        DDSIP_bb->scenLBIters++;
+                        optstatus = CPXmipopt (DDSIP_env, DDSIP_lp);
+                        mipstatus = CPXgetstat (DDSIP_env, DDSIP_lp);
+                        nodes_1st = CPXgetnodecnt (DDSIP_env,DDSIP_lp);
+                    }
+                }
                 if (!optstatus && !DDSIP_Error(optstatus) && !DDSIP_Infeasible (mipstatus))
                 {
                     if (CPXgetmiprelgap(DDSIP_env, DDSIP_lp, &mipgap))
@@ -1757,6 +1939,7 @@ NEXT_TRY:
                 optstatus = CPXdualopt (DDSIP_env, DDSIP_lp);
                 mipstatus = CPXgetstat (DDSIP_env, DDSIP_lp);
             }
+THREAD_RESULT:
             // Infeasible, unbounded ... ?
             // We handle some errors separately (blatant infeasible, error in scenario problem)
             if (DDSIP_Error (optstatus))
@@ -1766,7 +1949,7 @@ NEXT_TRY:
                 if (DDSIP_param->outlev)
                     fprintf (DDSIP_bb->moreoutfile, "ERROR: Failed to optimize problem for scenario %d in node %d.(LowerBound) status=%d\n",
                              scen + 1, optstatus, DDSIP_bb->curnode);
-                if (optstatus == CPXERR_SUBPROB_SOLVE)
+                if (optstatus == CPXERR_SUBPROB_SOLVE && !threadres)
                 {
                     optstatus = CPXgetsubstat(DDSIP_env, DDSIP_lp);
                     fprintf (stderr, "ERROR:                                scenario %d.(LowerBound) subproblem status=%d\n", scen + 1, optstatus);
@@ -1828,8 +2011,11 @@ NEXT_TRY:
                 goto TERMINATE;
             }
             // We did not detect infeasibility
+            // The worker thread already fetched values and solution
+            if (threadres)
+                DDSIP_bb->solstat[scen] = !DDSIP_NoSolution (mipstatus);
             // If we couldn't find a feasible solution we can at least obtain a lower bound
-            if (DDSIP_NoSolution (mipstatus))
+            else if (DDSIP_NoSolution (mipstatus))
             {
                 objval = DDSIP_infty;
                 DDSIP_bb->solstat[scen] = 0;
@@ -2009,21 +2195,9 @@ NEXT_TRY:
             // If a feasible solution exists
             if (DDSIP_bb->solstat[scen])
             {
-                for (i_scen = 0; i_scen < DDSIP_param->scenarios; i_scen++)
-                {
-                    if ((DDSIP_node[DDSIP_bb->curnode]->first_sol)[i_scen])
-                    {
-                        for (j = 0; j < DDSIP_bb->firstvar; j++)
-                        {
-                            if (!DDSIP_Equal (mipx[DDSIP_bb->firstindex[j]], (DDSIP_node[DDSIP_bb->curnode]->first_sol)[i_scen][j]))
-                                break;
-                        }
-                        if (j >= DDSIP_bb->firstvar)
-                        {
-                            break;
-                        }
-                    }
-                }
+                // Look for an identical first-stage solution of another scenario
+                if ((i_scen = DDSIP_FirstHashFind (mipx, scen)) < 0)
+                    i_scen = DDSIP_param->scenarios;
                 if (i_scen < DDSIP_param->scenarios)
                 {
                     (DDSIP_node[DDSIP_bb->curnode]->first_sol)[scen] = (DDSIP_node[DDSIP_bb->curnode]->first_sol)[i_scen];
@@ -2120,25 +2294,25 @@ NEXT_TRY:
 		    if (DDSIP_param->addBendersCuts && (DDSIP_param->numberScenReeval > -1) && (DDSIP_bb->curnode < 9) && (j = DDSIP_bb->cutCntr))
 		    {
                         // check feasibility for other scenarios and possibly add cuts
-                        tmp = DDSIP_bb->sug[DDSIP_param->nodelim + 2];
+                        tmp = DDSIP_bb->sug[DDSIP_bb->nodecap];
                         if (!tmp)
                         {
                             // DDSIP_Allocate memory for heuristics suggestion if there is none yet
                             tmp = (sug_t *)DDSIP_Alloc (sizeof (sug_t), 1, "sug(LowerBound)");
                             tmp->firstval = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "sug->firstval(LowerBound)");
                             tmp->next = NULL;
-                            DDSIP_bb->sug[DDSIP_param->nodelim + 2] = tmp;
+                            DDSIP_bb->sug[DDSIP_bb->nodecap] = tmp;
                         }
                         else
                         {
                             if (tmp->next != NULL)
                             {
-                                printf("\n\n FEHLER: !!!!!!!!!!!!!!!!!!!!! DDSIP_bb->sug[DDSIP_param->nodelim + 2]->next = %p\n\n",DDSIP_bb->sug[DDSIP_param->nodelim + 2]->next);
+                                printf("\n\n FEHLER: !!!!!!!!!!!!!!!!!!!!! DDSIP_bb->sug[DDSIP_bb->nodecap]->next = %p\n\n",DDSIP_bb->sug[DDSIP_bb->nodecap]->next);
                                 exit (1);
                             }
                         }
          
-                        memcpy (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[scen], sizeof (double) * DDSIP_bb->firstvar);
+                        memcpy (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[scen], sizeof (double) * DDSIP_bb->firstvar);
          
                         if ((status = DDSIP_UpperBound (0, 2)))
                         {
@@ -2163,6 +2337,8 @@ NEXT_TRY:
                         {
                             if(DDSIP_param->outlev)
                                 fprintf (DDSIP_bb->moreoutfile, " --> scenario reevaluation %d\n", nrFeasCheck);
+                            DDSIP_FirstHashDrop (scen);
+                            threadres = 0;
                             goto NEXT_TRY;
                         }
                     }
@@ -2231,6 +2407,12 @@ NEXT_TRY:
     }				// end for iscen
     if ((j = DDSIP_bb->cutCntr - nrCuts))
         fprintf (DDSIP_outfile, " %6d%101d cuts\n", DDSIP_bb->curnode, j); 
+    // activity of the cuts at the scenario solutions, remove the ones inactive for long
+    if (DDSIP_bb->cutCntr)
+    {
+        DDSIP_CutPoolActivity (DDSIP_node[DDSIP_bb->curnode]->first_sol);
+        DDSIP_CutPoolAging ();
+    }
 
     if (DDSIP_bb->bestvalue < 0.)
     {
@@ -2250,7 +2432,9 @@ NEXT_TRY:
         {
             sort_array[DDSIP_bb->lb_scen_order[iscen]] = DDSIP_data->prob[DDSIP_bb->lb_scen_order[iscen]] * (DDSIP_node[DDSIP_bb->curnode]->subbound)[DDSIP_bb->lb_scen_order[iscen]];
         }
-        DDSIP_qsort_ins_D (sort_array, DDSIP_bb->lb_scen_order, 0, DDSIP_param->scenarios-1);
+        // an order given by PREPRO is kept
+        if (!DDSIP_param->prepro)
+            DDSIP_qsort_ins_D (sort_array, DDSIP_bb->lb_scen_order, 0, DDSIP_param->scenarios-1);
 
         if (DDSIP_param->outlev > 21)
         {
@@ -2640,13 +2824,13 @@ NEXT_TRY:
                     // there are non-zero multipliers
                     if (DDSIP_param->outlev > 3)
                     {
+#ifdef CONIC_BUNDLE
+                        // p_scen * lagcost is the column of H^T lambda, also for the implicit NONANT 3
+                        DDSIP_LagrangeCost ();
                         for (scen = 0; scen < DDSIP_param->scenarios; scen++)
                             for (i = 0; i < DDSIP_bb->firstvar; i++)
-                                for (j = DDSIP_data->nabeg[scen * DDSIP_bb->firstvar + i];
-                                        j < DDSIP_data->nabeg[scen * DDSIP_bb->firstvar + i] + DDSIP_data->nacnt[scen * DDSIP_bb->firstvar + i]; j++)
-                                {
-                                    lagr += DDSIP_data->naval[j] * DDSIP_node[DDSIP_bb->curnode]->dual[DDSIP_data->naind[j]] * (DDSIP_node[DDSIP_bb->curnode]->first_sol[scen])[i];
-                                }
+                                lagr += DDSIP_data->prob[scen] * DDSIP_bb->lagcost[scen * DDSIP_bb->firstvar + i] * (DDSIP_node[DDSIP_bb->curnode]->first_sol[scen])[i];
+#endif
                         fprintf (DDSIP_bb->moreoutfile,"        Objective value of solution = %.10g, Lagrangean part = %.10g\n",tmpbestvalue,lagr);
                         if (DDSIP_param->outlev > 29)
                         {
@@ -3354,11 +3538,12 @@ if (DDSIP_param->outlev > 21)
 TERMINATE:
 
     // Only if no errors, yet.
+    // The bounds of the node are kept, the next node changes only the differing ones
     if (!status)
     {
-        status = DDSIP_RestoreBoundAndType ();
+        status = DDSIP_RestoreType ();
         if (status)
-            fprintf (stderr, "ERROR: Failed to restore bounds \n");
+            fprintf (stderr, "ERROR: Failed to restore types \n");
     }
     DDSIP_Free ((void **) &(indices));
     DDSIP_Free ((void **) &(mipx));
@@ -3382,7 +3567,7 @@ DDSIP_CBLowerBound (double *objective_val, double relprec)
 #ifdef DEBUG
     double we, time_lap;
 #endif
-    //double cplexRelGap = 1.e-6;
+    double inexgap;
 
     int cnt, iscen, i_scen, j, k, k1, status = 0, optstatus, mipstatus, scen, relax = 0, increase = 9;
     int wall_hrs, wall_mins,cpu_hrs, cpu_mins;
@@ -3403,11 +3588,15 @@ DDSIP_CBLowerBound (double *objective_val, double relprec)
                        "maxfirst (CBLowerBound)");
     //    double *cb_scenrisk = (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios,
     //                                          "cb_scenrisk (CBLowerBound)");
+    int *first = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "first (CBLowerBound)");
+    int *next = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "next (CBLowerBound)");
     char *type = (char *) DDSIP_Alloc (sizeof (char), DDSIP_bb->firstvar, "type(CBLowerBound)");
     char **colname;
     char *colstore;
     int shift_in_cb = 0;
     int nrFeasCheck = 0;
+    int threadres = 0;
+    int keepIncr;
     sug_t *tmp;
 #ifdef CBHOTSTART 
 #ifdef SHIFT
@@ -3476,25 +3665,30 @@ DDSIP_CBLowerBound (double *objective_val, double relprec)
         goto TERMINATE;
     }
 
-    // assure that CPLEX relative gap is less or equal the relprec requested by ConicBundle
-    //   if ((status = CPXgetdblparam (DDSIP_env, CPX_PARAM_EPGAP, &cplexRelGap))) {
-    //     fprintf (stderr, "ERROR: Failed to get CPLEX parameter CPX_PARAM_EPGAP (CBLowerBound) \n");
-    //     fprintf (DDSIP_bb->moreoutfile, "ERROR: Failed to get CPLEX parameter CPX_PARAM_EPGAP (CBLowerBound) \n");
-    //   }
-    //   else {
-    //     if (cplexRelGap > relprec) {
-    //       if ((status = CPXsetdblparam (DDSIP_env, CPX_PARAM_EPGAP, relprec))) {
-    //         fprintf (stderr, "ERROR: Failed to set CPLEX parameter CPX_PARAM_EPGAP to %g (CBLowerBound) \n", relprec);
-    //         if (DDSIP_param->outlev)
-    //           fprintf (DDSIP_bb->moreoutfile, "ERROR: Failed to set CPLEX parameter CPX_PARAM_EPGAP to %g (CBLowerBound) \n", relprec);
-    //       }
-    //       else {
-    //         fprintf (stderr, " reset CPLEX parameter CPX_PARAM_EPGAP from %g to relprec=%g (CBLowerBound) \n", cplexRelGap, relprec);
-    //         if (DDSIP_param->outlev)
-    //           fprintf (DDSIP_bb->moreoutfile, " reset CPLEX parameter CPX_PARAM_EPGAP from %g to relprec=%g (CBLowerBound) \n", cplexRelGap, relprec);
-    //       }
-    //     }
-    //   }
+    // Inexact evaluation: the scenario problems are solved to a looser gap as long as ConicBundle asks for
+    // a low precision and the node bound is far from the best known value. The bounds stay valid since
+    // the best bounds of CPLEX are used, the gap shrinks with relprec and the distance near convergence.
+    inexgap = 0.;
+    if (DDSIP_param->cbinexact > 0. && !use_LB_params)
+    {
+        CPXgetdblparam (DDSIP_env, CPX_PARAM_EPGAP, &wr);
+        if (DDSIP_bb->bestvalue < DDSIP_infty && DDSIP_node[DDSIP_bb->curnode]->bound > -DDSIP_infty)
+            gap = (DDSIP_bb->bestvalue - DDSIP_node[DDSIP_bb->curnode]->bound) / (fabs (DDSIP_bb->bestvalue) + 1.e-10);
+        else
+            gap = 1.;
+        gap = DDSIP_Dmin (DDSIP_param->cbinexact, DDSIP_Dmax (relprec, 0.1 * gap));
+        if (gap > wr)
+        {
+            inexgap = gap;
+            if ((status = CPXsetdblparam (DDSIP_env, CPX_PARAM_EPGAP, inexgap)))
+            {
+                fprintf (stderr, "ERROR: Failed to set CPLEX parameter CPX_PARAM_EPGAP to %g (CBLowerBound) \n", inexgap);
+                goto TERMINATE;
+            }
+            if (DDSIP_param->outlev > 10)
+                fprintf (DDSIP_bb->moreoutfile, "   ## inexact evaluation: relative MIP gap %g (relprec %g)\n", inexgap, relprec);
+        }
+    }
 
     // Relax
     relax = 0;
@@ -3543,13 +3737,32 @@ DDSIP_CBLowerBound (double *objective_val, double relprec)
             return status;
         }
     }
+    // keep scenario solutions of the last point whose bound changes only slightly with the multipliers (CBKEEP),
+    // not in the repeated tries below
+    keepIncr = DDSIP_param->cbkeep > 0. && DDSIP_bb->dualitcnt && DDSIP_bb->multipliers && !DDSIP_param->scalarization;
 NEXT_TRY:
+    // a repeated try with the CPLEX parameters for LB is not inexact
+    if (use_LB_params && inexgap > 0.)
+    {
+        inexgap = 0.;
+        if ((status = DDSIP_SetCpxPara (DDSIP_param->cpxnolb, DDSIP_param->cpxlbisdbl, DDSIP_param->cpxlbwhich, DDSIP_param->cpxlbwhat)))
+            goto TERMINATE;
+    }
     // first take care of remains from former calls
     if (!DDSIP_param->cb_inherit || DDSIP_bb->dualitcnt || DDSIP_param->scalarization || DDSIP_bb->skip == 2)
     {
         int keepSolution, solKept = 0;
-        double lhs;
-        cutpool_t *currentCut;
+        int *cutind = NULL;
+        double *viol = NULL;
+        if (keepIncr)
+            DDSIP_LagrangeCost ();
+        if ((DDSIP_bb->keepSols || keepIncr) && DDSIP_bb->cutpool.cnt)
+        {
+            // check the scenario solutions for violated cuts
+            cutind = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "cutind(CBLowerBound)");
+            viol = (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios, "viol(CBLowerBound)");
+            DDSIP_CutPoolCheck (DDSIP_param->scenarios, DDSIP_node[DDSIP_bb->curnode]->first_sol, 1.e-7, 0., cutind, viol);
+        }
         for (iscen = 0; iscen < DDSIP_param->scenarios; iscen++)
         {
             if ((DDSIP_node[DDSIP_bb->curnode]->first_sol)[iscen] != NULL)
@@ -3559,26 +3772,11 @@ NEXT_TRY:
                     // we are repeating the initial dual evaluation
                     // check whether the scenario solution violates a cut
                     keepSolution = 1;
-                    if (DDSIP_bb->cutpool)
+                    if (cutind && cutind[iscen] >= 0)
                     {
-                        currentCut = DDSIP_bb->cutpool;
-                        while (currentCut)
-                        {
-                            lhs = 0.;
-                            for (int i = 0; i < DDSIP_bb->firstvar; i++)
-                            {
-                                lhs += (DDSIP_node[DDSIP_bb->curnode]->first_sol)[iscen][i] * currentCut->matval[i];
-                            }
-                            if (lhs < currentCut->rhs - 1.e-7)
-                            {
-                                
-                                if (DDSIP_param->outlev > 30)
-                                    fprintf (DDSIP_bb->moreoutfile, "sol. of scen. %d violates cut %d, violation %g.\n", iscen + 1, currentCut->number, currentCut->rhs - lhs);
-                                keepSolution = 0;
-                                break;
-                            }
-                            currentCut = currentCut->prev;
-                        }
+                        if (DDSIP_param->outlev > 30)
+                            fprintf (DDSIP_bb->moreoutfile, "sol. of scen. %d violates cut %d, violation %g.\n", iscen + 1, DDSIP_bb->cutpool.number[cutind[iscen]], viol[iscen]);
+                        keepSolution = 0;
                     }
                     if (keepSolution)
                     {
@@ -3593,30 +3791,73 @@ NEXT_TRY:
                         continue;
                     }
                 }
-                if ((cnt = (int) ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[iscen])[DDSIP_bb->firstvar] - 0.9)))
-                    for (k1 = iscen + 1; cnt && k1 < DDSIP_param->scenarios; k1++)
+                else if (keepIncr && DDSIP_bb->cbrefnode[iscen] == DDSIP_bb->curnode &&
+                         (DDSIP_node[DDSIP_bb->curnode]->first_sol)[iscen][DDSIP_bb->firstvar + 2] == DDSIP_bb->curnode &&
+                         !(cutind && cutind[iscen] >= 0))
+                {
+                    // The solution of the last solve stays feasible, its objective value changes by dc*x with the
+                    // change dc of the cost corrections. The bound of the last solve changes at least by min dc*x
+                    // over the first-stage bounds, the scenario is kept if the difference is small enough.
+                    double dc, lb, ub, dlow = 0., dup = 0.;
+                    for (j = 0; j < DDSIP_bb->firstvar; j++)
                     {
-                        if ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[iscen]) == (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[k1]))
+                        dc = DDSIP_bb->lagcost[iscen * DDSIP_bb->firstvar + j] - DDSIP_bb->cbrefcost[iscen * DDSIP_bb->firstvar + j];
+                        lb = DDSIP_bb->lpbdknown ? DDSIP_bb->lplb[j] : DDSIP_bb->lborg[j];
+                        ub = DDSIP_bb->lpbdknown ? DDSIP_bb->lpub[j] : DDSIP_bb->uborg[j];
+                        dlow += dc * (dc > 0. ? lb : ub);
+                        dup += dc * (DDSIP_node[DDSIP_bb->curnode]->first_sol)[iscen][j];
+                    }
+                    if (dup - dlow <= DDSIP_param->cbkeep * (fabs (DDSIP_bb->cbrefbound[iscen]) + 1.))
+                    {
+                        (DDSIP_node[DDSIP_bb->curnode]->subbound)[iscen] = DDSIP_bb->cbrefbound[iscen] + dlow;
+                        (DDSIP_node[DDSIP_bb->curnode]->cursubsol)[iscen] = DDSIP_bb->cbrefsubsol[iscen] + dup;
+                        if (DDSIP_param->outlev > 20)
                         {
-                            ((DDSIP_node[DDSIP_bb->curnode])->first_sol)[k1] = NULL;
-                            cnt--;
+                            if (solKept)
+                                fprintf (DDSIP_bb->moreoutfile, ", %d", iscen + 1);
+                            else
+                                fprintf (DDSIP_bb->moreoutfile, "   ## keeping sol. of scen. %d", iscen + 1);
                         }
+                        solKept++;
+                        continue;
                     }
-                DDSIP_Free ((void **) &(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[iscen]));
+                }
+                DDSIP_FirstSolRelease (&(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[iscen]));
             }
         }
         if (solKept && DDSIP_param->outlev > 20)
             fprintf (DDSIP_bb->moreoutfile, ".\n");
+        DDSIP_Free ((void **) &(cutind));
+        DDSIP_Free ((void **) &(viol));
     }
+    keepIncr = 0;
     // This node has been solved (as soon as we enter the loop below)
     DDSIP_node[DDSIP_bb->curnode]->solved = 1;
     DDSIP_bb->violations = DDSIP_bb->firstvar;
     tmpbestbound = 0.0;
     tmpupper     = 0.0;
     maxGap = meanGap = 0.0;
+    // Lagrangean cost corrections of all scenarios for the current multipliers
+    if (DDSIP_bb->multipliers)
+        DDSIP_LagrangeCost ();
+    DDSIP_ThreadsRoundReset ();
+    // Solve the scenario problems concurrently, the results are processed in the loop below
+    if (DDSIP_param->threads > 1 && !relax && DDSIP_param->files < 3 && !DDSIP_param->watchkappa)
+    {
+        status = DDSIP_ThreadsCBLowerBound (use_LB_params, inexgap);
+        if (status)
+        {
+            fprintf (stderr, "ERROR: Failed to solve scenario problems concurrently (CBLowerBound) \n");
+            fprintf (DDSIP_outfile, "ERROR: Failed to solve scenario problems concurrently (CBLowerBound) \n");
+            if (DDSIP_param->outlev)
+                fprintf (DDSIP_bb->moreoutfile, "ERROR: Failed to solve scenario problems concurrently (CBLowerBound) \n");
+            goto TERMINATE;
+        }
+    }
 
     // LowerBound problem for each scenario
     //****************************************************************************
+    DDSIP_FirstHashInit ();
     for (iscen = 0; iscen < DDSIP_param->scenarios; iscen++)
     {
         scen=DDSIP_bb->lb_scen_order[iscen];
@@ -3633,6 +3874,16 @@ NEXT_TRY:
         nodes_1st = nodes_2nd = -1;
         if ((DDSIP_node[DDSIP_bb->curnode]->first_sol)[scen] == NULL)
         {
+            // Has the problem been solved by a worker thread?
+            threadres = DDSIP_ThreadsLBResult (scen, mipx, &optstatus, &mipstatus, &objval, &bobjval, &nodes_1st, &nodes_2nd, &wr);
+            if (!threadres && (k = DDSIP_ThreadsLBStopped (&wr)) > 0)
+            {
+                // A worker thread found an infeasible scenario problem, handle it now
+                scen = k - 1;
+                for (iscen = 0; DDSIP_bb->lb_scen_order[iscen] != scen; iscen++)
+                    ;
+                threadres = DDSIP_ThreadsLBResult (scen, mipx, &optstatus, &mipstatus, &objval, &bobjval, &nodes_1st, &nodes_2nd, &wr);
+            }
             // Output
             if (DDSIP_param->outlev || DDSIP_param->cpxscr)
             {
@@ -3652,6 +3903,12 @@ NEXT_SCEN:
                     fprintf (DDSIP_bb->moreoutfile, "ERROR: Failed to change problem \n");
                 goto TERMINATE;
             }
+            if (threadres)
+            {
+                DDSIP_bb->scenCBIters++;
+                time_start = DDSIP_GetCpuTime () - wr;
+                goto THREAD_RESULT;
+            }
             // Warm starts
             // copy previous solution of the same scenario, if it exists
             if (DDSIP_param->hot)
@@ -3778,7 +4035,7 @@ NEXT_SCEN:
                         }
 #endif
                         // continue if desired gap is not reached yet
-                        if (mipgap > wr)
+                        if (mipgap > wr && mipgap > inexgap)
                         {
                             if(DDSIP_param->files > 4)
                             {
@@ -3875,6 +4132,8 @@ NEXT_SCEN:
                         }
                         // reset CPLEX parameters to lb
                         status = DDSIP_SetCpxPara (DDSIP_param->cpxnodual, DDSIP_param->cpxdualisdbl, DDSIP_param->cpxdualwhich, DDSIP_param->cpxdualwhat);
+                        if (!status && inexgap > 0.)
+                            status = CPXsetdblparam (DDSIP_env, CPX_PARAM_EPGAP, inexgap);
                         if (status)
                         {
                             fprintf (stderr, "ERROR: Failed to set CPLEX parameters (LowerBound) \n");
@@ -3897,6 +4156,7 @@ NEXT_SCEN:
                 optstatus = CPXdualopt (DDSIP_env, DDSIP_lp);
                 mipstatus = CPXgetstat (DDSIP_env, DDSIP_lp);
             }
+THREAD_RESULT:
 
             // We handle some errors separately (blatant infeasible, error in scenario problem)
             if (DDSIP_Error (optstatus))
@@ -3906,7 +4166,7 @@ NEXT_SCEN:
                 if (DDSIP_param->outlev)
                     fprintf (DDSIP_bb->moreoutfile, "WARNING: Failed to optimize problem for scenario %d in node %d.(CBLowerBound) status=%d\n",
                              scen + 1, DDSIP_bb->curnode, optstatus);
-                if (optstatus == CPXERR_SUBPROB_SOLVE)
+                if (optstatus == CPXERR_SUBPROB_SOLVE && !threadres)
                 {
                     optstatus = CPXgetsubstat(DDSIP_env, DDSIP_lp);
                     fprintf (stderr, "ERROR:                                scenario %d.(CBLowerBound) subproblem status=%d\n", scen + 1, optstatus);
@@ -3963,8 +4223,11 @@ NEXT_SCEN:
             else
             {
                 // We did not detect infeasibility
+                // The worker thread already fetched values and solution
+                if (threadres)
+                    DDSIP_bb->solstat[scen] = !DDSIP_NoSolution (mipstatus);
                 // If we couldn't find a feasible solution we can at least obtain a lower bound
-                if (DDSIP_NoSolution (mipstatus))
+                else if (DDSIP_NoSolution (mipstatus))
                 {
                     objval = DDSIP_infty;
                     DDSIP_bb->solstat[scen] = 0;
@@ -4168,6 +4431,17 @@ NEXT_SCEN:
             }
             wr = DDSIP_Dmin (bobjval, objval);
             (DDSIP_node[DDSIP_bb->curnode]->subbound)[scen] =  wr;
+            // reference for keeping the solution at the next points (CBKEEP)
+            if (DDSIP_param->cbkeep > 0.)
+            {
+                DDSIP_bb->cbrefbound[scen] = wr;
+                DDSIP_bb->cbrefsubsol[scen] = objval;
+                DDSIP_bb->cbrefnode[scen] = DDSIP_bb->curnode;
+                if (DDSIP_bb->multipliers)
+                    memcpy (DDSIP_bb->cbrefcost + scen * DDSIP_bb->firstvar, DDSIP_bb->lagcost + scen * DDSIP_bb->firstvar, sizeof (double) * DDSIP_bb->firstvar);
+                else
+                    memset (DDSIP_bb->cbrefcost + scen * DDSIP_bb->firstvar, '\0', sizeof (double) * DDSIP_bb->firstvar);
+            }
 
             // Wait-and-see lower bounds, should be set only once
             // Test if btlb contain still the initial value -DDSIP_infty
@@ -4183,25 +4457,9 @@ NEXT_SCEN:
                         DDSIP_bb->intsolvals[scen][j] = floor (mipx[DDSIP_bb->intind[j]] + 0.1);
                     }
                 }
-                for (i_scen = 0; i_scen < DDSIP_param->scenarios; i_scen++)
-                {
-                    if (i_scen == scen)
-                        continue;
-                    if ((DDSIP_node[DDSIP_bb->curnode]->first_sol)[i_scen])
-                    {
-                        for (j = 0; j < DDSIP_bb->firstvar; j++)
-                        {
-                            if (!DDSIP_Equal (mipx[DDSIP_bb->firstindex[j]], (DDSIP_node[DDSIP_bb->curnode]->first_sol)[i_scen][j]))
-                            {
-                                break;
-                            }
-                        }
-                        if (j >= DDSIP_bb->firstvar)
-                        {
-                            break;
-                        }
-                    }
-                }
+                // Look for an identical first-stage solution of another scenario
+                if ((i_scen = DDSIP_FirstHashFind (mipx, scen)) < 0)
+                    i_scen = DDSIP_param->scenarios;
                 if (i_scen < DDSIP_param->scenarios)
                 {
                     (DDSIP_node[DDSIP_bb->curnode]->first_sol)[scen] = (DDSIP_node[DDSIP_bb->curnode]->first_sol)[i_scen];
@@ -4255,25 +4513,25 @@ NEXT_SCEN:
 		    if (DDSIP_param->addBendersCuts && (DDSIP_param->numberScenReeval > -1) && ((!(DDSIP_bb->curnode) && (DDSIP_bb->dualdescitcnt < 3)) || ((DDSIP_bb->curnode < 11) && !DDSIP_bb->dualdescitcnt)) && (j = DDSIP_bb->cutCntr))
 		    {
                         // check feasibility for other scenarios and possibly add cuts
-                        tmp = DDSIP_bb->sug[DDSIP_param->nodelim + 2];
+                        tmp = DDSIP_bb->sug[DDSIP_bb->nodecap];
                         if (!tmp)
                         {
                             // DDSIP_Allocate memory for heuristics suggestion if there is none yet
                             tmp = (sug_t *)DDSIP_Alloc (sizeof (sug_t), 1, "sug(LowerBound)");
                             tmp->firstval = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "sug->firstval(LowerBound)");
                             tmp->next = NULL;
-                            DDSIP_bb->sug[DDSIP_param->nodelim + 2] = tmp;
+                            DDSIP_bb->sug[DDSIP_bb->nodecap] = tmp;
                         }
                         else
                         {
                             if (tmp->next != NULL)
                             {
-                                printf("\n\n FEHLER: !!!!!!!!!!!!!!!!!!!!! DDSIP_bb->sug[DDSIP_param->nodelim + 2]->next = %p\n\n",DDSIP_bb->sug[DDSIP_param->nodelim + 2]->next);
+                                printf("\n\n FEHLER: !!!!!!!!!!!!!!!!!!!!! DDSIP_bb->sug[DDSIP_bb->nodecap]->next = %p\n\n",DDSIP_bb->sug[DDSIP_bb->nodecap]->next);
                                 exit (1);
                             }
                         }
          
-                        memcpy (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[scen], sizeof (double) * DDSIP_bb->firstvar);
+                        memcpy (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval, (DDSIP_node[DDSIP_bb->curnode]->first_sol)[scen], sizeof (double) * DDSIP_bb->firstvar);
          
                         if ((status = DDSIP_UpperBound (0, 2)))
                         {
@@ -4298,6 +4556,8 @@ NEXT_SCEN:
                         {
                             if(DDSIP_param->outlev)
                                 fprintf (DDSIP_bb->moreoutfile, " --> scenario reevaluation %d\n", nrFeasCheck);
+                            DDSIP_FirstHashDrop (scen);
+                            threadres = 0;
                             goto NEXT_SCEN;
                         }
                     }
@@ -4563,21 +4823,11 @@ NEXT_SCEN:
         {
             if (DDSIP_bb->bestfirst[j].first_sol)
             {
-                if ((cnt = (int) (DDSIP_bb->bestfirst[j].first_sol[DDSIP_bb->firstvar] - 0.9)))
-                {
-                    for (k1 = j + 1; cnt && k1 < DDSIP_param->scenarios; k1++)
-                    {
-                        if (DDSIP_bb->bestfirst[j].first_sol == DDSIP_bb->bestfirst[k1].first_sol)
-                        {
-                            DDSIP_bb->bestfirst[k1].first_sol = NULL;
-                            cnt--;
-                        }
-                    }
-                }
-                DDSIP_Free ((void **) &(DDSIP_bb->bestfirst[j].first_sol));
+                DDSIP_FirstSolRelease (&(DDSIP_bb->bestfirst[j].first_sol));
             }
         }
-        // Save first stage in best point
+        // Save first stage in best point, one copy per group of scenarios sharing a solution
+        DDSIP_FirstSolGroups (DDSIP_node[DDSIP_bb->curnode]->first_sol, first, next);
         for (j = 0; j < DDSIP_param->scenarios; j++)
         {
 	    if (!DDSIP_node[DDSIP_bb->curnode]->first_sol[j])
@@ -4601,18 +4851,13 @@ NEXT_SCEN:
                     }
                     fprintf (DDSIP_bb->moreoutfile, "\n");
                 }
-                if ((cnt = (int) ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j])[DDSIP_bb->firstvar] - 0.9)))
-                    for (k1 = j + 1; cnt && k1 < DDSIP_param->scenarios; k1++)
-                    {
-                        if ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]) == (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[k1]))
-                        {
-                            DDSIP_bb->bestfirst[k1].first_sol = DDSIP_bb->bestfirst[j].first_sol;
-                            cnt--;
-                            if (DDSIP_param->outlev > 69)
-                                fprintf (DDSIP_bb->moreoutfile,
-                                         "       same solution for scenarios %d and %d, %d identical remaining.\n", j, k1 ,cnt);
-                        }
-                    }
+                for (k1 = next[j]; k1 >= 0; k1 = next[k1])
+                {
+                    DDSIP_bb->bestfirst[k1].first_sol = DDSIP_bb->bestfirst[j].first_sol;
+                    if (DDSIP_param->outlev > 69)
+                        fprintf (DDSIP_bb->moreoutfile,
+                                 "       same solution for scenarios %d and %d.\n", j, k1);
+                }
             }
             else
             {
@@ -4647,21 +4892,11 @@ NEXT_SCEN:
             {
                 if (DDSIP_bb->bestfirst[j].first_sol)
                 {
-                    if ((cnt = (int) (DDSIP_bb->bestfirst[j].first_sol[DDSIP_bb->firstvar] - 0.9)))
-                    {
-                        for (k1 = j + 1; cnt && k1 < DDSIP_param->scenarios; k1++)
-                        {
-                            if (DDSIP_bb->bestfirst[j].first_sol == DDSIP_bb->bestfirst[k1].first_sol)
-                            {
-                                DDSIP_bb->bestfirst[k1].first_sol = NULL;
-                                cnt--;
-                            }
-                        }
-                    }
-                    DDSIP_Free ((void **) &(DDSIP_bb->bestfirst[j].first_sol));
+                    DDSIP_FirstSolRelease (&(DDSIP_bb->bestfirst[j].first_sol));
                 }
             }
-            // Save first stage in best point
+            // Save first stage in best point, one copy per group of scenarios sharing a solution
+            DDSIP_FirstSolGroups (DDSIP_node[DDSIP_bb->curnode]->first_sol, first, next);
             for (j = 0; j < DDSIP_param->scenarios; j++)
             {
                 if (!DDSIP_bb->bestfirst[j].first_sol)
@@ -4680,18 +4915,13 @@ NEXT_SCEN:
                         }
                         fprintf (DDSIP_bb->moreoutfile, "\n");
                     }
-                    if ((cnt = (int) ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j])[DDSIP_bb->firstvar] - 0.9)))
-                        for (k1 = j + 1; cnt && k1 < DDSIP_param->scenarios; k1++)
-                        {
-                            if ((((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]) == (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[k1]))
-                            {
-                                DDSIP_bb->bestfirst[k1].first_sol = DDSIP_bb->bestfirst[j].first_sol;
-                                cnt--;
-                                if (DDSIP_param->outlev > 69)
-                                    fprintf (DDSIP_bb->moreoutfile,
-                                             "       same solution for scenarios %d and %d, %d identical remaining.\n", j, k1 ,cnt);
-                            }
-                        }
+                    for (k1 = next[j]; k1 >= 0; k1 = next[k1])
+                    {
+                        DDSIP_bb->bestfirst[k1].first_sol = DDSIP_bb->bestfirst[j].first_sol;
+                        if (DDSIP_param->outlev > 69)
+                            fprintf (DDSIP_bb->moreoutfile,
+                                     "       same solution for scenarios %d and %d.\n", j, k1);
+                    }
                 }
                 else
                 {
@@ -4896,18 +5126,7 @@ NEXT_SCEN:
             {
                 if (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j])
                 {
-                    if ((cnt = (int) (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j][DDSIP_bb->firstvar] - 0.9)))
-                    {
-                        for (k1 = j + 1; cnt && k1 < DDSIP_param->scenarios; k1++)
-                        {
-                            if (((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j] == ((DDSIP_node[DDSIP_bb->curnode])->first_sol)[k1])
-                            {
-                                ((DDSIP_node[DDSIP_bb->curnode])->first_sol)[k1] = NULL;
-                                cnt--;
-                            }
-                        }
-                    }
-                    DDSIP_Free ((void **) &(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]));
+                    DDSIP_FirstSolRelease (&(((DDSIP_node[DDSIP_bb->curnode])->first_sol)[j]));
                 }
             }
             // Copy first stage in best point to first_sol
@@ -5100,11 +5319,12 @@ NEXT_SCEN:
 TERMINATE:
 
     // Only if no errors, yet.
+    // The bounds of the node are kept for the next evaluation resp. node
     if (!status || status == -111)
     {
-        relax = DDSIP_RestoreBoundAndType ();
+        relax = DDSIP_RestoreType ();
         if (relax)
-            fprintf (stderr, "ERROR: Failed to restore bounds \n");
+            fprintf (stderr, "ERROR: Failed to restore types \n");
     }
     if (!status)
         DDSIP_bb->newTry = 0;
@@ -5113,6 +5333,8 @@ TERMINATE:
     DDSIP_Free ((void **) &(mipx));
     DDSIP_Free ((void **) &(minfirst));
     DDSIP_Free ((void **) &(maxfirst));
+    DDSIP_Free ((void **) &(first));
+    DDSIP_Free ((void **) &(next));
     DDSIP_Free ((void **) &(type));
     if (DDSIP_param->outlev > 11)
     {
@@ -32,6 +32,8 @@
 
 CPXENVptr    DDSIP_env = NULL;
 CPXLPptr     DDSIP_lp  = NULL;
+// Parameter set applied in DDSIP_env
+cpxstate_t   DDSIP_cpxstate = {0, 0, NULL, NULL, NULL};
 
 FILE      * DDSIP_outfile = NULL;
 
@@ -46,6 +48,12 @@ const int DDSIP_unique = 6;
 // Maximal number of parameters (in each CPLEX section)
 const int DDSIP_maxparam = 64;
 
+// Number of nodes allocated initially, the node array grows on demand
+const int DDSIP_nodeblock = 1024;
+
+// Number of doubles available for the cache of upper bound results (DDSIP_UBCacheGet)
+const int DDSIP_ubcachemem = 16777216;
+
 // Number of risk measures implemented
 const int DDSIP_maxrisk = 7;
 
@@ -272,7 +280,8 @@ main (int argc, char * argv[])
         fprintf (DDSIP_bb->moreoutfile, "--------------------------------------------------------------\n\n");
     }
 
-    DDSIP_node = (node_t **) DDSIP_Alloc (sizeof (node_t *), DDSIP_param->nodelim + 3, "node(Main)");
+    DDSIP_bb->nodecap = DDSIP_Imin (DDSIP_param->nodelim, DDSIP_nodeblock - 3) + 3;
+    DDSIP_node = (node_t **) DDSIP_Alloc (sizeof (node_t *), DDSIP_bb->nodecap, "node(Main)");
     DDSIP_node[0] = (node_t *) DDSIP_Alloc (sizeof (node_t), 1, "node[0](Main)");
     DDSIP_node[0]->first_sol = (double **) DDSIP_Alloc (sizeof (double *), DDSIP_param->scenarios, "node[0]->first_sol(Main)");
     DDSIP_node[0]->cursubsol = (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios, "node[0]->cursubsol(Main)");
@@ -380,12 +389,12 @@ main (int argc, char * argv[])
         if (DDSIP_param->advstart == 2)
         {
             DDSIP_bb->curnode = 0;
-            DDSIP_bb->sug[DDSIP_param->nodelim + 2] = (struct sug_l *)DDSIP_Alloc (sizeof (sug_t), 1, "sug[0](Advanced start solution)");
-            (DDSIP_bb->sug[DDSIP_param->nodelim + 2])->firstval =
+            DDSIP_bb->sug[DDSIP_bb->nodecap] = (struct sug_l *)DDSIP_Alloc (sizeof (sug_t), 1, "sug[0](Advanced start solution)");
+            (DDSIP_bb->sug[DDSIP_bb->nodecap])->firstval =
                 (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "sug[0]->firstval(adv start)");
             for (i = 0; i < (DDSIP_bb->firstvar); i++)
-                (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[i] = DDSIP_bb->adv_sol[i];
-            (DDSIP_bb->sug[DDSIP_param->nodelim + 2])->next = NULL;
+                (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[i] = DDSIP_bb->adv_sol[i];
+            (DDSIP_bb->sug[DDSIP_bb->nodecap])->next = NULL;
             if ((status = DDSIP_UpperBound (DDSIP_param->scenarios, 0)) && status < 100000)
                 goto TERMINATE;
         }
@@ -413,12 +422,12 @@ main (int argc, char * argv[])
         if (!status)
         {
             DDSIP_bb->curnode = 0;
-            DDSIP_bb->sug[DDSIP_param->nodelim + 2] = (struct sug_l *)DDSIP_Alloc (sizeof (sug_t), 1, "sug[0](Advanced start solution)");
-            DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval =
+            DDSIP_bb->sug[DDSIP_bb->nodecap] = (struct sug_l *)DDSIP_Alloc (sizeof (sug_t), 1, "sug[0](Advanced start solution)");
+            DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval =
                 (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "sug[i]->firstval(Heuristic)");
             for (i = 0; i < DDSIP_bb->firstvar; i++)
-                (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[i] = DDSIP_bb->adv_sol[i];
-            DDSIP_bb->sug[DDSIP_param->nodelim + 2]->next = NULL;
+                (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[i] = DDSIP_bb->adv_sol[i];
+            DDSIP_bb->sug[DDSIP_bb->nodecap]->next = NULL;
             if ((status = DDSIP_UpperBound (DDSIP_param->scenarios, 0)) && status < 100000)
                 goto TERMINATE;
         }
@@ -548,9 +557,8 @@ if((DDSIP_node[DDSIP_bb->curnode-1])->step == dual)
             boundstat = DDSIP_Bound ();
             if (!DDSIP_bb->curnode)
             {
-                int cnt, j;
-                double lhs;
-                cutpool_t *currentCut;
+                int *cutind = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "cutind(main)");
+                double *viol = (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios, "viol(main)");
                 DDSIP_PrintState (DDSIP_bb->noiter);
                 if (DDSIP_bb->cutAdded && DDSIP_param->outlev)
                 {
@@ -560,66 +568,37 @@ if((DDSIP_node[DDSIP_bb->curnode-1])->step == dual)
                 {
                     old_bound = DDSIP_node[0]->bound;
                     // Free the solutions from former LowerBound
+                    if (DDSIP_node[0]->step == solve)
+                        DDSIP_CutPoolCheck (DDSIP_param->scenarios, (DDSIP_node[0])->first_sol, 1.e-7, 0., cutind, viol);
                     for (i = 0; i < DDSIP_param->scenarios; i++)
                     {
                         if (((DDSIP_node[0])->first_sol)[i])
                         {
                             if (DDSIP_node[0]->step == solve)
                             {
-                                currentCut = DDSIP_bb->cutpool;
-                                while (currentCut)
+                                if (cutind[i] >= 0)
                                 {
-                                    lhs = 0.;
-                                    for (j = 0; j < DDSIP_bb->firstvar; j++)
-                                    {
-                                        lhs += (DDSIP_node[0])->first_sol[i][j] * currentCut->matval[j];
-                                    }
-                                    if (lhs < currentCut->rhs - 1.e-7)
-                                    {
 #ifdef DEBUG
-                                        if (DDSIP_param->outlev > 50)
-                                            fprintf (DDSIP_bb->moreoutfile, "scen %d solution violates cut %d.\n", i+1, currentCut->number);
+                                    if (DDSIP_param->outlev > 50)
+                                        fprintf (DDSIP_bb->moreoutfile, "scen %d solution violates cut %d.\n", i+1, DDSIP_bb->cutpool.number[cutind[i]]);
 #endif
-                                        if ((cnt = (int) ((((DDSIP_node[0])->first_sol)[i])[DDSIP_bb->firstvar] - 0.9)))
-                                        for (j = i + 1; cnt && j < DDSIP_param->scenarios; j++)
-                                        {
-                                            {
-                                                if (((DDSIP_node[0])->first_sol)[j]
-                                                  && ((DDSIP_node[0])->first_sol)[i] == ((DDSIP_node[0])->first_sol)[j])
-                                                {
-                                                    ((DDSIP_node[0])->first_sol)[j] = NULL;
-                                                    cnt--;
-                                                }
-                                            }
-                                        }
-                                        DDSIP_Free ((void **) &(((DDSIP_node[0])->first_sol)[i]));
-                                        break;
-                                    }
-                                    currentCut = currentCut->prev;
+                                    DDSIP_FirstSolRelease (&(((DDSIP_node[0])->first_sol)[i]));
                                 }
                             }
                             else
                             {
-                               if ((cnt = (int) ((((DDSIP_node[0])->first_sol)[i])[DDSIP_bb->firstvar] - 0.9)))
-                               for (j = i + 1; cnt && j < DDSIP_param->scenarios; j++)
-                               {
-                                   {
-                                       if (((DDSIP_node[0])->first_sol)[j]
-                                         && ((DDSIP_node[0])->first_sol)[i] == ((DDSIP_node[0])->first_sol)[j])
-                                       {
-                                           ((DDSIP_node[0])->first_sol)[j] = NULL;
-                                           cnt--;
-                                       }
-                                   }
-                               }
-                               DDSIP_Free ((void **) &(((DDSIP_node[0])->first_sol)[i]));
+                               DDSIP_FirstSolRelease (&(((DDSIP_node[0])->first_sol)[i]));
                             }
                         }
                     }
                     DDSIP_node[0]->step = DDSIP_bb->DDSIP_step = solve;
                     // status=1 means there was no solution found to a scenario problem
                     if ((status = DDSIP_LowerBound ()))
+                    {
+                        DDSIP_Free ((void **) &(cutind));
+                        DDSIP_Free ((void **) &(viol));
                         goto TERMINATE;
+                    }
                     DDSIP_bb->cutAdded = 0;
                     DDSIP_EvaluateScenarioSolutions (&comb);
                     cntr++;
@@ -634,8 +613,13 @@ if((DDSIP_node[DDSIP_bb->curnode-1])->step == dual)
                         (DDSIP_bb->bestvalue - DDSIP_node[0]->bound)/(fabs(DDSIP_bb->bestvalue) + 1e-16) < 0.5*DDSIP_param->relgap)
                         break;
                 }
+                DDSIP_Free ((void **) &(cutind));
+                DDSIP_Free ((void **) &(viol));
                 if (DDSIP_param->deleteRedundantCuts)
+                {
                     DDSIP_CheckRedundancy(1);
+                    DDSIP_DeleteRedundantCuts ();
+                }
             }
             else
             {
@@ -708,8 +692,13 @@ if((DDSIP_node[DDSIP_bb->curnode-1])->step == dual)
         if ((status = DDSIP_Branch ()))
             goto TERMINATE;
 
-        if (DDSIP_param->deleteRedundantCuts && !(DDSIP_bb->curnode % 10))
-            DDSIP_CheckRedundancy(1);
+        if (DDSIP_param->deleteRedundantCuts)
+        {
+            if (!(DDSIP_bb->curnode % 10))
+                DDSIP_CheckRedundancy(1);
+            // also the cuts found redundant within the dual method of the last node
+            DDSIP_DeleteRedundantCuts ();
+        }
     }
 
     // Termination
@@ -736,6 +725,11 @@ TERMINATE:
         DDSIP_Free ((void **) &(DDSIP_data));
     }
 
+    // Free up the problem copies and environments of the threads and the redundancy check problem
+    DDSIP_ThreadsFree ();
+    DDSIP_FreeRedundancy ();
+    DDSIP_FreeCpxState (&DDSIP_cpxstate);
+
     // Free up the problem as allocated by CPXcreateprob, if necessary
     if (DDSIP_lp != NULL)
     {
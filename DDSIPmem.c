@@ -24,6 +24,7 @@
 
 #include <DDSIP.h>
 #include <DDSIPconst.h>
+#include <stdint.h>
 
 //==========================================================================
 void
@@ -117,61 +118,143 @@ DDSIP_Alloc (int elsize, int nelem, const char *name)
 void
 DDSIP_FreeNode (int nono)
 {
-    int scen, j, cnt;
+    int scen;
     if (DDSIP_param->hot)
-        DDSIP_Free ((void **) &(DDSIP_node[nono]->solut));
+        DDSIP_PoolPut (pool_solut, (void **) &(DDSIP_node[nono]->solut));
     for (scen = 0; scen < DDSIP_param->scenarios; scen++)
-    {
-        if (((DDSIP_node[nono])->first_sol)[scen]
-                && (cnt = (int) ((((DDSIP_node[nono])->first_sol)[scen])[DDSIP_data->firstvar] - 0.9)))
-            for (j = scen + 1; cnt && j < DDSIP_param->scenarios; j++)
-            {
-                if (((DDSIP_node[nono])->first_sol)[j]
-                        && (((DDSIP_node[nono])->first_sol)[scen] == ((DDSIP_node[nono])->first_sol)[j]))
-                {
-                    ((DDSIP_node[nono])->first_sol)[j] = NULL;
-                    cnt--;
-                }
-            }
-        DDSIP_Free ((void **) &((DDSIP_node[nono]->first_sol)[scen]));
-    }
-    DDSIP_Free ((void **) &(DDSIP_node[nono]->first_sol));
-    DDSIP_Free ((void **) &(DDSIP_node[nono]->cursubsol));
-    DDSIP_Free ((void **) &(DDSIP_node[nono]->subbound));
-    DDSIP_Free ((void **) &(DDSIP_node[nono]->mipstatus));
-    DDSIP_Free ((void **) &(DDSIP_node[nono]->ref_scenobj));
+        DDSIP_FirstSolRelease (&((DDSIP_node[nono]->first_sol)[scen]));
+    // The arrays are kept for new nodes
+    DDSIP_PoolPut (pool_first_sol, (void **) &(DDSIP_node[nono]->first_sol));
+    DDSIP_PoolPut (pool_cursubsol, (void **) &(DDSIP_node[nono]->cursubsol));
+    DDSIP_PoolPut (pool_subbound, (void **) &(DDSIP_node[nono]->subbound));
+    DDSIP_PoolPut (pool_mipstatus, (void **) &(DDSIP_node[nono]->mipstatus));
+    DDSIP_PoolPut (pool_ref_scenobj, (void **) &(DDSIP_node[nono]->ref_scenobj));
     if (DDSIP_param->cb)
     {
-        DDSIP_Free ((void **) &(DDSIP_node[nono]->dual));
-        DDSIP_Free ((void **) &(DDSIP_node[nono]->scenBoundsNoLag));
+        DDSIP_PoolPut (pool_dual, (void **) &(DDSIP_node[nono]->dual));
+        DDSIP_PoolPut (pool_scenBoundsNoLag, (void **) &(DDSIP_node[nono]->scenBoundsNoLag));
     }
     // DDSIP_node itself is needed till the end for neoind, neolb, neoub !
 }
 
+//==========================================================================
+// Drop one reference to a first-stage solution (*ref of a scenario, in a node or in bestfirst).
+// The scenarios sharing a solution refer to the same array, first_sol[firstvar] counts them,
+// the array is freed with the last reference.
+void
+DDSIP_FirstSolRelease (double **ref)
+{
+    if (!*ref)
+        return;
+    if ((*ref)[DDSIP_bb->firstvar] > 1.5)
+    {
+        (*ref)[DDSIP_bb->firstvar] -= 1.0;
+        *ref = NULL;
+    }
+    else
+        DDSIP_Free ((void **) ref);
+}
+
+//==========================================================================
+// Group the scenarios sharing a first-stage solution in first_sol by the address of the solution:
+// first[scen] is the least scenario of the group (-1 without a solution), next[scen] the following one (-1 for the last)
+void
+DDSIP_FirstSolGroups (double **first_sol, int *first, int *next)
+{
+    int scen, k, mask = DDSIP_bb->firsthashsize - 1;
+    int *slot = (int *) DDSIP_Alloc (sizeof (int), DDSIP_bb->firsthashsize, "slot(FirstSolGroups)");
+    int *last = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "last(FirstSolGroups)");
+
+    for (k = 0; k <= mask; k++)
+        slot[k] = -1;
+    for (scen = 0; scen < DDSIP_param->scenarios; scen++)
+    {
+        next[scen] = -1;
+        if (!first_sol[scen])
+        {
+            first[scen] = -1;
+            continue;
+        }
+        // open addressing, the table has at least twice as many entries as there are scenarios
+        k = (int) ((((size_t) first_sol[scen] / sizeof (double)) * 2654435761u) & mask);
+        while (slot[k] >= 0 && first_sol[slot[k]] != first_sol[scen])
+            k = (k + 1) & mask;
+        if (slot[k] < 0)
+            slot[k] = first[scen] = last[scen] = scen;
+        else
+        {
+            first[scen] = slot[k];
+            next[last[slot[k]]] = scen;
+            last[slot[k]] = scen;
+        }
+    }
+    DDSIP_Free ((void **) &slot);
+    DDSIP_Free ((void **) &last);
+}
+
+//==========================================================================
+// Get an array of the given kind for a new node, a kept one if available
+// The arrays of one kind have the same size, the array is initialized with 0 like by DDSIP_Alloc
+void *
+DDSIP_PoolGet (int kind, int elsize, int nelem, const char *name)
+{
+    void *ptr;
+    pool_t *pool = DDSIP_bb->pool + kind;
+
+    if (!pool->cnt)
+        return DDSIP_Alloc (elsize, nelem, name);
+    ptr = pool->arr[--pool->cnt];
+    memset (ptr, 0, elsize * nelem);
+    return ptr;
+}
+
+//==========================================================================
+// Keep an array of a pruned or branched node for reuse, *ptr is set to NULL
+void
+DDSIP_PoolPut (int kind, void **ptr)
+{
+    void **arr;
+    pool_t *pool = DDSIP_bb->pool + kind;
+
+    if (!*ptr)
+        return;
+    if (pool->cnt == pool->max)
+    {
+        pool->max = DDSIP_Imax (2 * pool->max, 64);
+        arr = (void **) DDSIP_Alloc (sizeof (void *), pool->max, "arr(PoolPut)");
+        if (pool->cnt)
+            memcpy (arr, pool->arr, sizeof (void *) * pool->cnt);
+        DDSIP_Free ((void **) &(pool->arr));
+        pool->arr = arr;
+    }
+    pool->arr[pool->cnt++] = *ptr;
+    *ptr = NULL;
+}
+
+//==========================================================================
+void
+DDSIP_FreePool (void)
+{
+    int kind;
+
+    for (kind = 0; kind < pool_kinds; kind++)
+    {
+        while (DDSIP_bb->pool[kind].cnt)
+            DDSIP_Free ((void **) &(DDSIP_bb->pool[kind].arr[--DDSIP_bb->pool[kind].cnt]));
+        DDSIP_Free ((void **) &(DDSIP_bb->pool[kind].arr));
+        DDSIP_bb->pool[kind].max = 0;
+    }
+}
+
 //==========================================================================
 void
 DDSIP_FreeFrontNodes ()
 {
-    int i, j, scen, cnt;
+    int i;
     if (DDSIP_bb->nofront)
     {
         for (i = 0; i < DDSIP_bb->nofront; i++)
         {
-            for (scen = 0; scen < DDSIP_param->scenarios; scen++)
-            {
-                if (((DDSIP_node[DDSIP_bb->front[i]])->first_sol)[scen]
-                        && (cnt = (int) ((((DDSIP_node[DDSIP_bb->front[i]])->first_sol)[scen])[DDSIP_data->firstvar] - 0.9)))
-                    for (j = scen + 1; cnt && j < DDSIP_param->scenarios; j++)
-                    {
-                        if (((DDSIP_node[DDSIP_bb->front[i]])->first_sol)[j]
-                                && (((DDSIP_node[DDSIP_bb->front[i]])->first_sol)[scen] == ((DDSIP_node[DDSIP_bb->front[i]])->first_sol)[j]))
-                        {
-                            ((DDSIP_node[DDSIP_bb->front[i]])->first_sol)[j] = NULL;
-                            cnt--;
-                        }
-                    }
-                DDSIP_Free ((void **) &((DDSIP_node[DDSIP_bb->front[i]]->first_sol)[scen]));
-            }
             DDSIP_FreeNode (DDSIP_bb->front[i]);
             DDSIP_Free ((void **) &DDSIP_node[DDSIP_bb->front[i]]);
         }
@@ -224,6 +307,10 @@ DDSIP_FreeData ()
         DDSIP_Free ((void **) &(DDSIP_data->nacnt));
         DDSIP_Free ((void **) &(DDSIP_data->naind));
         DDSIP_Free ((void **) &(DDSIP_data->naval));
+        DDSIP_Free ((void **) &(DDSIP_data->naval_p));
+        DDSIP_Free ((void **) &(DDSIP_data->narbeg));
+        DDSIP_Free ((void **) &(DDSIP_data->narind));
+        DDSIP_Free ((void **) &(DDSIP_data->narval));
     }
 
     DDSIP_Free ((void **) &(DDSIP_data->prob));
@@ -235,14 +322,14 @@ DDSIP_FreeData ()
 void
 DDSIP_FreeBb ()
 {
-    int i, k1, cnt;
+    int i, k;
     sug_t *tmp, *next;
 
     if (DDSIP_bb != NULL)
     {
         if (DDSIP_bb->sug != NULL)
         {
-            for (i = 0; i < DDSIP_param->nodelim + 3; i++)
+            for (i = 0; i <= DDSIP_bb->nodecap; i++)
             {
                 tmp = (DDSIP_bb->sug)[i];
                 while (tmp)
@@ -255,8 +342,30 @@ DDSIP_FreeBb ()
             }
         }
         DDSIP_Free ((void **) &(DDSIP_bb->sug));
+        DDSIP_Free ((void **) &(DDSIP_bb->sughead));
+        if (DDSIP_bb->ubcache != NULL)
+        {
+            for (i = 0; i < DDSIP_bb->ubcachecap; i++)
+            {
+                if (DDSIP_bb->ubcache[i].mipx != NULL)
+                    for (k = 0; k < DDSIP_param->scenarios; k++)
+                        DDSIP_Free ((void **) &(DDSIP_bb->ubcache[i].mipx[k]));
+                DDSIP_Free ((void **) &(DDSIP_bb->ubcache[i].mipx));
+                DDSIP_Free ((void **) &(DDSIP_bb->ubcache[i].firstval));
+                DDSIP_Free ((void **) &(DDSIP_bb->ubcache[i].done));
+                DDSIP_Free ((void **) &(DDSIP_bb->ubcache[i].mipstatus));
+                DDSIP_Free ((void **) &(DDSIP_bb->ubcache[i].objval));
+                DDSIP_Free ((void **) &(DDSIP_bb->ubcache[i].bobjval));
+            }
+            DDSIP_Free ((void **) &(DDSIP_bb->ubcache));
+        }
+        DDSIP_FreePool ();
 
         DDSIP_Free ((void **) &(DDSIP_bb->subsol));
+        DDSIP_Free ((void **) &(DDSIP_bb->firsthead));
+        DDSIP_Free ((void **) &(DDSIP_bb->firstent));
+        DDSIP_Free ((void **) &(DDSIP_bb->firstnext));
+        DDSIP_Free ((void **) &(DDSIP_bb->firsthash));
 
         if (DDSIP_bb->secstage != NULL)
             for (i = 0; i < DDSIP_param->scenarios; i++)
@@ -271,7 +380,11 @@ DDSIP_FreeBb ()
         DDSIP_Free ((void **) &(DDSIP_bb->uborg));
         DDSIP_Free ((void **) &(DDSIP_bb->bestsol));
         DDSIP_Free ((void **) &(DDSIP_bb->front));
+        DDSIP_Free ((void **) &(DDSIP_bb->fheap[0]));
+        DDSIP_Free ((void **) &(DDSIP_bb->fheap[1]));
+        DDSIP_Free ((void **) &(DDSIP_bb->frontbuf));
         DDSIP_Free ((void **) &(DDSIP_bb->lbident));
+        DDSIP_FreeLoaded (&(DDSIP_bb->loaded));
         DDSIP_Free ((void **) &(DDSIP_bb->ubident));
         if (DDSIP_param->hot && DDSIP_param->hot != 2)
         {
@@ -290,32 +403,39 @@ DDSIP_FreeBb ()
             if (DDSIP_bb->bestfirst)
             {
                 for (i = 0; i < DDSIP_param->scenarios; i++)
-                {
-                    if ( DDSIP_bb->bestfirst[i].first_sol)
-                    {
-                        if ((cnt = (int) (DDSIP_bb->bestfirst[i].first_sol[DDSIP_bb->firstvar] - 0.9)))
-                        {
-                            for (k1 = i + 1; cnt && k1 < DDSIP_param->scenarios; k1++)
-                            {
-                                if (DDSIP_bb->bestfirst[i].first_sol == DDSIP_bb->bestfirst[k1].first_sol)
-                                {
-                                    DDSIP_bb->bestfirst[k1].first_sol = NULL;
-                                    cnt--;
-                                }
-                            }
-                        }
-                        DDSIP_Free ((void **) &(DDSIP_bb->bestfirst[i].first_sol));
-                    }
-                }
+                    DDSIP_FirstSolRelease (&(DDSIP_bb->bestfirst[i].first_sol));
                 DDSIP_Free ((void **) &(DDSIP_bb->bestfirst));
             }
             DDSIP_Free ((void **) &(DDSIP_bb->startinfo_multipliers));
+            DDSIP_Free ((void **) &(DDSIP_bb->lagcost));
+            DDSIP_Free ((void **) &(DDSIP_bb->lagdual));
             DDSIP_Free ((void **) &(DDSIP_bb->aggregate_time));
+            DDSIP_Free ((void **) &(DDSIP_bb->cbkey));
+            DDSIP_Free ((void **) &(DDSIP_bb->cbpoint));
+            DDSIP_Free ((void **) &(DDSIP_bb->cbgroupobj));
+            DDSIP_Free ((void **) &(DDSIP_bb->cbserved));
+            DDSIP_Free ((void **) &(DDSIP_bb->cbrefcost));
+            DDSIP_Free ((void **) &(DDSIP_bb->cbrefbound));
+            DDSIP_Free ((void **) &(DDSIP_bb->cbrefsubsol));
+            DDSIP_Free ((void **) &(DDSIP_bb->cbrefnode));
+            DDSIP_Free ((void **) &(DDSIP_bb->cbsolmin));
+            DDSIP_Free ((void **) &(DDSIP_bb->cbsolmax));
+#ifdef CONIC_BUNDLE
+            if (DDSIP_bb->cbkept)
+            {
+                cb_destruct_problem (&(DDSIP_bb->dualProblem));
+                DDSIP_bb->cbkept = 0;
+            }
+#endif
         }
 
         DDSIP_Free ((void **) &(DDSIP_bb->curind));
         DDSIP_Free ((void **) &(DDSIP_bb->curub));
         DDSIP_Free ((void **) &(DDSIP_bb->curlb));
+        DDSIP_Free ((void **) &(DDSIP_bb->curpos));
+        DDSIP_Free ((void **) &(DDSIP_bb->curcnt));
+        DDSIP_Free ((void **) &(DDSIP_bb->lplb));
+        DDSIP_Free ((void **) &(DDSIP_bb->lpub));
         DDSIP_Free ((void **) &(DDSIP_bb->firstindex));
         DDSIP_Free ((void **) &(DDSIP_bb->firstindex_reverse));
         DDSIP_Free ((void **) &(DDSIP_bb->secondindex));
@@ -357,6 +477,7 @@ DDSIP_FreeBb ()
         DDSIP_Free ((void **) &(DDSIP_bb->ub_scen_order));
         DDSIP_Free ((void **) &(DDSIP_bb->n_buffer));
         DDSIP_Free ((void **) &(DDSIP_bb->front_nodes_sorted));
+        DDSIP_Free ((void **) &(DDSIP_bb->front_node_bound));
         DDSIP_Free ((void **) &(DDSIP_bb->firstrowind));
         DDSIP_Free ((void **) &(DDSIP_bb->secondrowind));
         DDSIP_Free ((void **) &(DDSIP_bb->firstrowind_reverse));
@@ -448,14 +569,129 @@ DDSIP_FreeParam ()
 void
 DDSIP_FreeCutpool (void)
 {
-    cutpool_t *prev, *current;
-    current = DDSIP_bb->cutpool;
-    while (current)
+    cutpool_t *pool = &(DDSIP_bb->cutpool);
+
+    DDSIP_Free ((void **) &(pool->matstore));
+    DDSIP_Free ((void **) &(pool->rhs));
+    DDSIP_Free ((void **) &(pool->number));
+    DDSIP_Free ((void **) &(pool->Benders));
+    DDSIP_Free ((void **) &(pool->slack));
+    DDSIP_Free ((void **) &(pool->binding));
+    DDSIP_Free ((void **) &(pool->age));
+    pool->matval = NULL;
+    pool->cnt = pool->cap = 0;
+}
+
+//==========================================================================
+// Add a cut to the pool (it has to be the last row of DDSIP_lp, i.e. cut cutCntr - 1), the coefficients are copied
+void
+DDSIP_CutPoolAdd (const double *matval, double rhs, int number, int Benders)
+{
+    cutpool_t *pool = &(DDSIP_bb->cutpool);
+
+    if (pool->cnt == pool->cap)
     {
-        prev = current->prev;
-        DDSIP_Free ((void **) &(current->matval));
-        DDSIP_Free ((void **) &(current));
-        current = prev;
+        // double the storage, the rows are aligned to 32 bytes for the vectorized check in DDSIP_CutPoolCheck
+        int cap = pool->cap ? 2 * pool->cap : 64;
+        double *matstore = (double *) DDSIP_Alloc (sizeof (double), cap * ((DDSIP_bb->firstvar + 3) & ~3) + 4, "matstore(CutPoolAdd)");
+        double *rhs = (double *) DDSIP_Alloc (sizeof (double), cap, "rhs(CutPoolAdd)");
+        int *number = (int *) DDSIP_Alloc (sizeof (int), cap, "number(CutPoolAdd)");
+        int *Benders = (int *) DDSIP_Alloc (sizeof (int), cap, "Benders(CutPoolAdd)");
+        double *slack = (double *) DDSIP_Alloc (sizeof (double), cap, "slack(CutPoolAdd)");
+        int *binding = (int *) DDSIP_Alloc (sizeof (int), cap, "binding(CutPoolAdd)");
+        int *age = (int *) DDSIP_Alloc (sizeof (int), cap, "age(CutPoolAdd)");
+
+        pool->ld = (DDSIP_bb->firstvar + 3) & ~3;
+        if (pool->cnt)
+        {
+            memcpy ((double *) (((uintptr_t) matstore + 31) & ~(uintptr_t) 31), pool->matval, pool->cnt * pool->ld * sizeof (double));
+            memcpy (rhs, pool->rhs, pool->cnt * sizeof (double));
+            memcpy (number, pool->number, pool->cnt * sizeof (int));
+            memcpy (Benders, pool->Benders, pool->cnt * sizeof (int));
+            memcpy (slack, pool->slack, pool->cnt * sizeof (double));
+            memcpy (binding, pool->binding, pool->cnt * sizeof (int));
+            memcpy (age, pool->age, pool->cnt * sizeof (int));
+        }
+        DDSIP_Free ((void **) &(pool->matstore));
+        DDSIP_Free ((void **) &(pool->rhs));
+        DDSIP_Free ((void **) &(pool->number));
+        DDSIP_Free ((void **) &(pool->Benders));
+        DDSIP_Free ((void **) &(pool->slack));
+        DDSIP_Free ((void **) &(pool->binding));
+        DDSIP_Free ((void **) &(pool->age));
+        pool->matstore = matstore;
+        pool->matval = (double *) (((uintptr_t) matstore + 31) & ~(uintptr_t) 31);
+        pool->rhs = rhs;
+        pool->number = number;
+        pool->Benders = Benders;
+        pool->slack = slack;
+        pool->binding = binding;
+        pool->age = age;
+        pool->cap = cap;
     }
-    DDSIP_bb->cutpool = NULL;
-}
+    memcpy (pool->matval + pool->cnt * pool->ld, matval, DDSIP_bb->firstvar * sizeof (double));
+    pool->rhs[pool->cnt] = rhs;
+    pool->number[pool->cnt] = number;
+    pool->Benders[pool->cnt] = Benders;
+    pool->slack[pool->cnt] = 0.;
+    pool->binding[pool->cnt] = 0;
+    pool->age[pool->cnt] = 0;
+    pool->cnt++;
+    // cuts moved out of DDSIP_lp stay behind the ones in the problem
+    if (DDSIP_bb->cutCntr < pool->cnt)
+        DDSIP_CutPoolMove (pool->cnt - 1, DDSIP_bb->cutCntr - 1);
+} // DDSIP_CutPoolAdd
+
+//==========================================================================
+// Remove cut j from the pool, the following cuts move up like the rows of DDSIP_lp in CPXdelrows
+void
+DDSIP_CutPoolDel (int j)
+{
+    cutpool_t *pool = &(DDSIP_bb->cutpool);
+
+    memmove (pool->matval + j * pool->ld, pool->matval + (j + 1) * pool->ld, (pool->cnt - j - 1) * pool->ld * sizeof (double));
+    memmove (pool->rhs + j, pool->rhs + j + 1, (pool->cnt - j - 1) * sizeof (double));
+    memmove (pool->number + j, pool->number + j + 1, (pool->cnt - j - 1) * sizeof (int));
+    memmove (pool->Benders + j, pool->Benders + j + 1, (pool->cnt - j - 1) * sizeof (int));
+    memmove (pool->slack + j, pool->slack + j + 1, (pool->cnt - j - 1) * sizeof (double));
+    memmove (pool->binding + j, pool->binding + j + 1, (pool->cnt - j - 1) * sizeof (int));
+    memmove (pool->age + j, pool->age + j + 1, (pool->cnt - j - 1) * sizeof (int));
+    pool->cnt--;
+} // DDSIP_CutPoolDel
+
+//==========================================================================
+// Move cut from to position to, the cuts in between are shifted by one keeping their order
+void
+DDSIP_CutPoolMove (int from, int to)
+{
+    cutpool_t *pool = &(DDSIP_bb->cutpool);
+    int j = (from < to) ? from : to, n = (from < to) ? to - from : from - to, s = (from < to) ? 1 : 0, Benders, binding, age, number;
+    double rhs, slack, *row;
+
+    if (from == to)
+        return;
+    row = (double *) DDSIP_Alloc (sizeof (double), pool->ld, "row(CutPoolMove)");
+    memcpy (row, pool->matval + from * pool->ld, pool->ld * sizeof (double));
+    rhs = pool->rhs[from];
+    number = pool->number[from];
+    Benders = pool->Benders[from];
+    slack = pool->slack[from];
+    binding = pool->binding[from];
+    age = pool->age[from];
+    // from < to: the cuts from+1..to move up, otherwise to..from-1 move down
+    memmove (pool->matval + (j + 1 - s) * pool->ld, pool->matval + (j + s) * pool->ld, n * pool->ld * sizeof (double));
+    memmove (pool->rhs + j + 1 - s, pool->rhs + j + s, n * sizeof (double));
+    memmove (pool->number + j + 1 - s, pool->number + j + s, n * sizeof (int));
+    memmove (pool->Benders + j + 1 - s, pool->Benders + j + s, n * sizeof (int));
+    memmove (pool->slack + j + 1 - s, pool->slack + j + s, n * sizeof (double));
+    memmove (pool->binding + j + 1 - s, pool->binding + j + s, n * sizeof (int));
+    memmove (pool->age + j + 1 - s, pool->age + j + s, n * sizeof (int));
+    memcpy (pool->matval + to * pool->ld, row, pool->ld * sizeof (double));
+    pool->rhs[to] = rhs;
+    pool->number[to] = number;
+    pool->Benders[to] = Benders;
+    pool->slack[to] = slack;
+    pool->binding[to] = binding;
+    pool->age[to] = age;
+    DDSIP_Free ((void **) &(row));
+} // DDSIP_CutPoolMove
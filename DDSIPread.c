@@ -1242,6 +1242,8 @@ DDSIP_ReadSpec ()
     DDSIP_param->rgapsmall = (int) floor (DDSIP_ReadDbl (specfile, "TOLSMA", " HEUR SMALL RGAP ITERS", 16., 1, 1., 1.*DDSIP_param->period) + 0.1);
 
     DDSIP_param->watchkappa  = (int) floor (DDSIP_ReadDbl (specfile, "KAPPA", " GATHER KAPPA INFORMATION", 0., 1, 0., 2.) + 0.1);
+    DDSIP_param->threads     = (int) floor (DDSIP_ReadDbl (specfile, "THREAD", " NUMBER OF THREADS", 1., 1, 1., 256.) + 0.1);
+    DDSIP_param->threadnodes = (int) floor (DDSIP_ReadDbl (specfile, "THRNOD", " NUMBER OF NODES FOR THREADS", 0., 1, 0., 64.) + 0.1);
     DDSIP_param->relax       = (int) floor (DDSIP_ReadDbl (specfile, "RELAXL", " RELAXATION LEVEL", 0., 1, 0., DDSIP_bigint) + 0.1);
     DDSIP_param->noquant     = (int) floor (DDSIP_ReadDbl (specfile, "QUANTI", " NUMBER OF QUANTILES", 10., 1, 0., DDSIP_bigint) + 0.1);
     DDSIP_param->maxinherit = (int) floor (DDSIP_ReadDbl (specfile, "MAXINH", " MAX. LEVEL OF INHERITANCE", 5., 1, 0., 100000.) + 0.1);
@@ -1310,8 +1312,7 @@ DDSIP_ReadSpec ()
     {
         DDSIP_param->interrupt_heur = 0;
     }
-    //DDSIP_param->prepro = (int) floor (DDSIP_ReadDbl (specfile, "PREPRO", " PREPROCESSING", 0., 1, 0., 3.) + 0.1);
-    DDSIP_param->prepro = 0;
+    DDSIP_param->prepro = (int) floor (DDSIP_ReadDbl (specfile, "PREPRO", " SCENARIO ORDER", 0., 1, 0., 2.) + 0.1);
     DDSIP_param->annotationFile = DDSIP_ReadString (specfile, "ANNOTA", " ANNOTATION FILE FOR CPLEX BENDERS");
     fprintf (DDSIP_outfile, "\n");
 
@@ -1549,6 +1550,22 @@ DDSIP_ReadSpec ()
         DDSIP_param->cb_bestdualListLength= (int) floor (DDSIP_ReadDbl (specfile, "CBLIST", " CB BESTDUAL LIST LENGTH", 5., 1, 1., 50.) + 0.1);
         DDSIP_param->cb_test_line = (int) floor (DDSIP_ReadDbl (specfile, "CBLINE", " CB TEST LINE", 1., 1, 0., 1.) + 0.1);
         DDSIP_param->cb_cutnodes = (int) floor (DDSIP_ReadDbl (specfile, "CBCUTN", " CB CUTS UP TO NODE", 4., 1, 0., 100.) + 0.1);
+        DDSIP_param->cbfunctions = (int) floor (DDSIP_ReadDbl (specfile, "CBFUNC", " CB NUMBER OF FUNCTIONS", 1., 1, 1., 1.*DDSIP_param->scenarios) + 0.1);
+        if (DDSIP_param->cbfunctions > 1 && (DDSIP_param->riskmod || DDSIP_param->scalarization))
+        {
+            DDSIP_param->cbfunctions = 1;
+            printf ("     CBFUNCTIONS > 1 only for the expectation-based model, setting CBFUNCTIONS = 1.\n");
+            fprintf (DDSIP_outfile, "     CBFUNCTIONS > 1 only for the expectation-based model, setting CBFUNCTIONS = 1.\n");
+        }
+        DDSIP_param->cbkeep = DDSIP_ReadDbl (specfile, "CBKEEP", " CB KEEP SOLUTIONS TOLERANCE", 0., 0, 0., 1.);
+        DDSIP_param->cbinexact = DDSIP_ReadDbl (specfile, "CBINEX", " CB INEXACT MAX. MIP GAP", 0., 0, 0., 1.);
+        DDSIP_param->cbreuse = (int) floor (DDSIP_ReadDbl (specfile, "CBREUS", " CB REUSE PROBLEM", 0., 1, 0., 1.) + 0.1);
+        if (DDSIP_param->cbreuse && (DDSIP_param->riskmod || DDSIP_param->scalarization))
+        {
+            DDSIP_param->cbreuse = 0;
+            printf ("     CBREUSE only for the expectation-based model, setting CBREUSE = 0.\n");
+            fprintf (DDSIP_outfile, "     CBREUSE only for the expectation-based model, setting CBREUSE = 0.\n");
+        }
     }
 #else
     DDSIP_param->cb = 0;
@@ -1583,6 +1600,7 @@ DDSIP_ReadSpec ()
             DDSIP_param->deleteRedundantCuts = (int) floor (DDSIP_ReadDbl (specfile, "DELRED", " DELETE REDUNDANT CUTS", 1., 1, 0., 1.) + 0.1);
         else
             DDSIP_param->deleteRedundantCuts = 0;
+        DDSIP_param->cutAge = (int) floor (DDSIP_ReadDbl (specfile, "CUTAGE", " AGE OF INACTIVE CUTS IN LP", 0., 1, 0., DDSIP_bigint) + 0.1);
     }
     else
     {
@@ -1590,6 +1608,7 @@ DDSIP_ReadSpec ()
         DDSIP_param->deactivate_cuts= 0;
         DDSIP_param->redundancyCheck = 0;
         DDSIP_param->deleteRedundantCuts = 0;
+        DDSIP_param->cutAge = 0;
     }
     
     fprintf (DDSIP_outfile, "-----------------------------------------------------------\n");
@@ -1597,6 +1616,12 @@ DDSIP_ReadSpec ()
         DDSIP_param->prematureStop = 0;
     else
         DDSIP_param->prematureStop= (int) floor (DDSIP_ReadDbl (specfile, "PREMAT", " PREMATURE STOP in UpperBound", DDSIP_param->prematureStop, 1, 0., 1.) + 0.1);
+    if (DDSIP_param->riskmod)
+        DDSIP_param->ubsample = 0;
+    else
+        DDSIP_param->ubsample = (int) floor (DDSIP_ReadDbl (specfile, "UBSAMP", " SCENARIOS FOR SCREENING in UpperBound", 0., 1, 0., DDSIP_bigint) + 0.1);
+    if (DDSIP_param->ubsample)
+        DDSIP_param->ubconfidence = DDSIP_ReadDbl (specfile, "UBCONF", " CONFIDENCE OF SCREENING in UpperBound", 3., 0, 0., 100.);
 
     if (DDSIP_param->brancheps > DDSIP_param->nulldisp)
     {
@@ -2,8 +2,9 @@
  Copyright to:      University of Duisburg-Essen
     Language:          C
  Description:
- The procedure in this file builds a redundancy check problem
-        and checks the added cuts for redundancy
+ The procedures in this file keep a redundancy check problem
+        and check the added cuts for redundancy, and manage the
+        cuts moved out of the problem due to inactivity
 
  License:
  This file is part of DDSIP.
@@ -27,89 +28,57 @@
 #include <DDSIP.h>
 #include <DDSIPconst.h>
 
-void
-DDSIP_CheckRedundancy (int automatic)
-{
-    CPXLPptr redundancy;
-
-    int status, statusget, i, j, k, nzcnt_row, ranged = 0, beg, ind;
-    static int callNr = 1;
-    static int cutCnt = 1;
-    double *scaled_obj_coef = NULL;
-    char *sense = NULL, *sense_sorted = NULL;
-    char **scen_spec_rowname = NULL;
-    char **scen_spec_colname = NULL;
-    char **rowname = NULL, *rownamestore = NULL;
-    char **colname = NULL, *colnamestore = NULL;
-    int rowstorespace, rowsurplus;
-    int colstorespace, colsurplus;
-    char *string2 = NULL;
-    double *lb = NULL, *lb_sorted = NULL;
-    double *ub = NULL, *ub_sorted = NULL;
-    double *rng = NULL, *rng_sorted = NULL;
-    char *vartype_sorted = NULL;
-    int *colindex_sorted = NULL, *colindex_revers = NULL;
-    double *redundancy_rhs = NULL;
-    double *base_rhs = NULL;
-    int nzcnt=0, *rmatbeg=NULL, *rmatind=NULL, *rmatbeg_stage=NULL, *rmatind_stage=NULL, *rowindex=NULL;
-    double *rmatval=NULL, *rmatval_stage=NULL;
-    double time_start, time_end, objval;
-    char probname[50];
-    cutpool_t *currentCut, *previousCut;
-
-    if ((automatic && DDSIP_bb->cutNumber < cutCnt + 5) || (DDSIP_bb->cutCntr < 10))
-        return;
-    if (!DDSIP_bb->cutpool)
-    {
-        fprintf(DDSIP_outfile, "*ERROR: cut counter is %d, but cutpool is empty\n", DDSIP_bb->cutCntr);
-        return;
-    }
+// Redundancy check problem, kept between the calls of DDSIP_CheckRedundancy: the first-stage variables
+// with their original bounds, the first-stage constraints and for cut r (in the order of insertion)
+// the row firstcon + r   a^T x - s_r = rhs   with the slack column s_r = firstvar + r
+static CPXLPptr DDSIP_redlp = NULL;
+// cut numbers of the rows, number of cuts in the problem and length of DDSIP_rednumber
+static int *DDSIP_rednumber = NULL;
+static int DDSIP_redcnt = 0;
+static int DDSIP_redcap = 0;
+// incremented with each change of the rows or columns, the copies of the threads are renewed then
+static int DDSIP_redrevision = 0;
+// numbers of the cuts found redundant, deleted from DDSIP_lp and the pool by DDSIP_DeleteRedundantCuts
+static int *DDSIP_redpending = NULL;
+static int DDSIP_redpendcnt = 0;
+static int DDSIP_redpendcap = 0;
 
-    sprintf (probname, "sipout/redundancy%d.lp.gz", callNr);
-
-    time_start = DDSIP_GetCpuTime ();
+//==========================================================================
+// Build the redundancy check problem without cuts from the first-stage part of DDSIP_lp
+static int
+DDSIP_RedundancyBuild (void)
+{
+    int status, i, j, k, nzcnt = 0, nzcnt_row, rowsurplus, colsurplus, ranged = 0;
+    int rowstorespace = DDSIP_data->nocon * 255, colstorespace = DDSIP_data->novar * 255;
+    char *sense, *sense_sorted, **rowname, *rownamestore, **colname, *colnamestore, **scen_spec_name;
+    double *rhs, *rhs_sorted, *rng = NULL, *obj, *rmatval = NULL, *rmatval_stage = NULL;
+    int *rmatbeg, *rmatind = NULL, *rmatbeg_stage, *rmatind_stage = NULL, *rowindex;
 
-    colstorespace = (DDSIP_data->novar + DDSIP_bb->cutCntr) * 255;
-    rowstorespace = (DDSIP_data->nocon + DDSIP_bb->cutCntr) * 255;
-    if (!(sense = (char *) DDSIP_Alloc (sizeof (char), DDSIP_data->nocon, "sense(CheckRedundancy)")) ||
-            !(sense_sorted = (char *) DDSIP_Alloc (sizeof (char), DDSIP_Imax(DDSIP_data->firstcon,DDSIP_bb->cutCntr), "sense_sorted(CheckRedundancy)")) ||
-            !(base_rhs = (double *) DDSIP_Alloc(sizeof(double),DDSIP_data->nocon,"base_rhs(CheckRedundancy)")) ||
-            !(redundancy_rhs = (double *) DDSIP_Alloc(sizeof(double),DDSIP_Imax(DDSIP_data->firstcon, DDSIP_bb->cutCntr),"redundancy_rhs(CheckRedundancy)")) ||
-            !(scaled_obj_coef = (double *) DDSIP_Alloc (sizeof (double), DDSIP_Imax(DDSIP_data->firstvar, DDSIP_bb->cutCntr), "scaled_obj_coef(CheckRedundancy)")) ||
-            !(colname = (char **) DDSIP_Alloc (sizeof (char *), DDSIP_Imax(DDSIP_data->novar, DDSIP_bb->cutCntr),"colname(CheckRedundancy)")) ||
-            !(scen_spec_colname = (char **) DDSIP_Alloc (sizeof (char *), DDSIP_Imax(DDSIP_data->firstvar,DDSIP_bb->cutCntr), "scen_spec_colname(CheckRedundancy)")) ||
-            !(colnamestore = (char *) DDSIP_Alloc (sizeof (char), colstorespace, "colnamestore(CheckRedundancy)")) ||
-            !(rowname = (char **) DDSIP_Alloc (sizeof (char *), DDSIP_data->nocon + DDSIP_bb->cutCntr, "rowname(DetrEqu)")) ||
-            !(scen_spec_rowname = (char **) DDSIP_Alloc (sizeof (char *), DDSIP_Imax(DDSIP_data->firstcon,DDSIP_bb->cutCntr), "scen_spec_rowname(CheckRedundancy)")) ||
-            !(rownamestore = (char *) DDSIP_Alloc (sizeof (char), rowstorespace, "rownamestore(CheckRedundancy)")) ||
-            !(lb = (double *) DDSIP_Alloc (sizeof (double), DDSIP_data->novar, "lb(CheckRedundancy)")) ||
-            !(lb_sorted = (double *) DDSIP_Alloc (sizeof (double), DDSIP_Imax(DDSIP_data->firstvar,DDSIP_bb->cutCntr), "lb_sorted(CheckRedundancy)")) ||
-            !(ub = (double *) DDSIP_Alloc (sizeof (double), DDSIP_data->novar, "ub(CheckRedundancy)")) ||
-            !(ub_sorted = (double *) DDSIP_Alloc (sizeof (double), DDSIP_Imax(DDSIP_data->firstvar,DDSIP_bb->cutCntr), "ub_sorted(CheckRedundancy)")) ||
-            !(vartype_sorted = (char *) DDSIP_Alloc (sizeof (double), DDSIP_Imax(DDSIP_data->firstvar,DDSIP_bb->cutCntr), "vartype_sorted(CheckRedundancy)")) ||
-            !(colindex_sorted = (int *) DDSIP_Alloc (sizeof (int), DDSIP_data->novar, "colindex_sorted(CheckRedundancy)")) ||
-            !(rowindex = (int *) DDSIP_Alloc (sizeof (int), DDSIP_data->firstcon, "rowindex(CheckRedundancy)")))
-    {
-        fprintf (stderr, "Not enough memory for building redundancy check problem\n");
-        goto FREE;
-    }
+    sense = (char *) DDSIP_Alloc (sizeof (char), DDSIP_data->nocon, "sense(RedundancyBuild)");
+    sense_sorted = (char *) DDSIP_Alloc (sizeof (char), DDSIP_data->firstcon + 1, "sense_sorted(RedundancyBuild)");
+    rhs = (double *) DDSIP_Alloc (sizeof (double), DDSIP_data->nocon, "rhs(RedundancyBuild)");
+    rhs_sorted = (double *) DDSIP_Alloc (sizeof (double), DDSIP_data->firstcon + 1, "rhs_sorted(RedundancyBuild)");
+    rowname = (char **) DDSIP_Alloc (sizeof (char *), DDSIP_data->nocon, "rowname(RedundancyBuild)");
+    rownamestore = (char *) DDSIP_Alloc (sizeof (char), rowstorespace, "rownamestore(RedundancyBuild)");
+    colname = (char **) DDSIP_Alloc (sizeof (char *), DDSIP_data->novar, "colname(RedundancyBuild)");
+    colnamestore = (char *) DDSIP_Alloc (sizeof (char), colstorespace, "colnamestore(RedundancyBuild)");
+    scen_spec_name = (char **) DDSIP_Alloc (sizeof (char *), DDSIP_Imax (DDSIP_data->firstvar, DDSIP_data->firstcon) + 1, "scen_spec_name(RedundancyBuild)");
+    obj = (double *) DDSIP_Alloc (sizeof (double), DDSIP_data->firstvar, "obj(RedundancyBuild)");
+    rmatbeg = (int *) DDSIP_Alloc (sizeof (int), DDSIP_data->nocon, "rmatbeg(RedundancyBuild)");
+    rmatbeg_stage = (int *) DDSIP_Alloc (sizeof (int), DDSIP_data->firstcon + 1, "rmatbeg_stage(RedundancyBuild)");
+    rowindex = (int *) DDSIP_Alloc (sizeof (int), DDSIP_data->firstcon + 1, "rowindex(RedundancyBuild)");
 
     // get problem data
-    /*____________________________________________________________________________________*/
-    if((status = CPXgetcolname (DDSIP_env, DDSIP_lp, colname, colnamestore,
-                                colstorespace, &colsurplus, 0, DDSIP_data->novar - 1)) ||
-            (status = CPXgetrowname (DDSIP_env, DDSIP_lp, rowname, rownamestore,
-                                     rowstorespace, &rowsurplus, 0, DDSIP_data->nocon - 1)) ||
+    if ((status = CPXgetcolname (DDSIP_env, DDSIP_lp, colname, colnamestore, colstorespace, &colsurplus, 0, DDSIP_data->novar - 1)) ||
+            (status = CPXgetrowname (DDSIP_env, DDSIP_lp, rowname, rownamestore, rowstorespace, &rowsurplus, 0, DDSIP_data->nocon - 1)) ||
             (status = CPXgetsense (DDSIP_env, DDSIP_lp, sense, 0, DDSIP_data->nocon - 1)) ||
-            (status = CPXgetrhs (DDSIP_env, DDSIP_lp, base_rhs, 0, DDSIP_data->nocon - 1)) ||
-            (status = CPXgetlb (DDSIP_env, DDSIP_lp, lb, 0, DDSIP_data->novar - 1)) ||
-            (status = CPXgetub (DDSIP_env, DDSIP_lp, ub, 0, DDSIP_data->novar - 1)))
+            (status = CPXgetrhs (DDSIP_env, DDSIP_lp, rhs, 0, DDSIP_data->nocon - 1)))
     {
         fprintf (stderr, "Could not get problem data, returned %d\n", status);
         goto FREE;
     }
     // check whether there are ranged
-    for (j=0; j<DDSIP_data->nocon; j++)
+    for (j = 0; j < DDSIP_data->nocon; j++)
     {
         if (sense[j] == 'R')
         {
@@ -119,113 +88,51 @@ DDSIP_CheckRedundancy (int automatic)
     }
     if (ranged)
     {
-        if (!(rng = (double *) DDSIP_Alloc (sizeof (double), DDSIP_data->nocon, "rng(CheckRedundancy)")) ||
-                !(rng_sorted = (double *) DDSIP_Alloc (sizeof (double), DDSIP_Imax(DDSIP_data->firstcon,DDSIP_data->seccon), "rng_sorted(CheckRedundancy)")))
-        {
-            fprintf (stderr, "Not enough memory for building redundancy check problem\n");
-            goto FREE;
-        }
+        rng = (double *) DDSIP_Alloc (sizeof (double), DDSIP_data->nocon, "rng(RedundancyBuild)");
         if ((status = CPXgetrngval (DDSIP_env, DDSIP_lp, rng, 0, DDSIP_data->nocon-1)))
         {
             fprintf (stderr, "Coud not get problem ranges, returned %d\n", status);
             goto FREE;
         }
     }
-    /*____________________________________________________________________________________*/
 
     // create empty problem
-    redundancy = CPXcreateprob (DDSIP_env, &status, "redundancyCheck");
+    DDSIP_redlp = CPXcreateprob (DDSIP_env, &status, "redundancyCheck");
     if (status)
     {
         fprintf (stderr, "CPXcreateprob returned %d\n", status);
         goto FREE;
     }
 
-    // add (original) first-stage variables
+    // add (original) first-stage variables with their original bounds, the cuts are valid globally
     for (j = 0; j < DDSIP_data->firstvar; j++)
     {
-        vartype_sorted[j]   = 'C';
-        lb_sorted[j]        = lb[DDSIP_bb->firstindex[j]];
-        ub_sorted[j]        = ub[DDSIP_bb->firstindex[j]];
-        scaled_obj_coef[j]  = 0.;
-        scen_spec_colname[j]= colname[DDSIP_bb->firstindex[j]];
+        obj[j]            = 0.;
+        scen_spec_name[j] = colname[DDSIP_bb->firstindex[j]];
     }
-    if ((status = CPXnewcols (DDSIP_env, redundancy, DDSIP_data->firstvar, scaled_obj_coef,
-                              lb_sorted, ub_sorted, vartype_sorted, scen_spec_colname)))
+    if ((status = CPXnewcols (DDSIP_env, DDSIP_redlp, DDSIP_data->firstvar, obj, DDSIP_bb->lborg, DDSIP_bb->uborg, NULL, scen_spec_name)))
     {
         fprintf (stderr, "CPXnewcols returned %d for first-stage variables\n", status);
         goto FREE;
     }
-    DDSIP_Free ((void **) &(colnamestore));
-    // add slack variables for all cuts
-    currentCut = DDSIP_bb->cutpool;
-    j = 0;
-    while (currentCut)
-    {
-        vartype_sorted[j] = 'C';
-        lb_sorted[j]      = 0.;
-        ub_sorted[j]      = DDSIP_infty;
-        if (!(string2 = (char *) calloc (1, 255 * sizeof (char))))
-        {
-            fprintf (stderr, "Not enough memory for building redundancy check problem\n");
-            goto FREE;
-        }
-        sprintf (string2, "DDSIPCut%.03d_Slack", currentCut->number);
-        scen_spec_colname[j] = string2;
-        scaled_obj_coef[j] = 0.;
 
-        currentCut = currentCut->prev;
-        j++;
-    }
-    if ((status = CPXnewcols (DDSIP_env, redundancy, DDSIP_bb->cutCntr, scaled_obj_coef,
-                              lb_sorted, ub_sorted, vartype_sorted, scen_spec_colname)))
-    {
-        fprintf (stderr, "CPXnewcols returned %d for slack variables\n", status);
-        goto FREE;
-    }
-    for (j = 0; j < DDSIP_bb->cutCntr; j++)
-        DDSIP_Free ((void **) &(scen_spec_colname[j]));
-
-    // free arrays needeed only for columns
-    DDSIP_Free ((void **) &(colname));
-    DDSIP_Free ((void **) &(lb));
-    DDSIP_Free ((void **) &(ub));
-    //
     // get problem matrix coefficients
     // query the length needed for storage of coefficients
     CPXgetrows(DDSIP_env, DDSIP_lp, &nzcnt, rmatbeg, rmatind, rmatval, 0, &rowsurplus, 0, DDSIP_data->nocon - 1);
     nzcnt = -rowsurplus;
-    if (!(rmatbeg = (int *) DDSIP_Alloc (sizeof (int), DDSIP_data->nocon, "rmatbeg(CheckRedundancy)")) ||
-            !(rmatind = (int *) DDSIP_Alloc (sizeof (int), nzcnt, "rmatind(CheckRedundancy)")) ||
-            !(rmatval = (double *) DDSIP_Alloc (sizeof (double), nzcnt, "rmatval(CheckRedundancy)")))
-    {
-        fprintf (stderr, "Not enough memory for building redundancy check problem\n");
-        goto FREE;
-    }
+    rmatind = (int *) DDSIP_Alloc (sizeof (int), nzcnt + 1, "rmatind(RedundancyBuild)");
+    rmatval = (double *) DDSIP_Alloc (sizeof (double), nzcnt + 1, "rmatval(RedundancyBuild)");
+    rmatind_stage = (int *) DDSIP_Alloc (sizeof (int), nzcnt + 1, "rmatind_stage(RedundancyBuild)");
+    rmatval_stage = (double *) DDSIP_Alloc (sizeof (double), nzcnt + 1, "rmatval_stage(RedundancyBuild)");
     CPXgetrows(DDSIP_env, DDSIP_lp, &nzcnt, rmatbeg, rmatind, rmatval, nzcnt, &rowsurplus, 0, DDSIP_data->nocon - 1);
 
-#ifdef DEBUG
-    fprintf(stderr," got %d elements of the matrix\n", nzcnt);
-#endif
-
-    beg = DDSIP_Imax(DDSIP_data->firstcon, DDSIP_bb->cutCntr);
-    ind = nzcnt + DDSIP_bb->cutCntr * (DDSIP_data->firstvar + 1);
-    if (!(rmatbeg_stage = (int *) DDSIP_Alloc (sizeof (int), beg, "rmatbeg_stage(CheckRedundancy)")) ||
-            !(rmatind_stage = (int *) DDSIP_Alloc (sizeof (int), ind, "rmatind_stage(CheckRedundancy)")) ||
-            !(rmatval_stage = (double *) DDSIP_Alloc (sizeof (double), ind, "rmatval_stage(CheckRedundancy)")))
-    {
-        fprintf (stderr, "Not enough memory for building redundancy check problem\n");
-        goto FREE;
-    }
-
-
     // add first-stage constraints
     k = 0;
     for (j = 0; j < DDSIP_data->firstcon; j++)
     {
         sense_sorted[j] = sense[DDSIP_bb->firstrowind[j]];
-        redundancy_rhs[j] = base_rhs[DDSIP_bb->firstrowind[j]];
-        scen_spec_rowname[j] = rowname[DDSIP_bb->firstrowind[j]];
+        rhs_sorted[j] = rhs[DDSIP_bb->firstrowind[j]];
+        scen_spec_name[j] = rowname[DDSIP_bb->firstrowind[j]];
         rmatbeg_stage[j] = k;
         if (DDSIP_bb->firstrowind[j] == DDSIP_data->nocon -1)
             nzcnt_row = nzcnt - rmatbeg[DDSIP_data->nocon -1];
@@ -238,278 +145,316 @@ DDSIP_CheckRedundancy (int automatic)
         }
         k += nzcnt_row;
     }
-    if ((status = CPXaddrows(DDSIP_env, redundancy, 0, DDSIP_data->firstcon, k, redundancy_rhs, sense_sorted, rmatbeg_stage, rmatind_stage, rmatval_stage, NULL, scen_spec_rowname)))
+    if ((status = CPXaddrows(DDSIP_env, DDSIP_redlp, 0, DDSIP_data->firstcon, k, rhs_sorted, sense_sorted, rmatbeg_stage, rmatind_stage, rmatval_stage, NULL, scen_spec_name)))
     {
         fprintf (stderr, "CPXaddrows returned %d for first-stage constraints\n", status);
         goto FREE;
     }
-
     if (ranged)
     {
         for (j = 0; j < DDSIP_data->firstcon; j++)
         {
-            rng_sorted[j] = rng[DDSIP_bb->firstrowind[j]];
+            rhs_sorted[j] = rng[DDSIP_bb->firstrowind[j]];
             rowindex[j]   = j;
         }
-        if((status = CPXchgrngval(DDSIP_env, redundancy, DDSIP_data->firstcon, rowindex, rng_sorted)))
+        if((status = CPXchgrngval(DDSIP_env, DDSIP_redlp, DDSIP_data->firstcon, rowindex, rhs_sorted)))
         {
             fprintf (stderr, "CPXchgrngval returned %d for first-stage constraints\n", status);
             goto FREE;
         }
     }
+    DDSIP_redcnt = 0;
+    DDSIP_redrevision++;
 
-    // add the cuts
-    k = 0;
-    j = 0;
-    currentCut = DDSIP_bb->cutpool;
-    while (currentCut)
-    {
-        sense_sorted[j] = 'E';
-        redundancy_rhs[j] = currentCut->rhs;
-        if (!(string2 = (char *) calloc (1, 255 * sizeof (char))))
-        {
-            fprintf (stderr, "Not enough memory for building redundancy check problem\n");
-            goto FREE;
-        }
-        sprintf (string2, "DDSIPCut%.03d", currentCut->number);
+FREE:
+    if (status && DDSIP_redlp)
+        CPXfreeprob (DDSIP_env, &DDSIP_redlp);
+    DDSIP_Free ((void **) &(sense));
+    DDSIP_Free ((void **) &(sense_sorted));
+    DDSIP_Free ((void **) &(rhs));
+    DDSIP_Free ((void **) &(rhs_sorted));
+    DDSIP_Free ((void **) &(rowname));
+    DDSIP_Free ((void **) &(rownamestore));
+    DDSIP_Free ((void **) &(colname));
+    DDSIP_Free ((void **) &(colnamestore));
+    DDSIP_Free ((void **) &(scen_spec_name));
+    DDSIP_Free ((void **) &(obj));
+    DDSIP_Free ((void **) &(rmatbeg));
+    DDSIP_Free ((void **) &(rmatind));
+    DDSIP_Free ((void **) &(rmatval));
+    DDSIP_Free ((void **) &(rmatbeg_stage));
+    DDSIP_Free ((void **) &(rmatind_stage));
+    DDSIP_Free ((void **) &(rmatval_stage));
+    DDSIP_Free ((void **) &(rowindex));
+    DDSIP_Free ((void **) &(rng));
+    return status;
+} // DDSIP_RedundancyBuild
 
-        scen_spec_rowname[j] = string2;
-        rmatbeg_stage[j] = k;
-        nzcnt_row = DDSIP_data->novar + 1;
-        for (i = 0; i < DDSIP_data->firstvar; i++)
+//==========================================================================
+// Bring the cuts of the check problem up to date with the ones in DDSIP_lp: cuts deleted or moved out
+// of the problem meanwhile are removed, new ones appended (cuts waiting for deletion are left out)
+static int
+DDSIP_RedundancySync (void)
+{
+    cutpool_t *pool = &(DDSIP_bb->cutpool);
+    int status = 0, r, i, j, k, cnt, nzcnt, *rowdel, *coldel, *rmatbeg, *rmatind;
+    char *present, *sense, **name, *namestore;
+    double *rhs, *rmatval, *obj, *lb, *ub;
+
+    present = (char *) DDSIP_Alloc (sizeof (char), DDSIP_bb->cutNumber + 1, "present(RedundancySync)");
+    for (j = 0; j < DDSIP_bb->cutCntr; j++)
+        present[pool->number[j]] = 1;
+
+    // remove cuts which are no longer in DDSIP_lp
+    rowdel = (int *) DDSIP_Alloc (sizeof (int), DDSIP_data->firstcon + DDSIP_redcnt, "rowdel(RedundancySync)");
+    coldel = (int *) DDSIP_Alloc (sizeof (int), DDSIP_data->firstvar + DDSIP_redcnt, "coldel(RedundancySync)");
+    cnt = 0;
+    for (r = 0; r < DDSIP_redcnt; r++)
+    {
+        if (present[DDSIP_rednumber[r]])
         {
-            rmatind_stage[k + i] = i;
-            rmatval_stage[k + i] = currentCut->matval[i];
+            present[DDSIP_rednumber[r]] = 2;
+            DDSIP_rednumber[cnt++] = DDSIP_rednumber[r];
         }
-        rmatind_stage[k + DDSIP_data->firstvar] = DDSIP_data->firstvar + j;
-        rmatval_stage[k + DDSIP_data->firstvar] = -1.;
-        k += DDSIP_bb->firstvar + 1;
-        currentCut = currentCut->prev;
-        j++;
-    }
-    if ((status = CPXaddrows(DDSIP_env, redundancy, 0, j, k, redundancy_rhs, sense_sorted, rmatbeg_stage, rmatind_stage, rmatval_stage, NULL, scen_spec_rowname)))
-    {
-        fprintf (stderr, "CPXaddrows returned %d for cut constraints\n", status);
-        goto FREE;
+        else
+            rowdel[DDSIP_data->firstcon + r] = coldel[DDSIP_data->firstvar + r] = 1;
     }
-#ifdef DEBUG
-    fprintf(stderr," added cut constraints\n");
-#endif
-    if (j != DDSIP_bb->cutCntr)
+    if (cnt < DDSIP_redcnt)
     {
-        fprintf (stderr, "  ------- while loop found %d != %d cuts\n", j, DDSIP_bb->cutCntr);
+        if ((status = CPXdelsetrows (DDSIP_env, DDSIP_redlp, rowdel)) || (status = CPXdelsetcols (DDSIP_env, DDSIP_redlp, coldel)))
+        {
+            fprintf (stderr, "ERROR: Failed to delete cuts from redundancy check problem, status %d\n", status);
+            goto FREE;
+        }
+        DDSIP_redcnt = cnt;
+        DDSIP_redrevision++;
     }
-    for (i = 0; i < j; i++)
-        DDSIP_Free ((void **) &(scen_spec_rowname[i]));
+    for (i = 0; i < DDSIP_redpendcnt; i++)
+        present[DDSIP_redpending[i]] = 2;
 
-    time_end = DDSIP_GetCpuTime ();
-    if (DDSIP_param->outlev)
-        fprintf (DDSIP_bb->moreoutfile, "### %6.2f sec  for building redundancy check problem\n",time_end-time_start);
-    // now test for redundant cuts
-    sense[0] = 'L';
-    lb_sorted[0]       = -900000.;
-    ub_sorted[0]       =  0.;
-    ind = 0;
-    k = 0;
-    previousCut = NULL;
-    currentCut = DDSIP_bb->cutpool;
-    while (currentCut)
+    // append the new cuts
+    for (cnt = j = 0; j < DDSIP_bb->cutCntr; j++)
+        if (present[pool->number[j]] == 1)
+            cnt++;
+    if (cnt)
     {
-        // change lower bound of one slack variable and put it in the objective
-        rmatind_stage[0] = DDSIP_data->firstvar + k;
-        if ((status = CPXchgbds(DDSIP_env, redundancy, 1, rmatind_stage, sense, lb_sorted)))
+        if (DDSIP_redcnt + cnt > DDSIP_redcap)
         {
-            fprintf (stderr, "CPXchgbds returned %d\n", status);
-            goto FREE;
+            int *number = (int *) DDSIP_Alloc (sizeof (int), 2 * (DDSIP_redcnt + cnt), "rednumber(RedundancySync)");
+            if (DDSIP_redcnt)
+                memcpy (number, DDSIP_rednumber, DDSIP_redcnt * sizeof (int));
+            DDSIP_Free ((void **) &(DDSIP_rednumber));
+            DDSIP_rednumber = number;
+            DDSIP_redcap = 2 * (DDSIP_redcnt + cnt);
         }
-        if ((status = CPXchgcoef(DDSIP_env, redundancy, -1, rmatind_stage[0], 1.)))
+        sense = (char *) DDSIP_Alloc (sizeof (char), cnt, "sense(RedundancySync)");
+        name = (char **) DDSIP_Alloc (sizeof (char *), cnt, "name(RedundancySync)");
+        namestore = (char *) DDSIP_Alloc (sizeof (char), cnt * 32, "namestore(RedundancySync)");
+        rhs = (double *) DDSIP_Alloc (sizeof (double), cnt, "rhs(RedundancySync)");
+        obj = (double *) DDSIP_Alloc (sizeof (double), cnt, "obj(RedundancySync)");
+        lb = (double *) DDSIP_Alloc (sizeof (double), cnt, "lb(RedundancySync)");
+        ub = (double *) DDSIP_Alloc (sizeof (double), cnt, "ub(RedundancySync)");
+        rmatbeg = (int *) DDSIP_Alloc (sizeof (int), cnt, "rmatbeg(RedundancySync)");
+        rmatind = (int *) DDSIP_Alloc (sizeof (int), cnt * (DDSIP_data->firstvar + 1), "rmatind(RedundancySync)");
+        rmatval = (double *) DDSIP_Alloc (sizeof (double), cnt * (DDSIP_data->firstvar + 1), "rmatval(RedundancySync)");
+        // slack variables
+        for (k = j = 0; j < DDSIP_bb->cutCntr; j++)
         {
-            fprintf (stderr, "CPXchcoef returned %d\n", status);
-            goto FREE;
+            if (present[pool->number[j]] != 1)
+                continue;
+            name[k] = namestore + 32 * k;
+            sprintf (name[k], "DDSIPCut%.03d_Slack", pool->number[j]);
+            ub[k] = DDSIP_infty;
+            k++;
         }
-        // optimize
-        status = CPXchgprobtype (DDSIP_env, redundancy, CPXPROB_LP);
-        status = CPXdualopt (DDSIP_env, redundancy);
-        if (status)
+        if ((status = CPXnewcols (DDSIP_env, DDSIP_redlp, cnt, obj, lb, ub, NULL, name)))
+            fprintf (stderr, "CPXnewcols returned %d for slack variables\n", status);
+        else
         {
-            fprintf (stderr, "CPXdualopt returned %d for k= %d\n", status, k);
-            fprintf (DDSIP_outfile, "ERROR*: CPXdualopt returned %d for k= %d\n", status, k);
-            if (DDSIP_param->outlev)
-                fprintf (DDSIP_bb->moreoutfile, "ERROR*: CPXdualopt status %d for k= %d\n", status, k);
-            sprintf (probname, "sipout/redundancy%d_%d.lp.gz", callNr,k);
-            status = CPXwriteprob (DDSIP_env, redundancy, probname, NULL);
-            if (status)
+            // the cut rows
+            for (nzcnt = k = j = 0; j < DDSIP_bb->cutCntr; j++)
             {
-                fprintf (DDSIP_outfile, " *** redundancy check problem not written successfully, status = %d\n", status);
-                printf  (" *** redundancy check problem not written successfully, status = %d\n", status);
+                if (present[pool->number[j]] != 1)
+                    continue;
+                sprintf (name[k], "DDSIPCut%.03d", pool->number[j]);
+                sense[k] = 'E';
+                rhs[k] = pool->rhs[j];
+                rmatbeg[k] = nzcnt;
+                for (i = 0; i < DDSIP_data->firstvar; i++)
+                {
+                    if (pool->matval[j * pool->ld + i])
+                    {
+                        rmatind[nzcnt] = i;
+                        rmatval[nzcnt++] = pool->matval[j * pool->ld + i];
+                    }
+                }
+                rmatind[nzcnt] = DDSIP_data->firstvar + DDSIP_redcnt + k;
+                rmatval[nzcnt++] = -1.;
+                DDSIP_rednumber[DDSIP_redcnt + k] = pool->number[j];
+                k++;
             }
-            else
+            if ((status = CPXaddrows (DDSIP_env, DDSIP_redlp, 0, cnt, nzcnt, rhs, sense, rmatbeg, rmatind, rmatval, NULL, name)))
             {
-                fprintf (DDSIP_outfile, " *** redundancy check problem %s written successfully\n", probname);
-                printf  (" *** redundancy check problem %s written successfully\n", probname);
+                fprintf (stderr, "CPXaddrows returned %d for cut constraints\n", status);
+                CPXdelcols (DDSIP_env, DDSIP_redlp, DDSIP_data->firstvar + DDSIP_redcnt, DDSIP_data->firstvar + DDSIP_redcnt + cnt - 1);
             }
-            continue;
+            else
+                DDSIP_redcnt += cnt;
         }
-        status = CPXgetstat (DDSIP_env, redundancy);
-        if (status != CPX_STAT_OPTIMAL)
+        DDSIP_redrevision++;
+        DDSIP_Free ((void **) &(sense));
+        DDSIP_Free ((void **) &(name));
+        DDSIP_Free ((void **) &(namestore));
+        DDSIP_Free ((void **) &(rhs));
+        DDSIP_Free ((void **) &(obj));
+        DDSIP_Free ((void **) &(lb));
+        DDSIP_Free ((void **) &(ub));
+        DDSIP_Free ((void **) &(rmatbeg));
+        DDSIP_Free ((void **) &(rmatind));
+        DDSIP_Free ((void **) &(rmatval));
+    }
+
+FREE:
+    DDSIP_Free ((void **) &(present));
+    DDSIP_Free ((void **) &(rowdel));
+    DDSIP_Free ((void **) &(coldel));
+    return status;
+} // DDSIP_RedundancySync
+
+//==========================================================================
+// Test cut r of the redundancy check problem red (DDSIP_redlp or a copy in env): minimize its slack variable
+// with the lower bound lowered to -900000, a nonnegative minimum means that the cut is implied by the others.
+// The bound and objective are restored afterwards, the basis is kept for the next test.
+int
+DDSIP_RedundancyTest (CPXENVptr env, CPXLPptr red, int r, double *objval)
+{
+    int status, stat, index = DDSIP_data->firstvar + r;
+    char lu = 'L';
+    double bd = -900000.;
+
+    *objval = -DDSIP_infty;
+    if ((status = CPXchgbds (env, red, 1, &index, &lu, &bd)) || (status = CPXchgcoef (env, red, -1, index, 1.)))
+        return status;
+    if (!(status = CPXdualopt (env, red)))
+    {
+        if ((stat = CPXgetstat (env, red)) != CPX_STAT_OPTIMAL)
+            status = stat ? stat : -1;
+        else
+            status = CPXgetobjval (env, red, objval);
+    }
+    bd = 0.;
+    if ((stat = CPXchgbds (env, red, 1, &index, &lu, &bd)) || (stat = CPXchgcoef (env, red, -1, index, 0.)))
+        status = stat;
+    return status;
+} // DDSIP_RedundancyTest
+
+//==========================================================================
+// Check the cuts in DDSIP_lp for redundancy
+// All cuts are tested against the other ones in the kept check problem (concurrently if THREADS > 1),
+// the candidates found are confirmed one by one (newest first) while removing the redundant ones.
+// The cuts are deleted from DDSIP_lp by DDSIP_DeleteRedundantCuts at a suitable point of the main loop.
+void
+DDSIP_CheckRedundancy (int automatic)
+{
+    cutpool_t *pool = &(DDSIP_bb->cutpool);
+    int status, r, ind = 0, failed = 0, written = 0;
+    static int callNr = 1;
+    static int cutCnt = 1;
+    double *objval = NULL, time_start, time_end;
+    char probname[50];
+
+    if ((automatic && DDSIP_bb->cutNumber < cutCnt + 5) || (DDSIP_bb->cutCntr < 10))
+        return;
+    if (!pool->cnt)
+    {
+        fprintf(DDSIP_outfile, "*ERROR: cut counter is %d, but cutpool is empty\n", DDSIP_bb->cutCntr);
+        return;
+    }
+
+    time_start = DDSIP_GetCpuTime ();
+    if ((!DDSIP_redlp && DDSIP_RedundancyBuild ()) || DDSIP_RedundancySync ())
+    {
+        fprintf (DDSIP_outfile, "ERROR*: Failed to update redundancy check problem\n");
+        goto FREE;
+    }
+    time_end = DDSIP_GetCpuTime ();
+    if (DDSIP_param->outlev)
+        fprintf (DDSIP_bb->moreoutfile, "### %6.2f sec  for updating redundancy check problem (%d cuts)\n",time_end-time_start, DDSIP_redcnt);
+
+    // each cut against all the others
+    objval = (double *) DDSIP_Alloc (sizeof (double), DDSIP_redcnt + 1, "objval(CheckRedundancy)");
+    if (DDSIP_param->threads < 2 || DDSIP_ThreadsRedundancy (DDSIP_redlp, DDSIP_redrevision, DDSIP_redcnt, objval))
+    {
+        for (r = 0; r < DDSIP_redcnt; r++)
+            if (DDSIP_RedundancyTest (DDSIP_env, DDSIP_redlp, r, objval + r))
+                objval[r] = -DDSIP_infty;
+    }
+    // a candidate remains redundant if none of the cuts removed before was needed to imply it
+    for (r = DDSIP_redcnt - 1; r >= 0; r--)
+    {
+        if (objval[r] == -DDSIP_infty)
+            failed++;
+        // we leave cuts with "not really positive" objval in - to be sorted out by the solver
+        if (objval[r] < DDSIP_param->accuracy)
+            continue;
+        if (ind && (status = DDSIP_RedundancyTest (DDSIP_env, DDSIP_redlp, r, objval + r)))
         {
-            fprintf (stderr, "CPXdualopt status %d not optimal\n", status);
-            fprintf (DDSIP_outfile, "ERROR*: CPXdualopt status %d not optimal\n", status);
+            fprintf (DDSIP_outfile, "ERROR*: redundancy check of cut %d failed with status %d\n", DDSIP_rednumber[r], status);
             if (DDSIP_param->outlev)
-                fprintf (DDSIP_bb->moreoutfile, "ERROR*: CPXdualopt status %d not optimal\n", status);
-            sprintf (probname, "sipout/redundancy%d_%d.lp.gz", callNr,k);
-            status = CPXwriteprob (DDSIP_env, redundancy, probname, NULL);
-            if (status)
-            {
-                fprintf (DDSIP_outfile, " *** redundancy check problem not written successfully, status = %d\n", status);
-                printf  (" *** redundancy check problem not written successfully, status = %d\n", status);
-            }
-            else
+                fprintf (DDSIP_bb->moreoutfile, "ERROR*: redundancy check of cut %d failed with status %d\n", DDSIP_rednumber[r], status);
+            if (!written)
             {
-                fprintf (DDSIP_outfile, " *** redundancy check problem %s written successfully\n", probname);
-                printf  (" *** redundancy check problem %s written successfully\n", probname);
+                sprintf (probname, "sipout/redundancy%d_%d.lp.gz", callNr, DDSIP_rednumber[r]);
+                if (!(written = !CPXwriteprob (DDSIP_env, DDSIP_redlp, probname, NULL)))
+                    fprintf (DDSIP_outfile, " *** redundancy check problem not written successfully\n");
+                else
+                    fprintf (DDSIP_outfile, " *** redundancy check problem %s written successfully\n", probname);
             }
             continue;
         }
-        status = CPXgetobjval (DDSIP_env, redundancy, &objval);
-        if (status)
-        {
-            fprintf (stderr, "ERROR*: Failed to get objective value \n");
-            fprintf (DDSIP_outfile, "ERROR*: Failed to get objective value \n");
-            if (DDSIP_param->outlev)
-                fprintf (DDSIP_bb->moreoutfile, "ERROR*: Failed to get objective value \n");
+        if (objval[r] < DDSIP_param->accuracy)
             continue;
-        }
-//#ifdef DEBUG
-//        sprintf (probname, "sipout/redundancy%d_%d.lp.gz", callNr,k);
-//        status = CPXwriteprob (DDSIP_env, redundancy, probname, NULL);
-//        if (status)
-//        {
-//            fprintf (DDSIP_outfile, " *** redundancy check problem not written successfully, status = %d\n", status);
-//            if (DDSIP_param->outlev)
-//                fprintf (DDSIP_bb->moreoutfile, " *** redundancy check problem not written successfully, status = %d\n", status);
-//            printf  (" *** redundancy check problem not written successfully, status = %d\n", status);
-//        }
-//        else
-//        {
-//            if (DDSIP_param->outlev)
-//                fprintf (DDSIP_bb->moreoutfile, " *** redundancy check problem %s written successfully\n", probname);
-//            printf  (" *** redundancy check problem %s written successfully\n", probname);
-//        }
-//#endif
         if (DDSIP_param->outlev > 30)
+            fprintf (DDSIP_bb->moreoutfile, " *** redundancy check problem objective = %g\n", objval[r]);
+        if (DDSIP_param->outlev)
         {
-            fprintf (DDSIP_bb->moreoutfile, " *** redundancy check problem objective = %g\n", objval);
-            fprintf (DDSIP_bb->moreoutfile, "    %4d Cuts out of %d tested\n", k+1, DDSIP_bb->cutCntr);
+            fprintf (DDSIP_bb->moreoutfile, "######## Cut %4d is redundant\n", DDSIP_rednumber[r]);
+            if (DDSIP_param->outlev > 30 || !automatic)
+                fprintf (DDSIP_outfile, "    ######## Cut %4d is redundant\n", DDSIP_rednumber[r]);
         }
-        // if the objval is nonnegative, the cut is redundant
-        // we leave cuts with "not really positive" objval in - to be sorted out by the solver
-        if (objval >= DDSIP_param->accuracy)
+        if ((status = CPXdelrows (DDSIP_env, DDSIP_redlp, DDSIP_data->firstcon + r, DDSIP_data->firstcon + r)) ||
+                (status = CPXdelcols (DDSIP_env, DDSIP_redlp, DDSIP_data->firstvar + r, DDSIP_data->firstvar + r)))
         {
-            statusget = CPXgetrowname (DDSIP_env, DDSIP_lp, rowname, rownamestore, rowstorespace, &rowsurplus, DDSIP_bb->nocon + DDSIP_bb->cutCntr - k -1, DDSIP_bb->nocon + DDSIP_bb->cutCntr - k -1);
+            printf (" ### ERROR: delrows for cut %d of redundancy check problem failed with status %d\n", DDSIP_rednumber[r], status);
             if (DDSIP_param->outlev)
-            {
-                if (statusget)
-                {
-                    fprintf (DDSIP_bb->moreoutfile, "######## Cut %4d is redundant\n", currentCut->number);
-                    if (DDSIP_param->outlev > 30 || !automatic)
-                        fprintf (DDSIP_outfile, "    ######## Cut %4d is redundant\n", currentCut->number);
-                }
-                else
-                {
-                    fprintf (DDSIP_bb->moreoutfile, "######## %s is redundant\n", rowname[0]);
-                    if (DDSIP_param->outlev > 30 || !automatic)
-                        fprintf (DDSIP_outfile, "    ######## %s is redundant\n", rowname[0]);
-                }
-            }
-            statusget = CPXgetrowname (DDSIP_env, redundancy, rowname, rownamestore, rowstorespace, &rowsurplus, DDSIP_data->firstcon + k - ind, DDSIP_bb->firstcon + k - ind);
-            status = CPXdelrows (DDSIP_env, redundancy, DDSIP_data->firstcon + k - ind, DDSIP_data->firstcon + k - ind);
-            if (status)
-            {
-                if (!statusget)
-                {
-                    printf (" ### ERROR: delrows for row %d (%s) of redundancy check problem failed with status %d\n", DDSIP_bb->firstcon + k - ind,  rowname[0], status);
-                    if (DDSIP_param->outlev)
-                        fprintf (DDSIP_bb->moreoutfile, " ### ERROR: delrows for row %d (%s) of redundancy check problem failed with status %d\n", DDSIP_bb->firstcon + k - ind,  rowname[0], status);
-                }
-                else
-                {
-                    printf (" ### ERROR: delrows for row %d of redundancy check problem failed with status %d, status of getrowname = %d\n", DDSIP_bb->firstcon + k - ind, status, statusget);
-                    if (DDSIP_param->outlev)
-                        fprintf (DDSIP_bb->moreoutfile, " ### ERROR: delrows for row %d of redundancy check problem failed with status %d, status of getrowname = %d\n", DDSIP_bb->firstcon + k - ind, status, statusget);
-                }
-            }
-            if (DDSIP_param->deleteRedundantCuts)
-            {
-                statusget = CPXgetrowname (DDSIP_env, DDSIP_lp, rowname, rownamestore, rowstorespace, &rowsurplus, DDSIP_bb->nocon + DDSIP_bb->cutCntr - k -1, DDSIP_bb->nocon + DDSIP_bb->cutCntr - k -1);
-                status = CPXdelrows (DDSIP_env, DDSIP_lp, DDSIP_bb->nocon + DDSIP_bb->cutCntr - k -1, DDSIP_bb->nocon + DDSIP_bb->cutCntr - k -1);
-                if (status)
-                {
-                    if (!statusget)
-                    {
-                        fprintf (DDSIP_outfile, " ### ERROR: delrows for core problem failed for row %s, status %d\n", rowname[0], status);
-                        if (DDSIP_param->outlev)
-                            fprintf (DDSIP_bb->moreoutfile, " ### ERROR: delrows for row %d (%s) of core problem failed, status %d (DDSIP_bb->nocon = %d, number of rows in DDSIP_lp: %d)\n", DDSIP_bb->nocon + DDSIP_bb->cutCntr - k -1,  rowname[0], status, DDSIP_bb->nocon, CPXgetnumrows(DDSIP_env, DDSIP_lp));
-                    }
-                    else
-                    {
-                        fprintf (DDSIP_outfile, " ### ERROR: delrows for core problem failed for row= %d, status for getrowname= %d\n",  DDSIP_bb->nocon + DDSIP_bb->cutCntr - k -1, statusget);
-                        if (DDSIP_param->outlev)
-                            fprintf (DDSIP_bb->moreoutfile, " ### ERROR: delrows for row %d of core problem failed, status for getrowname = %d (DDSIP_bb->nocon = %d)\n", DDSIP_bb->nocon + DDSIP_bb->cutCntr - k -1, statusget,  DDSIP_bb->nocon);
-                    }
-                }
-                else if (DDSIP_param->outlev > 30)
-                {
-                    if (!statusget)
-                    {
-                        fprintf (DDSIP_bb->moreoutfile, " *** delrows for row %s of core problem successful\n", rowname[0]);
-                    }
-                    else
-                    {
-                        fprintf (DDSIP_bb->moreoutfile, " *** delrows for row %d of core problem successful, status for getrowname = %d\n", DDSIP_bb->nocon + DDSIP_bb->cutCntr - k -1, statusget);
-                    }
-                }
-                if (previousCut)
-                {
-                    previousCut->prev = currentCut->prev;
-                    DDSIP_Free ((void *) &(currentCut->matval));
-                    DDSIP_Free ((void *) &(currentCut));
-                    currentCut = previousCut;
-                    previousCut = currentCut;
-                    currentCut = currentCut->prev;
-                }
-                else
-                {
-                    DDSIP_bb->cutpool = currentCut->prev;
-                    DDSIP_Free ((void *) &(currentCut->matval));
-                    DDSIP_Free ((void *) &(currentCut));
-                    currentCut = DDSIP_bb->cutpool;
-                }
-            }
-            else
-            {
-                previousCut = currentCut;
-                currentCut = currentCut->prev;
-            }
-            ind++;
-        }
-        else
-        {
-            previousCut = currentCut;
-            currentCut = currentCut->prev;
-        }
-
-        if ((status = CPXchgbds(DDSIP_env, redundancy, 1, rmatind_stage, sense, ub_sorted)))
-        {
-            fprintf (stderr, "CPXchgbds returned %d\n", status);
-            goto FREE;
+                fprintf (DDSIP_bb->moreoutfile, " ### ERROR: delrows for cut %d of redundancy check problem failed with status %d\n", DDSIP_rednumber[r], status);
+            // start from scratch next time
+            CPXfreeprob (DDSIP_env, &DDSIP_redlp);
+            break;
         }
-        if ((status = CPXchgcoef(DDSIP_env, redundancy, -1, rmatind_stage[0], 0.)))
+        if (DDSIP_param->deleteRedundantCuts)
         {
-            fprintf (stderr, "CPXchcoef returned %d\n", status);
-            goto FREE;
+            if (DDSIP_redpendcnt == DDSIP_redpendcap)
+            {
+                int *pending = (int *) DDSIP_Alloc (sizeof (int), DDSIP_redpendcap ? 2 * DDSIP_redpendcap : 16, "redpending(CheckRedundancy)");
+                if (DDSIP_redpendcnt)
+                    memcpy (pending, DDSIP_redpending, DDSIP_redpendcnt * sizeof (int));
+                DDSIP_Free ((void **) &(DDSIP_redpending));
+                DDSIP_redpending = pending;
+                DDSIP_redpendcap = DDSIP_redpendcap ? 2 * DDSIP_redpendcap : 16;
+            }
+            DDSIP_redpending[DDSIP_redpendcnt++] = DDSIP_rednumber[r];
         }
-        k++;
+        memmove (DDSIP_rednumber + r, DDSIP_rednumber + r + 1, (DDSIP_redcnt - r - 1) * sizeof (int));
+        DDSIP_redcnt--;
+        DDSIP_redrevision++;
+        ind++;
+    }
+    if (failed)
+    {
+        fprintf (DDSIP_outfile, "ERROR*: redundancy check failed for %d cuts\n", failed);
+        if (DDSIP_param->outlev)
+            fprintf (DDSIP_bb->moreoutfile, "ERROR*: redundancy check failed for %d cuts\n", failed);
     }
     if (!ind)
     {
@@ -525,53 +470,147 @@ DDSIP_CheckRedundancy (int automatic)
         fprintf (DDSIP_outfile, "++++++++ %2d of the %d cuts are redundant  ->  %3d cuts\n", ind, DDSIP_bb->cutCntr, DDSIP_bb->cutCntr - ind);
         if (DDSIP_param->outlev)
             fprintf (DDSIP_bb->moreoutfile, "++++++++ %2d of the %d cuts are redundant  -> %3d cuts\n", ind, DDSIP_bb->cutCntr, DDSIP_bb->cutCntr - ind);
-        if (DDSIP_param->deleteRedundantCuts)
-            DDSIP_bb->cutCntr -= ind;
     }
 
     time_start = DDSIP_GetCpuTime ();
     if (DDSIP_param->outlev)
         fprintf (DDSIP_bb->moreoutfile, "### %6.2f sec  for checking redundancy of cuts\n",time_start-time_end);
 
-    status = CPXfreeprob (DDSIP_env, &redundancy);
-
-
 FREE:
     callNr++;
     cutCnt = DDSIP_bb->cutNumber;
-    DDSIP_Free ((void **) &(vartype_sorted));
-    DDSIP_Free ((void **) &(ub_sorted));
-    DDSIP_Free ((void **) &(lb_sorted));
-    DDSIP_Free ((void **) &(scaled_obj_coef));
-    DDSIP_Free ((void **) &(sense));
-    DDSIP_Free ((void **) &(sense_sorted));
-    DDSIP_Free ((void **) &(rowname));
-    DDSIP_Free ((void **) &(rownamestore));
-    DDSIP_Free ((void **) &(colname));
-    DDSIP_Free ((void **) &(colnamestore));
-    DDSIP_Free ((void **) &(redundancy_rhs));
-    DDSIP_Free ((void **) &(base_rhs));
-    DDSIP_Free ((void **) &(lb));
-    DDSIP_Free ((void **) &(ub));
-    DDSIP_Free ((void **) &(vartype_sorted));
-    DDSIP_Free ((void **) &(lb_sorted));
-    DDSIP_Free ((void **) &(ub_sorted));
-    DDSIP_Free ((void **) &(scaled_obj_coef));
-    DDSIP_Free ((void **) &(colindex_sorted));
-    DDSIP_Free ((void **) &(colindex_revers));
-    DDSIP_Free ((void **) &(scen_spec_rowname));
-    DDSIP_Free ((void **) &(scen_spec_colname));
-    DDSIP_Free ((void **) &(rmatbeg));
-    DDSIP_Free ((void **) &(rmatind));
-    DDSIP_Free ((void **) &(rmatval));
-    DDSIP_Free ((void **) &(rmatbeg_stage));
-    DDSIP_Free ((void **) &(rmatind_stage));
-    DDSIP_Free ((void **) &(rmatval_stage));
-    DDSIP_Free ((void **) &(rowindex));
-    if (ranged)
-    {
-        DDSIP_Free ((void **) &(rng));
-        DDSIP_Free ((void **) &(rng_sorted));
-    }
+    DDSIP_Free ((void **) &(objval));
     return;
 }
+
+//==========================================================================
+// Delete the cuts found redundant by DDSIP_CheckRedundancy from DDSIP_lp and the pool
+// Called in the main loop between the nodes, i.e. not within the dual method or a bounding procedure
+void
+DDSIP_DeleteRedundantCuts (void)
+{
+    cutpool_t *pool = &(DDSIP_bb->cutpool);
+    int i, j, status, cnt = 0;
+
+    for (i = 0; i < DDSIP_redpendcnt; i++)
+    {
+        for (j = 0; j < pool->cnt && pool->number[j] != DDSIP_redpending[i]; j++)
+            ;
+        if (j == pool->cnt)
+            continue;
+        // cuts moved out of DDSIP_lp by DDSIP_CutPoolAging have no row
+        if (j < DDSIP_bb->cutCntr)
+        {
+            if ((status = CPXdelrows (DDSIP_env, DDSIP_lp, DDSIP_bb->nocon + j, DDSIP_bb->nocon + j)))
+            {
+                fprintf (DDSIP_outfile, " ### ERROR: delrows for core problem failed for cut %d, status %d\n", pool->number[j], status);
+                if (DDSIP_param->outlev)
+                    fprintf (DDSIP_bb->moreoutfile, " ### ERROR: delrows for row %d (cut %d) of core problem failed, status %d (DDSIP_bb->nocon = %d, number of rows in DDSIP_lp: %d)\n",
+                             DDSIP_bb->nocon + j, pool->number[j], status, DDSIP_bb->nocon, CPXgetnumrows(DDSIP_env, DDSIP_lp));
+                continue;
+            }
+            DDSIP_bb->cutCntr--;
+            cnt++;
+        }
+        else if (DDSIP_param->outlev > 30)
+            fprintf (DDSIP_bb->moreoutfile, " *** cut %d not in core problem\n", pool->number[j]);
+        DDSIP_CutPoolDel (j);
+    }
+    DDSIP_redpendcnt = 0;
+    if (cnt)
+    {
+        DDSIP_ThreadsModelChanged ();
+        if (DDSIP_param->outlev)
+            fprintf (DDSIP_bb->moreoutfile, "++++++++ %d redundant cuts deleted from core problem -> %d cuts\n", cnt, DDSIP_bb->cutCntr);
+    }
+} // DDSIP_DeleteRedundantCuts
+
+//==========================================================================
+// Free the redundancy check problem (before DDSIP_env is closed)
+void
+DDSIP_FreeRedundancy (void)
+{
+    if (DDSIP_redlp)
+        CPXfreeprob (DDSIP_env, &DDSIP_redlp);
+    DDSIP_Free ((void **) &(DDSIP_rednumber));
+    DDSIP_Free ((void **) &(DDSIP_redpending));
+    DDSIP_redcnt = DDSIP_redcap = DDSIP_redpendcnt = DDSIP_redpendcap = 0;
+} // DDSIP_FreeRedundancy
+
+
+//==========================================================================
+// Move the cuts which have not been binding at the scenario solutions of the last CUTAGE nodes
+// out of DDSIP_lp, they stay in the pool and are added again by DDSIP_CutPoolReAdd when violated
+void
+DDSIP_CutPoolAging (void)
+{
+    cutpool_t *pool = &(DDSIP_bb->cutpool);
+    int j, status, cnt = 0;
+
+    if (!DDSIP_param->cutAge)
+        return;
+    for (j = DDSIP_bb->cutCntr - 1; j >= 0; j--)
+    {
+        if (pool->age[j] < DDSIP_param->cutAge)
+            continue;
+        if ((status = CPXdelrows (DDSIP_env, DDSIP_lp, DDSIP_bb->nocon + j, DDSIP_bb->nocon + j)))
+        {
+            fprintf (stderr, "ERROR: Failed to delete inactive cut %d (CutPoolAging), status=%d\n", pool->number[j], status);
+            break;
+        }
+        if (DDSIP_param->outlev > 20)
+            fprintf (DDSIP_bb->moreoutfile, " *** cut %d not binding in %d nodes (binding in %d), slack %g, removed from problem\n",
+                     pool->number[j], pool->age[j], pool->binding[j], pool->slack[j]);
+        DDSIP_CutPoolMove (j, DDSIP_bb->cutCntr - 1);
+        DDSIP_bb->cutCntr--;
+        cnt++;
+    }
+    if (cnt)
+    {
+        DDSIP_ThreadsModelChanged ();
+        if (DDSIP_param->outlev)
+            fprintf (DDSIP_bb->moreoutfile, "++++++++ %d inactive cuts removed from problem -> %d cuts, %d in pool\n", cnt, DDSIP_bb->cutCntr, pool->cnt);
+    }
+} // DDSIP_CutPoolAging
+
+//==========================================================================
+// Add cut j of the pool (j >= cutCntr, i.e. moved out of DDSIP_lp by DDSIP_CutPoolAging) to DDSIP_lp again
+int
+DDSIP_CutPoolReAdd (int j)
+{
+    cutpool_t *pool = &(DDSIP_bb->cutpool);
+    int i, status, nzcnt = 0, rmatbeg = 0;
+    int *rmatind;
+    double *rmatval;
+    char sense = 'G', rowstore[DDSIP_ln_varname], *rowname[1];
+
+    rmatind = (int *) DDSIP_Alloc (sizeof (int), DDSIP_bb->firstvar, "rmatind(CutPoolReAdd)");
+    rmatval = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "rmatval(CutPoolReAdd)");
+    for (i = 0; i < DDSIP_bb->firstvar; i++)
+    {
+        if (pool->matval[j * pool->ld + i])
+        {
+            rmatind[nzcnt] = DDSIP_bb->firstindex[i];
+            rmatval[nzcnt++] = pool->matval[j * pool->ld + i];
+        }
+    }
+    rowname[0] = rowstore;
+    sprintf (rowstore, pool->Benders[j] ? "DDSIPBendersCut%.04d" : "DDSIPIntegerCut%.04d", pool->number[j]);
+    if ((status = CPXaddrows (DDSIP_env, DDSIP_lp, 0, 1, nzcnt, &(pool->rhs[j]), &sense, &rmatbeg, rmatind, rmatval, NULL, rowname)))
+    {
+        fprintf (stderr, "ERROR: Failed to add cut %d again (CutPoolReAdd), status=%d\n", pool->number[j], status);
+    }
+    else
+    {
+        if (DDSIP_param->outlev > 20)
+            fprintf (DDSIP_bb->moreoutfile, " *** cut %d added to problem again\n", pool->number[j]);
+        pool->age[j] = 0;
+        DDSIP_CutPoolMove (j, DDSIP_bb->cutCntr);
+        DDSIP_bb->cutCntr++;
+        DDSIP_bb->cutAdded++;
+        DDSIP_ThreadsModelChanged ();
+    }
+    DDSIP_Free ((void **) &(rmatind));
+    DDSIP_Free ((void **) &(rmatval));
+    return status;
+} // DDSIP_CutPoolReAdd
@@ -32,23 +32,28 @@ DDSIP_RestoreBoundAndType (void)
 {
     int status = 0;
 
-    if ((DDSIP_bb->DDSIP_step == neobj || DDSIP_bb->DDSIP_step == eev) && DDSIP_param->riskvar)
-        DDSIP_UndeleteRiskObj ();
-
     // Restore original bounds
-    status = CPXchgbds (DDSIP_env, DDSIP_lp, DDSIP_bb->firstvar, DDSIP_bb->firstindex, DDSIP_bb->lbident, DDSIP_bb->lborg);
+    status = DDSIP_ChgFirstBounds (DDSIP_bb->lborg, DDSIP_bb->uborg);
     if (status)
     {
-        fprintf (stderr, "ERROR: Failed to change lower bounds \n");
+        fprintf (stderr, "ERROR: Failed to change bounds \n");
         return status;
     }
 
-    status = CPXchgbds (DDSIP_env, DDSIP_lp, DDSIP_bb->firstvar, DDSIP_bb->firstindex, DDSIP_bb->ubident, DDSIP_bb->uborg);
-    if (status)
-    {
-        fprintf (stderr, "ERROR: Failed to change upper bounds \n");
-        return status;
-    }
+    return DDSIP_RestoreType ();
+}
+
+//==========================================================================
+// Restore type of the variables, the bounds of the current node are kept in DDSIP_lp
+// (the next node changes only the bounds differing from these)
+int
+DDSIP_RestoreType (void)
+{
+    int status = 0;
+
+    if ((DDSIP_bb->DDSIP_step == neobj || DDSIP_bb->DDSIP_step == eev) && DDSIP_param->riskvar)
+        DDSIP_UndeleteRiskObj ();
+
     // probtype=0 (LP)
     if (!CPXgetprobtype (DDSIP_env, DDSIP_lp))
     {
@@ -433,6 +433,11 @@ DDSIP_SemDevGetNodeTarget (void)
             return status;
         }
     }
+#ifdef CONIC_BUNDLE
+    // Lagrangean cost corrections of all scenarios for the multipliers of the node
+    if (DDSIP_param->cb && DDSIP_bb->multipliers)
+        DDSIP_LagrangeCost ();
+#endif
     // LowerBound problem for each scenario
     //****************************************************************************
     for (scen = 0; scen < DDSIP_param->scenarios; scen++)
@@ -869,6 +874,8 @@ DDSIP_RiskModel (void)
     int status = 0;
     char fname[DDSIP_ln_fname];
 
+    // The objective is changed
+    DDSIP_InvalidateLoaded (DDSIP_bb->loaded);
     printf ("Initializing ");
     if (DDSIP_param->riskmod > 0)
     {
@@ -1013,6 +1020,7 @@ DDSIP_DeleteRiskObj (void)
     double *vallist = NULL;
 
     // Set coefficients for variables of risk models to 0
+    DDSIP_InvalidateLoaded (DDSIP_bb->loaded);
     cnt = 1;
     if (abs (DDSIP_param->riskmod) == 5)
         cnt = 2;
@@ -1078,6 +1086,7 @@ DDSIP_UndeleteRiskObj (void)
     double *vallist = NULL;
 
     // Add coefficients for risk variables
+    DDSIP_InvalidateLoaded (DDSIP_bb->loaded);
     cnt = 1;
     //TVaR
     if (abs (DDSIP_param->riskmod) == 5)
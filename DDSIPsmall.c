@@ -24,6 +24,10 @@
 
 #include <DDSIP.h>
 #include <DDSIPconst.h>
+#include <stdint.h>
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
 #ifndef _WIN32
 #include <unistd.h>
 #endif
@@ -327,6 +331,106 @@ DDSIP_Equal(double a, double b)
     return (diff > (DDSIP_param->accuracy * 0.5 * (sum))) ? 0 : 1;
 }
 
+//==========================================================================
+// Hash value of a first-stage vector (x[index[j]], or x[j] for index NULL) compatible with DDSIP_Equal:
+// integer components enter rounded, continuous ones only by their sign, since DDSIP_Equal holds
+// only for numbers with the same sign
+unsigned int
+DDSIP_FirstHash (double *x, int *index)
+{
+    int j;
+    double val;
+    unsigned int hash = 2166136261u;
+
+    for (j = 0; j < DDSIP_bb->firstvar; j++)
+    {
+        val = index ? x[index[j]] : x[j];
+        if (DDSIP_bb->firsttype[j] == 'B' || DDSIP_bb->firsttype[j] == 'I' || DDSIP_bb->firsttype[j] == 'N')
+            hash = (hash ^ (unsigned int) (long long) floor (val + 0.1)) * 16777619u;
+        else
+            hash = (hash ^ (unsigned int) ((val > 0.) - (val < 0.) + 1)) * 16777619u;
+    }
+    return hash;
+} // DDSIP_FirstHash
+
+//==========================================================================
+// Scalar product of two 32 byte aligned vectors, n is a multiple of 4
+static double
+DDSIP_CutDot (const double *a, const double *b, int n)
+{
+    int i;
+#ifdef __AVX__
+    double s[4];
+    __m256d sum = _mm256_setzero_pd ();
+
+    for (i = 0; i < n; i += 4)
+#ifdef __FMA__
+        sum = _mm256_fmadd_pd (_mm256_load_pd (a + i), _mm256_load_pd (b + i), sum);
+#else
+        sum = _mm256_add_pd (sum, _mm256_mul_pd (_mm256_load_pd (a + i), _mm256_load_pd (b + i)));
+#endif
+    _mm256_storeu_pd (s, sum);
+    return (s[0] + s[1]) + (s[2] + s[3]);
+#else
+    double s0 = 0., s1 = 0., s2 = 0., s3 = 0.;
+
+    for (i = 0; i < n; i += 4)
+    {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    return (s0 + s1) + (s2 + s3);
+#endif
+} // DDSIP_CutDot
+
+//==========================================================================
+// Check the first-stage vectors x[0..nocand-1] (NULL entries are skipped) against the cuts of the pool:
+// cut[c] returns the index of the newest cut violated by x[c] by more than tol + reltol*|rhs| (-1 if none)
+// and viol[c] the violation. The vectors are copied to aligned rows, each cut row is used for the whole batch.
+void
+DDSIP_CutPoolCheck (int nocand, double **x, double tol, double reltol, int *cut, double *viol)
+{
+    cutpool_t *pool = &(DDSIP_bb->cutpool);
+    int c, j, left = 0;
+    double lhs, *row, *xstore, *xa;
+
+    for (c = 0; c < nocand; c++)
+    {
+        cut[c] = -1;
+        viol[c] = 0.;
+        if (x[c])
+            left++;
+    }
+    if (!pool->cnt || !left)
+        return;
+
+    xstore = (double *) DDSIP_Alloc (sizeof (double), nocand * pool->ld + 4, "xstore(CutPoolCheck)");
+    xa = (double *) (((uintptr_t) xstore + 31) & ~(uintptr_t) 31);
+    for (c = 0; c < nocand; c++)
+        if (x[c])
+            memcpy (xa + c * pool->ld, x[c], DDSIP_bb->firstvar * sizeof (double));
+
+    for (j = pool->cnt - 1; j >= 0 && left; j--)
+    {
+        row = pool->matval + j * pool->ld;
+        for (c = 0; c < nocand; c++)
+        {
+            if (!x[c] || cut[c] >= 0)
+                continue;
+            lhs = DDSIP_CutDot (row, xa + c * pool->ld, pool->ld);
+            if (lhs < pool->rhs[j] - tol - reltol * fabs (pool->rhs[j]))
+            {
+                cut[c] = j;
+                viol[c] = pool->rhs[j] - lhs;
+                left--;
+            }
+        }
+    }
+    DDSIP_Free ((void **) &(xstore));
+} // DDSIP_CutPoolCheck
+
 // Accuracy comparison of two multiplier verctors
 int
 DDSIP_MultEqual(double *a, double *b)
@@ -345,3 +449,51 @@ DDSIP_MultEqual(double *a, double *b)
     }
     return 1;
 }
+
+//==========================================================================
+// Update the activity statistics of the cuts in DDSIP_lp with the scenario solutions first_sol of a node:
+// a cut is binding if its slack at one of the distinct solutions is below 1e-6*(1+|rhs|)
+void
+DDSIP_CutPoolActivity (double **first_sol)
+{
+    cutpool_t *pool = &(DDSIP_bb->cutpool);
+    int c, j, nocand = 0, *first, *next;
+    double slack, *row, *xstore, *xa;
+
+    if (!DDSIP_bb->cutCntr)
+        return;
+
+    first = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "first(CutPoolActivity)");
+    next = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "next(CutPoolActivity)");
+    xstore = (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios * pool->ld + 4, "xstore(CutPoolActivity)");
+    xa = (double *) (((uintptr_t) xstore + 31) & ~(uintptr_t) 31);
+    DDSIP_FirstSolGroups (first_sol, first, next);
+    for (c = 0; c < DDSIP_param->scenarios; c++)
+        if (first[c] == c)
+            memcpy (xa + (nocand++) * pool->ld, first_sol[c], DDSIP_bb->firstvar * sizeof (double));
+
+    if (nocand)
+    {
+        for (j = 0; j < DDSIP_bb->cutCntr; j++)
+        {
+            row = pool->matval + j * pool->ld;
+            pool->slack[j] = DDSIP_infty;
+            for (c = 0; c < nocand; c++)
+            {
+                slack = DDSIP_CutDot (row, xa + c * pool->ld, pool->ld) - pool->rhs[j];
+                if (slack < pool->slack[j])
+                    pool->slack[j] = slack;
+            }
+            if (pool->slack[j] < 1.e-6 * (1. + fabs (pool->rhs[j])))
+            {
+                pool->binding[j]++;
+                pool->age[j] = 0;
+            }
+            else
+                pool->age[j]++;
+        }
+    }
+    DDSIP_Free ((void **) &(xstore));
+    DDSIP_Free ((void **) &(first));
+    DDSIP_Free ((void **) &(next));
+} // DDSIP_CutPoolActivity
@@ -0,0 +1,1264 @@
+/*  Authors:           Andreas M"arkert, Ralf Gollmer
+	Copyright to:      University of Duisburg-Essen
+    Language:          C
+	Description:
+	Concurrent solution of the scenario problems of a node.
+	Each worker thread owns a CPLEX environment with a copy of the problem,
+	the results are handed back to the (serial) bookkeeping of the calling
+	procedure in the usual scenario order.
+	Workers running out of scenarios of the current node solve the lower bound
+	problems of further unsolved front nodes in advance (THRNOD), these results
+	are taken over when such a node becomes the current node.
+	The environments of the workers are used for the redundancy check of the cuts as well.
+
+	License:
+	This file is part of DDSIP.
+
+    DDSIP is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    DDSIP is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with DDSIP; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
+
+#include <DDSIP.h>
+#include <DDSIPconst.h>
+#include <pthread.h>
+
+// Result of a scenario problem solved by a worker thread
+typedef struct
+{
+    // 1 if the result has not been handed to the caller yet
+    int    solved;
+    int    optstatus;
+    int    mipstatus;
+    int    nodes_1st;
+    int    nodes_2nd;
+    double objval;
+    double bobjval;
+    // elapsed time of the solve
+    double time;
+    // solution vector (first- and second-stage variables, all columns in UpperBound)
+    double *mipx;
+} result_t;
+
+// CPLEX parameter set (see para_t)
+typedef struct
+{
+    int    no;
+    int    *isdbl;
+    int    *which;
+    double *what;
+} cpxset_t;
+
+// Worker thread with its own environment and copy of the problem
+typedef struct
+{
+    pthread_t thread;
+    CPXENVptr env;
+    CPXLPptr  lp;
+    // revision of DDSIP_lp the copy was made from
+    int       revision;
+    // slot whose first-stage bounds are set in the copy (0: bounds of DDSIP_lp)
+    int       boundslot;
+    int       status;
+    // set in order to abort a running optimization
+    volatile int terminate;
+    // scenario data loaded in the copy
+    loaded_t  *loaded;
+    // cplex parameter set applied in env
+    cpxstate_t cpxstate;
+    // buffers for mip starts
+    double    *values;
+    int       *beg;
+    int       *effort;
+    // copy of the redundancy check problem and its revision (see DDSIP_ThreadsRedundancy)
+    CPXLPptr  redlp;
+    int       redrevision;
+} worker_t;
+
+static void *DDSIP_ThreadsWorker (void *);
+static int DDSIP_ThreadsPara (worker_t *, int);
+static int DDSIP_ThreadsLBSolve (worker_t *, int, int);
+static int DDSIP_ThreadsUBSolve (worker_t *, int);
+static int DDSIP_ThreadsWarm (worker_t *, int, int);
+static int DDSIP_ThreadsSync (void);
+static int DDSIP_ThreadsRound (double);
+static void DDSIP_ThreadsStop (worker_t *);
+static int DDSIP_ThreadsNextTask (int *);
+static int DDSIP_ThreadsBounds (worker_t *, int);
+static void DDSIP_ThreadsNodeBounds (int, double *, double *);
+static void DDSIP_ThreadsPrefetch (void);
+static void *DDSIP_ThreadsRedWorker (void *);
+
+static worker_t *DDSIP_workers = NULL;
+static result_t *DDSIP_results = NULL;
+static int DDSIP_noworkers = 0;
+// Revision of the structure of DDSIP_lp (rows and columns), incremented by DDSIP_ThreadsModelChanged
+static int DDSIP_revision = 1;
+
+// State of the current round of lower or upper bounds, protected by DDSIP_threadlock
+static pthread_mutex_t DDSIP_threadlock = PTHREAD_MUTEX_INITIALIZER;
+static int    DDSIP_nextscen;
+static int    DDSIP_stopped;
+static int    DDSIP_infscen;
+static int    DDSIP_fathom;
+static double DDSIP_roundbound;
+static double DDSIP_roundlimit;
+// Parameter sets for the 1st and 2nd optimization of the current round
+static cpxset_t DDSIP_roundpara[2];
+// Relative tolerance for restricting the first-stage solution to the original bounds
+static double DDSIP_roundbndtol;
+// 1 for the scenario problems of DDSIP_UpperBound (fixed first stage)
+static int    DDSIP_roundub;
+// Scenarios of DDSIP_UpperBound with a cached result which are not solved (NULL: none)
+static int    *DDSIP_rounddone;
+// Scenario order of the round (lb_scen_order or ub_scen_order)
+static int    *DDSIP_roundorder;
+// Relative MIP gap of the inexact dual evaluation for the 1st optimization (0: CPLEX parameters)
+static double DDSIP_roundgap;
+// Bounds for the scenarios contained in the bound passed to the round
+static double *DDSIP_roundsub;
+
+// Result slots: slot 0 belongs to the current round, slots 1..DDSIP_noslots-1 to further
+// unsolved front nodes whose lower bound problems are solved in advance (DDSIP_results
+// holds DDSIP_noslots blocks of DDSIP_param->scenarios results)
+static int    DDSIP_noslots = 0;
+// 1 if the current round solves problems of further nodes
+static int    DDSIP_roundprefetch;
+// Node of a slot (-1: free), next position in lb_scen_order, infeasibility detected
+static int    *DDSIP_slotnode = NULL;
+static int    *DDSIP_slotnext = NULL;
+static int    *DDSIP_slotinf = NULL;
+// First-stage bounds of the node of a slot (DDSIP_noslots blocks of DDSIP_bb->firstvar)
+static double *DDSIP_slotlb = NULL;
+static double *DDSIP_slotub = NULL;
+// Redundancy check: next cut to test, number of cuts, optimal values
+static int    DDSIP_rednext;
+static int    DDSIP_rednocuts;
+static double *DDSIP_redobj;
+
+//==========================================================================
+// The structure of DDSIP_lp changed (rows added or deleted), the copies have to be renewed
+// and results not yet processed are discarded, these scenarios are solved again in DDSIP_lp
+void
+DDSIP_ThreadsModelChanged (void)
+{
+    int scen;
+
+    DDSIP_revision++;
+    if (DDSIP_results)
+        for (scen = 0; scen < DDSIP_noslots * DDSIP_param->scenarios; scen++)
+            DDSIP_results[scen].solved = 0;
+    for (scen = 1; scen < DDSIP_noslots; scen++)
+        DDSIP_slotnode[scen] = -1;
+} // DDSIP_ThreadsModelChanged
+
+//==========================================================================
+// Free environments and problem copies of the worker threads
+void
+DDSIP_ThreadsFree (void)
+{
+    int i, status;
+
+    if (DDSIP_workers)
+    {
+        for (i = 0; i < DDSIP_noworkers; i++)
+        {
+            if (DDSIP_workers[i].redlp)
+                CPXfreeprob (DDSIP_workers[i].env, &(DDSIP_workers[i].redlp));
+            if (DDSIP_workers[i].lp)
+            {
+                status = CPXfreeprob (DDSIP_workers[i].env, &(DDSIP_workers[i].lp));
+                if (status)
+                    fprintf (stderr, "ERROR: Failed to free problem copy of thread %d\n", i + 1);
+            }
+            if (DDSIP_workers[i].env)
+            {
+                status = CPXcloseCPLEX (&(DDSIP_workers[i].env));
+                if (status)
+                    fprintf (stderr, "ERROR: Failed to close CPLEX environment of thread %d\n", i + 1);
+            }
+            DDSIP_Free ((void **) &(DDSIP_workers[i].values));
+            DDSIP_Free ((void **) &(DDSIP_workers[i].beg));
+            DDSIP_Free ((void **) &(DDSIP_workers[i].effort));
+            DDSIP_FreeLoaded (&(DDSIP_workers[i].loaded));
+            DDSIP_FreeCpxState (&(DDSIP_workers[i].cpxstate));
+        }
+        DDSIP_Free ((void **) &(DDSIP_workers));
+    }
+    if (DDSIP_results)
+    {
+        for (i = 0; i < DDSIP_noslots * DDSIP_param->scenarios; i++)
+            DDSIP_Free ((void **) &(DDSIP_results[i].mipx));
+        DDSIP_Free ((void **) &(DDSIP_results));
+    }
+    DDSIP_Free ((void **) &(DDSIP_slotnode));
+    DDSIP_Free ((void **) &(DDSIP_slotnext));
+    DDSIP_Free ((void **) &(DDSIP_slotinf));
+    DDSIP_Free ((void **) &(DDSIP_slotlb));
+    DDSIP_Free ((void **) &(DDSIP_slotub));
+    DDSIP_noworkers = 0;
+    DDSIP_noslots = 0;
+} // DDSIP_ThreadsFree
+
+//==========================================================================
+// Bring the problem copies of the workers up to date with DDSIP_lp
+// A copy is renewed via a SAV file if rows or columns changed, the bounds and
+// objective coefficients of all columns and the rhs of all rows (objective bound
+// row, deactivated cuts) are transferred in every call
+static int
+DDSIP_ThreadsSync (void)
+{
+    int i, j, k, status = 0, nocols, norows, ordcnt = 0, surplus;
+    char fname[DDSIP_ln_fname];
+    int *index = NULL, *priority = NULL, *direction = NULL;
+    char *lu = NULL;
+    double *bd = NULL;
+
+    for (i = 0; i < DDSIP_noworkers; i++)
+        if (DDSIP_workers[i].revision != DDSIP_revision)
+            break;
+    nocols = CPXgetnumcols (DDSIP_env, DDSIP_lp);
+    norows = CPXgetnumrows (DDSIP_env, DDSIP_lp);
+    if (i < DDSIP_noworkers)
+    {
+        sprintf (fname, "%s/thread_copy.sav", DDSIP_outdir);
+        status = CPXwriteprob (DDSIP_env, DDSIP_lp, fname, "SAV");
+        if (status)
+        {
+            fprintf (stderr, "ERROR: Failed to write problem copy %s (ThreadsSync)\n", fname);
+            fprintf (DDSIP_outfile, "ERROR: Failed to write problem copy %s (ThreadsSync)\n", fname);
+            return status;
+        }
+        // Priority order
+        if (DDSIP_param->cpxorder)
+        {
+            index = (int *) DDSIP_Alloc (sizeof (int), nocols, "index(ThreadsSync)");
+            priority = (int *) DDSIP_Alloc (sizeof (int), nocols, "priority(ThreadsSync)");
+            direction = (int *) DDSIP_Alloc (sizeof (int), nocols, "direction(ThreadsSync)");
+            status = CPXgetorder (DDSIP_env, DDSIP_lp, &ordcnt, index, priority, direction, nocols, &surplus);
+            if (status)
+            {
+                fprintf (stderr, "ERROR: Failed to get priority order (ThreadsSync)\n");
+                goto TERMINATE;
+            }
+        }
+        for (; i < DDSIP_noworkers; i++)
+        {
+            if (DDSIP_workers[i].revision == DDSIP_revision)
+                continue;
+            if (!DDSIP_workers[i].env)
+            {
+                DDSIP_workers[i].env = CPXopenCPLEX (&status);
+                if (!DDSIP_workers[i].env)
+                {
+                    fprintf (stderr, "ERROR: Failed to open CPLEX environment for thread %d\n", i + 1);
+                    fprintf (DDSIP_outfile, "ERROR: Failed to open CPLEX environment for thread %d\n", i + 1);
+                    goto TERMINATE;
+                }
+                status = CPXsetterminate (DDSIP_workers[i].env, &(DDSIP_workers[i].terminate));
+                if (status)
+                {
+                    fprintf (stderr, "ERROR: Failed to set terminate indicator for thread %d\n", i + 1);
+                    goto TERMINATE;
+                }
+            }
+            if (DDSIP_workers[i].lp)
+                CPXfreeprob (DDSIP_workers[i].env, &(DDSIP_workers[i].lp));
+            DDSIP_workers[i].lp = CPXcreateprob (DDSIP_workers[i].env, &status, "DDSIP_thread");
+            if (!DDSIP_workers[i].lp)
+            {
+                fprintf (stderr, "ERROR: Failed to create problem copy for thread %d\n", i + 1);
+                fprintf (DDSIP_outfile, "ERROR: Failed to create problem copy for thread %d\n", i + 1);
+                goto TERMINATE;
+            }
+            status = CPXreadcopyprob (DDSIP_workers[i].env, DDSIP_workers[i].lp, fname, NULL);
+            if (status)
+            {
+                fprintf (stderr, "ERROR: Failed to read problem copy %s for thread %d\n", fname, i + 1);
+                fprintf (DDSIP_outfile, "ERROR: Failed to read problem copy %s for thread %d\n", fname, i + 1);
+                goto TERMINATE;
+            }
+            if ((k = CPXgetnummipstarts (DDSIP_workers[i].env, DDSIP_workers[i].lp)) > 0)
+                CPXdelmipstarts (DDSIP_workers[i].env, DDSIP_workers[i].lp, 0, k - 1);
+            if (ordcnt)
+            {
+                status = CPXcopyorder (DDSIP_workers[i].env, DDSIP_workers[i].lp, ordcnt, index, priority, direction);
+                if (status)
+                {
+                    fprintf (stderr, "ERROR: Failed to copy priority order for thread %d\n", i + 1);
+                    goto TERMINATE;
+                }
+            }
+            // The copy contains the scenario data of DDSIP_lp
+            DDSIP_CopyLoaded (DDSIP_workers[i].loaded, DDSIP_bb->loaded, 1);
+            DDSIP_workers[i].revision = DDSIP_revision;
+        }
+        remove (fname);
+        DDSIP_Free ((void **) &(index));
+        DDSIP_Free ((void **) &(priority));
+        DDSIP_Free ((void **) &(direction));
+    }
+
+    // Bounds of all columns (branching, risk models)
+    index = (int *) DDSIP_Alloc (sizeof (int), DDSIP_Imax (2 * nocols, norows), "index(ThreadsSync)");
+    lu = (char *) DDSIP_Alloc (sizeof (char), 2 * nocols, "lu(ThreadsSync)");
+    bd = (double *) DDSIP_Alloc (sizeof (double), DDSIP_Imax (2 * nocols, norows), "bd(ThreadsSync)");
+    if ((status = CPXgetlb (DDSIP_env, DDSIP_lp, bd, 0, nocols - 1)) ||
+        (status = CPXgetub (DDSIP_env, DDSIP_lp, bd + nocols, 0, nocols - 1)))
+    {
+        fprintf (stderr, "ERROR: Failed to get bounds (ThreadsSync), returned %d\n", status);
+        goto TERMINATE;
+    }
+    for (j = 0; j < nocols; j++)
+    {
+        index[j] = index[nocols + j] = j;
+        lu[j] = 'L';
+        lu[nocols + j] = 'U';
+    }
+    for (i = 0; i < DDSIP_noworkers; i++)
+    {
+        status = CPXchgbds (DDSIP_workers[i].env, DDSIP_workers[i].lp, 2 * nocols, index, lu, bd);
+        if (status)
+        {
+            fprintf (stderr, "ERROR: Failed to change bounds for thread %d (ThreadsSync)\n", i + 1);
+            goto TERMINATE;
+        }
+    }
+    // Right-hand sides of all rows (objective bound, cuts deactivated in UpperBound)
+    for (j = 0; j < norows; j++)
+        index[j] = j;
+    status = CPXgetrhs (DDSIP_env, DDSIP_lp, bd, 0, norows - 1);
+    if (status)
+    {
+        fprintf (stderr, "ERROR: Failed to get rhs (ThreadsSync)\n");
+        goto TERMINATE;
+    }
+    for (i = 0; i < DDSIP_noworkers; i++)
+    {
+        status = CPXchgrhs (DDSIP_workers[i].env, DDSIP_workers[i].lp, norows, index, bd);
+        if (status)
+        {
+            fprintf (stderr, "ERROR: Failed to change rhs for thread %d (ThreadsSync)\n", i + 1);
+            goto TERMINATE;
+        }
+    }
+    // Objective (risk models, upper bounds)
+    status = CPXgetobj (DDSIP_env, DDSIP_lp, bd, 0, nocols - 1);
+    if (status)
+    {
+        fprintf (stderr, "ERROR: Failed to get objective coefficients (ThreadsSync)\n");
+        goto TERMINATE;
+    }
+    for (i = 0; i < DDSIP_noworkers; i++)
+    {
+        status = CPXchgobj (DDSIP_workers[i].env, DDSIP_workers[i].lp, nocols, index, bd);
+        if (status)
+        {
+            fprintf (stderr, "ERROR: Failed to change objective for thread %d (ThreadsSync)\n", i + 1);
+            goto TERMINATE;
+        }
+        DDSIP_CopyLoaded (DDSIP_workers[i].loaded, DDSIP_bb->loaded, 0);
+    }
+
+TERMINATE:
+    DDSIP_Free ((void **) &(index));
+    DDSIP_Free ((void **) &(priority));
+    DDSIP_Free ((void **) &(direction));
+    DDSIP_Free ((void **) &(lu));
+    DDSIP_Free ((void **) &(bd));
+    return status;
+} // DDSIP_ThreadsSync
+
+//==========================================================================
+// Start values for a worker: solution of the father of node (and of the
+// previous dual iteration), same meaning of HOTSTART as in DDSIP_Warm
+static int
+DDSIP_ThreadsWarm (worker_t *w, int node, int scen)
+{
+    int i, j, k, kf, added = 0, status;
+
+    if ((k = CPXgetnummipstarts (w->env, w->lp)) > 0)
+        CPXdelmipstarts (w->env, w->lp, 0, k - 1);
+
+    w->beg[0] = 0;
+    if (DDSIP_param->hot && DDSIP_bb->DDSIP_step == dual && DDSIP_bb->dualitcnt)
+    {
+        w->effort[0] = 3;
+        if (memcmp (DDSIP_bb->boundIncrease_intsolvals[scen], DDSIP_bb->intsolvals[scen], DDSIP_bb->total_int * sizeof (double)))
+        {
+            status = CPXaddmipstarts (w->env, w->lp, 1, DDSIP_bb->total_int, w->beg, DDSIP_bb->intind, DDSIP_bb->boundIncrease_intsolvals[scen], w->effort, NULL);
+            if (status)
+                return status;
+        }
+        status = CPXaddmipstarts (w->env, w->lp, 1, DDSIP_bb->total_int, w->beg, DDSIP_bb->intind, DDSIP_bb->intsolvals[scen], w->effort, NULL);
+        if (status)
+            return status;
+        added++;
+    }
+    // A node solved in advance is processed by DDSIP_LowerBound later on (step is not set yet)
+    else if (DDSIP_param->hot && node && (node != DDSIP_bb->curnode || DDSIP_node[node]->step != dual))
+    {
+        w->effort[0] = 2;
+        // Hotstart = 4 or 6 --> solutions of all scenarios in the father, else only of this one
+        for (j = 0; j < DDSIP_param->scenarios; j++)
+        {
+            if (j != scen && DDSIP_param->hot != 4 && DDSIP_param->hot != 6)
+                continue;
+            for (k = 0; k < DDSIP_bb->total_int; k++)
+                w->values[added * DDSIP_bb->total_int + k] = DDSIP_node[node]->solut[j * DDSIP_bb->total_int + k];
+            for (i = 0; i < added; i++)
+            {
+                for (k = 0; k < DDSIP_bb->total_int; k++)
+                    if (!DDSIP_Equal (w->values[added * DDSIP_bb->total_int + k], w->values[i * DDSIP_bb->total_int + k]))
+                        break;
+                if (k >= DDSIP_bb->total_int)
+                    break;
+            }
+            if (i >= added)
+                added++;
+        }
+        // A priori feasibility check (branching may lead to infeasibility)
+        kf = DDSIP_node[node]->neoind;
+        k = DDSIP_bb->firstindex[kf];
+        if (DDSIP_bb->firsttype[kf] == 'B' || DDSIP_bb->firsttype[kf] == 'I' || DDSIP_bb->firsttype[kf] == 'N')
+        {
+            for (i = 0; i < DDSIP_bb->total_int; i++)
+                if (k == DDSIP_bb->intind[i])
+                    break;
+            for (j = 0; i < DDSIP_bb->total_int && j < added; j++)
+            {
+                if (w->values[j * DDSIP_bb->total_int + i] < DDSIP_node[node]->neolb ||
+                        w->values[j * DDSIP_bb->total_int + i] > DDSIP_node[node]->neoub)
+                    w->values[j * DDSIP_bb->total_int + i] = DDSIP_node[node]->neolb;
+            }
+        }
+        for (j = 0; j < added; j++)
+        {
+            status = CPXaddmipstarts (w->env, w->lp, 1, DDSIP_bb->total_int, w->beg, DDSIP_bb->intind, w->values + j * DDSIP_bb->total_int, w->effort, NULL);
+            if (status)
+                return status;
+        }
+    }
+    // ADVIND must be 2 when using supplied start values
+    status = CPXsetintparam (w->env, CPX_PARAM_ADVIND, added ? 2 : (DDSIP_param->hot ? 1 : 0));
+    if (status)
+        return status;
+
+    // Hotstart = 2 or 5 or 6
+    // Lower bounds are passed to sons and daughters
+    if (node && (DDSIP_param->hot == 2 || DDSIP_param->hot > 4) && !DDSIP_param->riskmod && !DDSIP_param->cb)
+    {
+        status = CPXchgrhs (w->env, w->lp, 1, &(DDSIP_bb->objbndind), &(DDSIP_node[node]->subbound[scen]));
+        if (status)
+            return status;
+    }
+    return 0;
+} // DDSIP_ThreadsWarm
+
+//==========================================================================
+// Set the parameter set k of the round in the environment of a worker,
+// the 1st set with the MIP gap of the inexact dual evaluation if there is one
+static int
+DDSIP_ThreadsPara (worker_t *w, int k)
+{
+    int status;
+
+    status = DDSIP_SetCpxParaEnv (w->env, &(w->cpxstate), DDSIP_roundpara[k].no, DDSIP_roundpara[k].isdbl, DDSIP_roundpara[k].which, DDSIP_roundpara[k].what);
+    if (!status && !k && DDSIP_roundgap > 0.)
+        status = CPXsetdblparam (w->env, CPX_PARAM_EPGAP, DDSIP_roundgap);
+    return status;
+} // DDSIP_ThreadsPara
+
+//==========================================================================
+// Solve the lower bound problem of one scenario for the node of the slot in the problem copy of a worker
+static int
+DDSIP_ThreadsLBSolve (worker_t *w, int slot, int scen)
+{
+    int j, k, status;
+    double mipgap = 1.e+30, wr, time_start, time_end;
+    result_t *res = DDSIP_results + slot * DDSIP_param->scenarios + scen;
+
+    res->nodes_1st = res->nodes_2nd = -1;
+    res->objval = res->bobjval = DDSIP_infty;
+
+    status = DDSIP_ChgProbLp (w->env, w->lp, w->loaded, scen, DDSIP_bb->multipliers);
+    if (status)
+        return status;
+    status = DDSIP_ThreadsWarm (w, slot ? DDSIP_slotnode[slot] : DDSIP_bb->curnode, scen);
+    if (status)
+        return status;
+
+    CPXgettime (w->env, &time_start);
+    res->optstatus = CPXmipopt (w->env, w->lp);
+    res->mipstatus = CPXgetstat (w->env, w->lp);
+    res->nodes_1st = CPXgetnodecnt (w->env, w->lp);
+    if (!res->optstatus && !DDSIP_Error (res->optstatus) && !DDSIP_Infeasible (res->mipstatus))
+    {
+        if (CPXgetmiprelgap (w->env, w->lp, &mipgap))
+            mipgap = 1.e+30;
+        if (DDSIP_roundpara[1].no && res->mipstatus != CPXMIP_OPTIMAL && !w->terminate)
+        {
+            // more iterations with different settings
+            status = DDSIP_ThreadsPara (w, 1);
+            if (status)
+                return status;
+            CPXgetdblparam (w->env, CPX_PARAM_EPGAP, &wr);
+            // continue if desired gap is not reached yet (in an inexact dual evaluation the gap of the round suffices)
+            if (mipgap > wr && mipgap > DDSIP_roundgap)
+            {
+                res->optstatus = CPXmipopt (w->env, w->lp);
+                res->mipstatus = CPXgetstat (w->env, w->lp);
+                res->nodes_2nd = CPXgetnodecnt (w->env, w->lp);
+            }
+            else if (res->mipstatus == CPXMIP_TIME_LIM_FEAS || res->mipstatus == CPXMIP_NODE_LIM_FEAS)
+                res->mipstatus = CPXMIP_OPTIMAL_TOL;
+            // reset CPLEX parameters to the first set
+            status = DDSIP_ThreadsPara (w, 0);
+            if (status)
+                return status;
+        }
+    }
+    CPXgettime (w->env, &time_end);
+    res->time = time_end - time_start;
+    // An aborted optimization is left to the serial loop
+    if (w->terminate)
+        return 0;
+    if (DDSIP_Error (res->optstatus) || DDSIP_Infeasible (res->mipstatus))
+        return 0;
+
+    if (DDSIP_NoSolution (res->mipstatus))
+    {
+        status = CPXgetbestobjval (w->env, w->lp, &(res->bobjval));
+        if (status)
+            return status;
+    }
+    else
+    {
+        status = CPXgetobjval (w->env, w->lp, &(res->objval));
+        if (!status)
+            status = CPXgetx (w->env, w->lp, res->mipx, 0, DDSIP_bb->firstvar + DDSIP_bb->secvar - 1);
+        if (!status)
+            status = CPXgetbestobjval (w->env, w->lp, &(res->bobjval));
+        if (status)
+            return status;
+        // Numerical errors?
+        for (j = 0; j < DDSIP_bb->firstvar; j++)
+        {
+            k = DDSIP_bb->firstindex[j];
+#ifdef CHECK_BOUNDS
+            // loose - restrict the first-stage variables inside of original bounds (disregarding branching)
+            if (DDSIP_bb->lborg[j] - res->mipx[k] > (DDSIP_bb->lborg[j] + 1.) * DDSIP_roundbndtol)
+                res->mipx[k] = DDSIP_bb->lborg[j];
+            else if (res->mipx[k] - DDSIP_bb->uborg[j] > (DDSIP_bb->uborg[j] + 1.) * DDSIP_roundbndtol)
+                res->mipx[k] = DDSIP_bb->uborg[j];
+#endif
+            // tiny value?
+            if (fabs (res->mipx[k]) < 1e-18)
+                res->mipx[k] = 0.0;
+        }
+    }
+    // If the tree was exhausted bobjval is huge
+    if (res->mipstatus != CPXMIP_OPTIMAL && fabs (res->bobjval) > DDSIP_infty)
+        res->bobjval = res->objval;
+    return 0;
+} // DDSIP_ThreadsLBSolve
+
+//==========================================================================
+// Solve the scenario problem with fixed first stage (UpperBound) in the problem copy of a worker
+// The premature stop is checked with the bound of the first optimization as in the serial loop
+static int
+DDSIP_ThreadsUBSolve (worker_t *w, int scen)
+{
+    int j, k, status, stop = 0;
+    double mipgap = 1.e+30, wr, time_start, time_end;
+    result_t *res = DDSIP_results + scen;
+
+    res->nodes_1st = res->nodes_2nd = -1;
+    res->objval = res->bobjval = DDSIP_infty;
+
+    status = DDSIP_ChgProbLp (w->env, w->lp, w->loaded, scen, 0);
+    if (status)
+        return status;
+    // Warm start as in DDSIP_WarmUb, the mip starts of the copy stem from other scenarios
+    if ((k = CPXgetnummipstarts (w->env, w->lp)) > 0)
+        CPXdelmipstarts (w->env, w->lp, 0, k - 1);
+    if (DDSIP_param->hot)
+    {
+        status = CPXsetintparam (w->env, CPX_PARAM_ADVIND, 2);
+        if (status)
+            return status;
+    }
+
+    CPXgettime (w->env, &time_start);
+    res->optstatus = CPXmipopt (w->env, w->lp);
+    res->mipstatus = CPXgetstat (w->env, w->lp);
+    res->nodes_1st = CPXgetnodecnt (w->env, w->lp);
+    if (!DDSIP_Error (res->optstatus) && !DDSIP_Infeasible (res->mipstatus) && !w->terminate)
+    {
+        if (CPXgetmiprelgap (w->env, w->lp, &mipgap))
+            mipgap = 1.e+30;
+        // If even with the lower bounds for the other scenarios we would reach a greater value we may stop here
+        if (DDSIP_fathom && !CPXgetbestobjval (w->env, w->lp, &wr))
+        {
+            pthread_mutex_lock (&DDSIP_threadlock);
+            wr = DDSIP_roundbound + DDSIP_data->prob[scen] * (wr - DDSIP_roundsub[scen]);
+            if (!DDSIP_stopped && wr > DDSIP_roundlimit)
+            {
+                DDSIP_roundbound = wr;
+                DDSIP_ThreadsStop (w);
+            }
+            stop = DDSIP_stopped;
+            pthread_mutex_unlock (&DDSIP_threadlock);
+            if (stop)
+                return 0;
+        }
+        if (DDSIP_roundpara[1].no && res->mipstatus != CPXMIP_OPTIMAL)
+        {
+            // more iterations with different settings
+            status = DDSIP_ThreadsPara (w, 1);
+            if (status)
+                return status;
+            CPXgetdblparam (w->env, CPX_PARAM_EPGAP, &wr);
+            // continue if desired gap is not reached yet
+            if (mipgap > wr)
+            {
+                res->optstatus = CPXmipopt (w->env, w->lp);
+                res->mipstatus = CPXgetstat (w->env, w->lp);
+                res->nodes_2nd = CPXgetnodecnt (w->env, w->lp);
+            }
+            // reset CPLEX parameters for 1st optimization
+            status = DDSIP_ThreadsPara (w, 0);
+            if (status)
+                return status;
+        }
+    }
+    CPXgettime (w->env, &time_end);
+    res->time = time_end - time_start;
+
+    if (w->terminate)
+        return 0;
+    if (DDSIP_Error (res->optstatus) || DDSIP_NoSolution (res->mipstatus))
+        return 0;
+
+    // Solution as in DDSIP_GetCpxSolution
+    status = CPXgetobjval (w->env, w->lp, &(res->objval));
+    if (status)
+        return status;
+    if (res->mipstatus == CPXMIP_OPTIMAL)
+        res->bobjval = res->objval;
+    else if ((status = CPXgetbestobjval (w->env, w->lp, &(res->bobjval))))
+        return status;
+    status = CPXgetx (w->env, w->lp, res->mipx, 0, DDSIP_bb->novar - 1);
+    if (status)
+        return status;
+    for (j = 0; j < DDSIP_bb->novar; j++)
+        if (DDSIP_Equal (res->mipx[j], 0.0))
+            res->mipx[j] = 0.0;
+    return 0;
+} // DDSIP_ThreadsUBSolve
+
+//==========================================================================
+// Stop the round and abort the optimizations of the other workers (DDSIP_threadlock is held)
+static void
+DDSIP_ThreadsStop (worker_t *w)
+{
+    int i;
+
+    DDSIP_stopped = 1;
+    for (i = 0; i < DDSIP_noworkers; i++)
+        if (DDSIP_workers + i != w)
+            DDSIP_workers[i].terminate = 1;
+} // DDSIP_ThreadsStop
+
+//==========================================================================
+// Next scenario problem of the round (DDSIP_threadlock is held)
+// Returns the position in the scenario order of the round and the slot, -1 if there is none left
+static int
+DDSIP_ThreadsNextTask (int *slot)
+{
+    int s, node, scen;
+
+    // The current node first, solutions inherited from the father, results taken over and cached results are not computed
+    while (DDSIP_nextscen < DDSIP_param->scenarios)
+    {
+        scen = DDSIP_roundorder[DDSIP_nextscen];
+        if (DDSIP_results[scen].solved || (!DDSIP_roundub && (DDSIP_node[DDSIP_bb->curnode]->first_sol)[scen]) ||
+            (DDSIP_roundub && DDSIP_rounddone && DDSIP_rounddone[scen]))
+            DDSIP_nextscen++;
+        else
+        {
+            *slot = 0;
+            return DDSIP_nextscen++;
+        }
+    }
+    if (!DDSIP_roundprefetch)
+        return -1;
+    // Further front nodes in the order of the front
+    for (s = 1; s < DDSIP_noslots; s++)
+    {
+        if ((node = DDSIP_slotnode[s]) < 0 || DDSIP_slotinf[s])
+            continue;
+        while (DDSIP_slotnext[s] < DDSIP_param->scenarios)
+        {
+            scen = DDSIP_roundorder[DDSIP_slotnext[s]];
+            if (DDSIP_results[s * DDSIP_param->scenarios + scen].solved || (DDSIP_node[node]->first_sol)[scen])
+                DDSIP_slotnext[s]++;
+            else
+            {
+                *slot = s;
+                return DDSIP_slotnext[s]++;
+            }
+        }
+    }
+    return -1;
+} // DDSIP_ThreadsNextTask
+
+//==========================================================================
+// Set the first-stage bounds of the node of the slot in the problem copy of a worker
+static int
+DDSIP_ThreadsBounds (worker_t *w, int slot)
+{
+    int status;
+
+    status = CPXchgbds (w->env, w->lp, DDSIP_bb->firstvar, DDSIP_bb->firstindex, DDSIP_bb->lbident, DDSIP_slotlb + slot * DDSIP_bb->firstvar);
+    if (!status)
+        status = CPXchgbds (w->env, w->lp, DDSIP_bb->firstvar, DDSIP_bb->firstindex, DDSIP_bb->ubident, DDSIP_slotub + slot * DDSIP_bb->firstvar);
+    if (status)
+    {
+        fprintf (stderr, "ERROR: Failed to change bounds for node %d (ThreadsBounds)\n", DDSIP_slotnode[slot]);
+        return status;
+    }
+    w->boundslot = slot;
+    return 0;
+} // DDSIP_ThreadsBounds
+
+//==========================================================================
+// Worker thread: fetch scenarios in the order of the round until all are
+// solved or the node resp. the suggested solution can be discarded
+// Then the scenarios of further front nodes are solved (DDSIP_roundprefetch)
+static void *
+DDSIP_ThreadsWorker (void *arg)
+{
+    worker_t *w = (worker_t *) arg;
+    int iscen, scen, slot = 0;
+    result_t *res;
+
+    w->status = DDSIP_ThreadsPara (w, 0);
+    while (!w->status)
+    {
+        pthread_mutex_lock (&DDSIP_threadlock);
+        if (DDSIP_stopped || DDSIP_killsignal || (iscen = DDSIP_ThreadsNextTask (&slot)) < 0)
+        {
+            pthread_mutex_unlock (&DDSIP_threadlock);
+            break;
+        }
+        pthread_mutex_unlock (&DDSIP_threadlock);
+
+        scen = DDSIP_roundorder[iscen];
+        res = DDSIP_results + slot * DDSIP_param->scenarios + scen;
+        if (slot != w->boundslot && (w->status = DDSIP_ThreadsBounds (w, slot)))
+            break;
+        if (DDSIP_roundub)
+            w->status = DDSIP_ThreadsUBSolve (w, scen);
+        else
+            w->status = DDSIP_ThreadsLBSolve (w, slot, scen);
+        if (w->status || w->terminate)
+            break;
+
+        pthread_mutex_lock (&DDSIP_threadlock);
+        if (slot)
+        {
+            // A node solved in advance: errors are left to the serial loop, an infeasible
+            // scenario makes the remaining ones of the node superfluous
+            if (!DDSIP_Error (res->optstatus))
+            {
+                res->solved = 1;
+                if (DDSIP_Infeasible (res->mipstatus))
+                    DDSIP_slotinf[slot] = 1;
+            }
+            pthread_mutex_unlock (&DDSIP_threadlock);
+            continue;
+        }
+        if (DDSIP_stopped)
+        {
+            pthread_mutex_unlock (&DDSIP_threadlock);
+            break;
+        }
+        res->solved = 1;
+        if (DDSIP_Error (res->optstatus))
+            DDSIP_ThreadsStop (w);
+        else if (DDSIP_roundub ? DDSIP_NoSolution (res->mipstatus) : DDSIP_Infeasible (res->mipstatus))
+        {
+            // The node resp. the suggested solution is infeasible
+            DDSIP_ThreadsStop (w);
+            if (DDSIP_infscen < 0)
+                DDSIP_infscen = scen;
+        }
+        else if (DDSIP_fathom)
+        {
+            // Replace the bound for this scenario contained in the bound of the round by the new one
+            DDSIP_roundbound += DDSIP_data->prob[scen] * (DDSIP_Dmin (res->bobjval, res->objval) - DDSIP_roundsub[scen]);
+            if (DDSIP_roundbound > DDSIP_roundlimit)
+                DDSIP_ThreadsStop (w);
+        }
+        pthread_mutex_unlock (&DDSIP_threadlock);
+    }
+    return NULL;
+} // DDSIP_ThreadsWorker
+
+//==========================================================================
+// First-stage bounds of a node: original bounds restricted by the branching of the node and its ancestors (as in DDSIP_SetBounds)
+static void
+DDSIP_ThreadsNodeBounds (int node, double *lb, double *ub)
+{
+    int i, k;
+
+    for (k = 0; k < DDSIP_bb->firstvar; k++)
+    {
+        lb[k] = DDSIP_bb->lborg[k];
+        ub[k] = DDSIP_bb->uborg[k];
+    }
+    for (i = node; i > 0; i = DDSIP_node[i]->father)
+    {
+        k = DDSIP_node[i]->neoind;
+        lb[k] = DDSIP_Dmax (DDSIP_node[i]->neolb, lb[k]);
+        ub[k] = DDSIP_Dmin (DDSIP_node[i]->neoub, ub[k]);
+        lb[k] = DDSIP_Dmin (lb[k], ub[k]);
+    }
+} // DDSIP_ThreadsNodeBounds
+
+//==========================================================================
+// Prepare the slots for a lower bound round: take over the results computed in advance
+// for the current node and assign the further unsolved front nodes to the slots
+static void
+DDSIP_ThreadsPrefetch (void)
+{
+    int i, s, iscen, scen, cnt, *cand;
+    result_t tmp, *res;
+
+    // Results for the current node computed in advance are moved to slot 0
+    for (s = 1; s < DDSIP_noslots; s++)
+        if (DDSIP_slotnode[s] == DDSIP_bb->curnode)
+            break;
+    if (s < DDSIP_noslots)
+    {
+        cnt = 0;
+        for (iscen = 0; iscen < DDSIP_param->scenarios; iscen++)
+        {
+            scen = DDSIP_roundorder[iscen];
+            tmp = DDSIP_results[scen];
+            DDSIP_results[scen] = DDSIP_results[s * DDSIP_param->scenarios + scen];
+            DDSIP_results[s * DDSIP_param->scenarios + scen] = tmp;
+            DDSIP_results[s * DDSIP_param->scenarios + scen].solved = 0;
+            res = DDSIP_results + scen;
+            if (!res->solved)
+                continue;
+            cnt++;
+            // Premature stop as in the worker threads
+            if (DDSIP_Infeasible (res->mipstatus))
+            {
+                DDSIP_stopped = 1;
+                if (DDSIP_infscen < 0)
+                    DDSIP_infscen = scen;
+            }
+            else if (DDSIP_fathom)
+                DDSIP_roundbound += DDSIP_data->prob[scen] * (DDSIP_Dmin (res->bobjval, res->objval) - DDSIP_roundsub[scen]);
+        }
+        if (DDSIP_fathom && DDSIP_roundbound > DDSIP_roundlimit)
+            DDSIP_stopped = 1;
+        DDSIP_slotnode[s] = -1;
+        if (DDSIP_param->outlev > 2)
+            fprintf (DDSIP_bb->moreoutfile, "%d scenario problems of node %d solved in advance by the threads.\n", cnt, DDSIP_bb->curnode);
+    }
+
+    // The first unsolved front nodes keep their slots resp. are assigned to free ones
+    // (in the order of their numbers like in the selection of the next node, see DDSIP_GetCurNode)
+    cand = (int *) DDSIP_Alloc (sizeof (int), DDSIP_noslots, "cand(ThreadsPrefetch)");
+    for (i = DDSIP_bb->firstunsolved, cnt = 0; i < DDSIP_bb->nonode && cnt < DDSIP_noslots - 1; i++)
+        if (i != DDSIP_bb->curnode && DDSIP_node[i]->frontpos >= 0 && !DDSIP_node[i]->solved)
+            cand[cnt++] = i;
+    for (s = 1; s < DDSIP_noslots; s++)
+    {
+        for (i = 0; i < cnt && cand[i] != DDSIP_slotnode[s]; i++)
+            ;
+        if (i < cnt)
+            cand[i] = -1;
+        else
+            DDSIP_slotnode[s] = -1;
+    }
+    for (i = 0; i < cnt; i++)
+    {
+        if (cand[i] < 0)
+            continue;
+        for (s = 1; DDSIP_slotnode[s] >= 0; s++)
+            ;
+        DDSIP_slotnode[s] = cand[i];
+        DDSIP_slotinf[s] = 0;
+        for (scen = 0; scen < DDSIP_param->scenarios; scen++)
+            DDSIP_results[s * DDSIP_param->scenarios + scen].solved = 0;
+    }
+    DDSIP_Free ((void **) &(cand));
+    for (s = 1; s < DDSIP_noslots; s++)
+    {
+        DDSIP_slotnext[s] = 0;
+        if (DDSIP_slotnode[s] >= 0)
+            DDSIP_ThreadsNodeBounds (DDSIP_slotnode[s], DDSIP_slotlb + s * DDSIP_bb->firstvar, DDSIP_slotub + s * DDSIP_bb->firstvar);
+    }
+    // Bounds of the current node for workers returning from another node
+    DDSIP_ThreadsNodeBounds (DDSIP_bb->curnode, DDSIP_slotlb, DDSIP_slotub);
+} // DDSIP_ThreadsPrefetch
+
+//==========================================================================
+// Solve the scenario problems concurrently with the settings of the round (DDSIP_roundpara etc.)
+// rest_bound is the bound used for the premature stop, -DDSIP_infty if there is none
+static int
+DDSIP_ThreadsRound (double rest_bound)
+{
+    int i, j, status, started;
+
+    if (DDSIP_param->threads < 2)
+        return 0;
+
+    if (!DDSIP_workers)
+    {
+        DDSIP_noworkers = DDSIP_Imin (DDSIP_param->threads, DDSIP_param->scenarios);
+        DDSIP_workers = (worker_t *) DDSIP_Alloc (sizeof (worker_t), DDSIP_noworkers, "DDSIP_workers(ThreadsLowerBound)");
+        for (i = 0; i < DDSIP_noworkers; i++)
+        {
+            DDSIP_workers[i].values = (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios * DDSIP_bb->total_int, "values(ThreadsLowerBound)");
+            DDSIP_workers[i].beg = (int *) DDSIP_Alloc (sizeof (int), 1, "beg(ThreadsLowerBound)");
+            DDSIP_workers[i].effort = (int *) DDSIP_Alloc (sizeof (int), 1, "effort(ThreadsLowerBound)");
+            DDSIP_workers[i].loaded = DDSIP_AllocLoaded ();
+        }
+        // Slots for the further front nodes only where all nodes are processed by DDSIP_LowerBound
+        DDSIP_noslots = 1 + ((DDSIP_param->riskmod || DDSIP_param->cb) ? 0 : DDSIP_param->threadnodes);
+        DDSIP_results = (result_t *) DDSIP_Alloc (sizeof (result_t), DDSIP_noslots * DDSIP_param->scenarios, "DDSIP_results(ThreadsLowerBound)");
+        for (j = 0; j < DDSIP_noslots * DDSIP_param->scenarios; j++)
+            DDSIP_results[j].mipx = (double *) DDSIP_Alloc (sizeof (double), DDSIP_Imax (DDSIP_bb->novar, DDSIP_bb->firstvar + DDSIP_bb->secvar), "mipx(ThreadsLowerBound)");
+        DDSIP_slotnode = (int *) DDSIP_Alloc (sizeof (int), DDSIP_noslots, "DDSIP_slotnode(ThreadsLowerBound)");
+        DDSIP_slotnext = (int *) DDSIP_Alloc (sizeof (int), DDSIP_noslots, "DDSIP_slotnext(ThreadsLowerBound)");
+        DDSIP_slotinf = (int *) DDSIP_Alloc (sizeof (int), DDSIP_noslots, "DDSIP_slotinf(ThreadsLowerBound)");
+        DDSIP_slotlb = (double *) DDSIP_Alloc (sizeof (double), DDSIP_noslots * DDSIP_bb->firstvar, "DDSIP_slotlb(ThreadsLowerBound)");
+        DDSIP_slotub = (double *) DDSIP_Alloc (sizeof (double), DDSIP_noslots * DDSIP_bb->firstvar, "DDSIP_slotub(ThreadsLowerBound)");
+        for (j = 0; j < DDSIP_noslots; j++)
+            DDSIP_slotnode[j] = -1;
+    }
+    for (j = 0; j < DDSIP_param->scenarios; j++)
+        DDSIP_results[j].solved = 0;
+    DDSIP_nextscen = 0;
+    DDSIP_stopped = 0;
+    DDSIP_infscen = -1;
+
+    if ((status = DDSIP_ThreadsSync ()))
+    {
+        // the scenario problems are solved in the serial loop
+        fprintf (stderr, "ERROR: Failed to prepare the problem copies of the threads, solving serially.\n");
+        fprintf (DDSIP_outfile, "ERROR: Failed to prepare the problem copies of the threads, solving serially.\n");
+        DDSIP_ThreadsFree ();
+        DDSIP_param->threads = 1;
+        return 0;
+    }
+
+    // Premature stop as in the serial loop
+    DDSIP_fathom = (rest_bound > -DDSIP_infty && !DDSIP_param->riskalg && !DDSIP_param->scalarization);
+    DDSIP_roundbound = rest_bound;
+    if ((DDSIP_roundprefetch = (DDSIP_roundprefetch && DDSIP_noslots > 1)))
+        DDSIP_ThreadsPrefetch ();
+
+    started = 0;
+    for (i = 0; i < DDSIP_noworkers; i++)
+    {
+        // DDSIP_ThreadsSync set the bounds of DDSIP_lp
+        DDSIP_workers[i].boundslot = 0;
+        DDSIP_workers[i].status = 0;
+        DDSIP_workers[i].terminate = 0;
+        if (pthread_create (&(DDSIP_workers[i].thread), NULL, DDSIP_ThreadsWorker, DDSIP_workers + i))
+        {
+            fprintf (stderr, "ERROR: Failed to start thread %d\n", i + 1);
+            break;
+        }
+        started++;
+    }
+    for (i = 0; i < started; i++)
+    {
+        pthread_join (DDSIP_workers[i].thread, NULL);
+        if (DDSIP_workers[i].status && DDSIP_param->outlev)
+            fprintf (DDSIP_bb->moreoutfile, "Thread %d stopped with status %d, remaining scenarios are solved serially.\n", i + 1, DDSIP_workers[i].status);
+    }
+    return 0;
+} // DDSIP_ThreadsRound
+
+//==========================================================================
+// Solve the scenario problems for DDSIP_LowerBound concurrently
+// rest_bound is the bound of the father node used for the premature stop
+// Idle workers continue with the scenario problems of further unsolved front nodes (THRNOD)
+int
+DDSIP_ThreadsLowerBound (double rest_bound)
+{
+    DDSIP_roundpara[0].no    = DDSIP_param->cpxnolb;
+    DDSIP_roundpara[0].isdbl = DDSIP_param->cpxlbisdbl;
+    DDSIP_roundpara[0].which = DDSIP_param->cpxlbwhich;
+    DDSIP_roundpara[0].what  = DDSIP_param->cpxlbwhat;
+    DDSIP_roundpara[1].no    = DDSIP_param->cpxnolb2;
+    DDSIP_roundpara[1].isdbl = DDSIP_param->cpxlbisdbl2;
+    DDSIP_roundpara[1].which = DDSIP_param->cpxlbwhich2;
+    DDSIP_roundpara[1].what  = DDSIP_param->cpxlbwhat2;
+    DDSIP_roundbndtol = 5.e-10;
+    DDSIP_roundgap = 0.;
+    DDSIP_roundub = 0;
+    DDSIP_roundprefetch = 1;
+    DDSIP_roundorder = DDSIP_bb->lb_scen_order;
+    DDSIP_roundsub = DDSIP_node[DDSIP_bb->curnode]->subbound;
+    DDSIP_roundlimit = DDSIP_bb->bestvalue * ((DDSIP_bb->bestvalue < 0.)? 1.-2.e-15 :  1.+2.e-15);
+    return DDSIP_ThreadsRound (rest_bound);
+} // DDSIP_ThreadsLowerBound
+
+//==========================================================================
+// Solve the scenario problems of one function evaluation in DDSIP_CBLowerBound concurrently
+// use_LB_params indicates that the CPLEX parameters for lower bounds are used instead of those for the dual method,
+// mipgap > 0 is the relative MIP gap of an inexact evaluation for the 1st optimization
+int
+DDSIP_ThreadsCBLowerBound (int use_LB_params, double mipgap)
+{
+    if (use_LB_params)
+    {
+        DDSIP_roundpara[0].no    = DDSIP_param->cpxnolb;
+        DDSIP_roundpara[0].isdbl = DDSIP_param->cpxlbisdbl;
+        DDSIP_roundpara[0].which = DDSIP_param->cpxlbwhich;
+        DDSIP_roundpara[0].what  = DDSIP_param->cpxlbwhat;
+    }
+    else
+    {
+        DDSIP_roundpara[0].no    = DDSIP_param->cpxnodual;
+        DDSIP_roundpara[0].isdbl = DDSIP_param->cpxdualisdbl;
+        DDSIP_roundpara[0].which = DDSIP_param->cpxdualwhich;
+        DDSIP_roundpara[0].what  = DDSIP_param->cpxdualwhat;
+    }
+    DDSIP_roundpara[1].no = 0;
+    if (DDSIP_param->cpxnodual2 && use_LB_params && DDSIP_param->cpxnolb2)
+    {
+        DDSIP_roundpara[1].no    = DDSIP_param->cpxnolb2;
+        DDSIP_roundpara[1].isdbl = DDSIP_param->cpxlbisdbl2;
+        DDSIP_roundpara[1].which = DDSIP_param->cpxlbwhich2;
+        DDSIP_roundpara[1].what  = DDSIP_param->cpxlbwhat2;
+    }
+    else if (DDSIP_param->cpxnodual2)
+    {
+        DDSIP_roundpara[1].no    = DDSIP_param->cpxnodual2;
+        DDSIP_roundpara[1].isdbl = DDSIP_param->cpxdualisdbl2;
+        DDSIP_roundpara[1].which = DDSIP_param->cpxdualwhich2;
+        DDSIP_roundpara[1].what  = DDSIP_param->cpxdualwhat2;
+    }
+    DDSIP_roundbndtol = 1.e-9;
+    DDSIP_roundgap = mipgap;
+    DDSIP_roundub = 0;
+    DDSIP_roundprefetch = 0;
+    DDSIP_roundorder = DDSIP_bb->lb_scen_order;
+    // No premature stop in the dual method
+    return DDSIP_ThreadsRound (-DDSIP_infty);
+} // DDSIP_ThreadsCBLowerBound
+
+//==========================================================================
+// Evaluate the suggested first-stage solution (already fixed in DDSIP_lp) concurrently for DDSIP_UpperBound
+// rest_bound is the sum of the scenario bounds of the node used for the premature stop, -DDSIP_infty if there is none
+// The workers share the partial sum, when it exceeds the best known value all running optimizations are aborted
+// Scenarios with done[scen] set have a cached result and are left out (done may be NULL)
+int
+DDSIP_ThreadsUpperBound (double rest_bound, int *done)
+{
+    DDSIP_roundpara[0].no    = DDSIP_param->cpxnoub;
+    DDSIP_roundpara[0].isdbl = DDSIP_param->cpxubisdbl;
+    DDSIP_roundpara[0].which = DDSIP_param->cpxubwhich;
+    DDSIP_roundpara[0].what  = DDSIP_param->cpxubwhat;
+    DDSIP_roundpara[1].no    = DDSIP_param->cpxnoub2;
+    DDSIP_roundpara[1].isdbl = DDSIP_param->cpxubisdbl2;
+    DDSIP_roundpara[1].which = DDSIP_param->cpxubwhich2;
+    DDSIP_roundpara[1].what  = DDSIP_param->cpxubwhat2;
+    DDSIP_roundgap = 0.;
+    DDSIP_roundub = 1;
+    DDSIP_rounddone = done;
+    DDSIP_roundprefetch = 0;
+    DDSIP_roundorder = DDSIP_bb->ub_scen_order;
+    if (DDSIP_param->cb)
+        DDSIP_roundsub = DDSIP_node[DDSIP_bb->curnode]->scenBoundsNoLag;
+    else
+        DDSIP_roundsub = DDSIP_node[DDSIP_bb->curnode]->subbound;
+    DDSIP_roundlimit = DDSIP_bb->bestvalue + DDSIP_param->accuracy;
+    return DDSIP_ThreadsRound (rest_bound);
+} // DDSIP_ThreadsUpperBound
+
+//==========================================================================
+// Hand the result of a scenario problem solved by a worker thread to the serial loop
+// Returns 1 if there was a result (which is consumed), 0 otherwise
+int
+DDSIP_ThreadsLBResult (int scen, double *mipx, int *optstatus, int *mipstatus, double *objval, double *bobjval,
+                       int *nodes_1st, int *nodes_2nd, double *time)
+{
+    result_t *res;
+
+    if (!DDSIP_results || !DDSIP_results[scen].solved)
+        return 0;
+    res = DDSIP_results + scen;
+    res->solved = 0;
+    memcpy (mipx, res->mipx, (DDSIP_roundub ? DDSIP_bb->novar : DDSIP_bb->firstvar + DDSIP_bb->secvar) * sizeof (double));
+    *optstatus = res->optstatus;
+    *mipstatus = res->mipstatus;
+    *objval    = res->objval;
+    *bobjval   = res->bobjval;
+    *nodes_1st = res->nodes_1st;
+    *nodes_2nd = res->nodes_2nd;
+    *time      = res->time;
+    return 1;
+} // DDSIP_ThreadsLBResult
+
+//==========================================================================
+// Did the worker threads stop before all scenario problems were solved?
+// Returns 0 if not, -1 if the bound (returned in bound) exceeds the best value,
+// and scen+1 if scenario problem scen is infeasible (has no solution in UpperBound)
+int
+DDSIP_ThreadsLBStopped (double *bound)
+{
+    if (!DDSIP_results || !DDSIP_stopped)
+        return 0;
+    if (DDSIP_infscen >= 0)
+        return DDSIP_infscen + 1;
+    if (DDSIP_fathom && DDSIP_roundbound > DDSIP_roundlimit)
+    {
+        *bound = DDSIP_roundbound;
+        return -1;
+    }
+    return 0;
+} // DDSIP_ThreadsLBStopped
+
+//==========================================================================
+// Discard the results and the stop state of an earlier round. Called by DDSIP_LowerBound, DDSIP_CBLowerBound and
+// DDSIP_UpperBound (full evaluation) before they (possibly) start a round, so a call which starts no round (e.g. a
+// relaxation, a suggestion rejected by the screening) never takes results of another node or suggestion.
+void
+DDSIP_ThreadsRoundReset (void)
+{
+    int scen;
+
+    if (DDSIP_results)
+        for (scen = 0; scen < DDSIP_param->scenarios; scen++)
+            DDSIP_results[scen].solved = 0;
+    DDSIP_stopped = 0;
+    DDSIP_infscen = -1;
+    DDSIP_fathom = 0;
+} // DDSIP_ThreadsRoundReset
+
+//==========================================================================
+// Worker thread of the redundancy check: test the cuts in the copy of the check problem until none is left
+static void *
+DDSIP_ThreadsRedWorker (void *arg)
+{
+    worker_t *w = (worker_t *) arg;
+    int r;
+
+    while (1)
+    {
+        pthread_mutex_lock (&DDSIP_threadlock);
+        if (DDSIP_killsignal || (r = DDSIP_rednext) >= DDSIP_rednocuts)
+        {
+            pthread_mutex_unlock (&DDSIP_threadlock);
+            break;
+        }
+        DDSIP_rednext++;
+        pthread_mutex_unlock (&DDSIP_threadlock);
+        if (DDSIP_RedundancyTest (w->env, w->redlp, r, DDSIP_redobj + r))
+            DDSIP_redobj[r] = -DDSIP_infty;
+    }
+    return NULL;
+} // DDSIP_ThreadsRedWorker
+
+//==========================================================================
+// Test the cuts 0..nocuts-1 of the redundancy check problem red (see DDSIP_CheckRedundancy) concurrently,
+// objval[r] returns the optimal value of the test of cut r (-DDSIP_infty if it failed).
+// The copies of the workers are renewed when the revision of red changed and start from its basis,
+// the basis of the first copy is handed back to red afterwards.
+// Returns 1 if the workers are not available (the tests have to be done serially)
+int
+DDSIP_ThreadsRedundancy (CPXLPptr red, int revision, int nocuts, double *objval)
+{
+    int i, r, status = 0, started = 0, written = 0, norows, nocols, hasbase;
+    int *cstat, *rstat;
+    char fname[DDSIP_ln_fname];
+
+    if (!DDSIP_workers)
+        return 1;
+    for (i = 0; i < DDSIP_noworkers; i++)
+        if (!DDSIP_workers[i].env)
+            return 1;
+
+    nocols = CPXgetnumcols (DDSIP_env, red);
+    norows = CPXgetnumrows (DDSIP_env, red);
+    cstat = (int *) DDSIP_Alloc (sizeof (int), nocols, "cstat(ThreadsRedundancy)");
+    rstat = (int *) DDSIP_Alloc (sizeof (int), norows, "rstat(ThreadsRedundancy)");
+    hasbase = !CPXgetbase (DDSIP_env, red, cstat, rstat);
+    sprintf (fname, "%s/redundancy_copy.sav", DDSIP_outdir);
+    for (i = 0; i < DDSIP_noworkers; i++)
+    {
+        if (DDSIP_workers[i].redlp && DDSIP_workers[i].redrevision == revision)
+            continue;
+        if (!written && (status = CPXwriteprob (DDSIP_env, red, fname, "SAV")))
+        {
+            fprintf (stderr, "ERROR: Failed to write problem copy %s (ThreadsRedundancy)\n", fname);
+            goto TERMINATE;
+        }
+        written = 1;
+        if (DDSIP_workers[i].redlp)
+            CPXfreeprob (DDSIP_workers[i].env, &(DDSIP_workers[i].redlp));
+        DDSIP_workers[i].redlp = CPXcreateprob (DDSIP_workers[i].env, &status, "DDSIP_redundancy");
+        if (!DDSIP_workers[i].redlp || (status = CPXreadcopyprob (DDSIP_workers[i].env, DDSIP_workers[i].redlp, fname, NULL)))
+        {
+            fprintf (stderr, "ERROR: Failed to read problem copy %s for thread %d\n", fname, i + 1);
+            if (DDSIP_workers[i].redlp)
+                CPXfreeprob (DDSIP_workers[i].env, &(DDSIP_workers[i].redlp));
+            status = 1;
+            goto TERMINATE;
+        }
+        if (hasbase)
+            CPXcopybase (DDSIP_workers[i].env, DDSIP_workers[i].redlp, cstat, rstat);
+        DDSIP_workers[i].redrevision = revision;
+    }
+
+    for (r = 0; r < nocuts; r++)
+        objval[r] = -DDSIP_infty;
+    DDSIP_rednext = 0;
+    DDSIP_rednocuts = nocuts;
+    DDSIP_redobj = objval;
+    for (i = 0; i < DDSIP_noworkers; i++)
+    {
+        DDSIP_workers[i].terminate = 0;
+        if (pthread_create (&(DDSIP_workers[i].thread), NULL, DDSIP_ThreadsRedWorker, DDSIP_workers + i))
+        {
+            fprintf (stderr, "ERROR: Failed to start thread %d\n", i + 1);
+            break;
+        }
+        started++;
+    }
+    for (i = 0; i < started; i++)
+        pthread_join (DDSIP_workers[i].thread, NULL);
+    // cuts left by threads which could not be started
+    for (r = DDSIP_rednext; r < nocuts && !DDSIP_killsignal; r++)
+        if (DDSIP_RedundancyTest (DDSIP_env, red, r, objval + r))
+            objval[r] = -DDSIP_infty;
+    if (started && !CPXgetbase (DDSIP_workers[0].env, DDSIP_workers[0].redlp, cstat, rstat))
+        CPXcopybase (DDSIP_env, red, cstat, rstat);
+
+TERMINATE:
+    if (written)
+        remove (fname);
+    DDSIP_Free ((void **) &(cstat));
+    DDSIP_Free ((void **) &(rstat));
+    return status ? 1 : 0;
+} // DDSIP_ThreadsRedundancy
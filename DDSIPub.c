@@ -32,6 +32,16 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA */
 static int DDSIP_PrintModFileUb (int);
 static int DDSIP_WarmUb (void);
 static int DDSIP_GetCpxSolution (int, double *, double *, double *);
+static void DDSIP_SugHashAdd (sug_t *);
+static ubcache_t * DDSIP_UBCacheGet (double *);
+static double DDSIP_UBCacheLag (ubcache_t *, int);
+static int DDSIP_UBPrepare (int *);
+static void DDSIP_UBFixedValues (const double *, double *);
+static int DDSIP_UBFix (const double *, int);
+static int DDSIP_UBScreen (ubcache_t *, int *, int *);
+
+// state of the random numbers drawn in DDSIP_UBScreen
+static unsigned int DDSIP_ubseed = 1;
 
 //==========================================================================
 // Print lp file
@@ -211,15 +221,333 @@ DDSIP_GetCpxSolution (int mipstatus, double *objval, double *bobjval, double *mi
     return status;
 }
 
+//==========================================================================
+// Set the CPLEX parameters and the objective for the scenario problems of the upper bound,
+// fs returns the number of first-stage variables to be fixed
+static int
+DDSIP_UBPrepare (int *fs)
+{
+    int j, status;
+    int *index;
+
+    status = DDSIP_SetCpxPara (DDSIP_param->cpxnoub, DDSIP_param->cpxubisdbl, DDSIP_param->cpxubwhich, DDSIP_param->cpxubwhat);
+    if (status)
+    {
+        fprintf (stderr, "ERROR: Failed to set CPLEX parameters (UB) \n");
+        return status;
+    }
+    if (!DDSIP_param->scalarization)
+    {
+        // Delete risk objective and retain objective of expected value problem
+        if (DDSIP_param->riskvar)
+            DDSIP_DeleteRiskObj ();
+
+        // Some of the dual risk measures (WC, TVaR) require additional first-stage variables which need not to be
+        // fixed. Therefore ...
+        *fs = DDSIP_bb->firstvar;
+        if ((abs (DDSIP_param->riskmod) == 4 || abs (DDSIP_param->riskmod) == 5) && !DDSIP_param->riskalg)
+            *fs = DDSIP_bb->firstvar - 1;
+    }
+    else
+        *fs = DDSIP_bb->firstvar;
+
+    // Change objective to the original one
+    index = (int *) DDSIP_Alloc (sizeof (int), DDSIP_data->novar, "index,Newobj");
+    for (j = 0; j < DDSIP_data->novar; j++)
+        index[j] = j;
+    status = CPXchgobj (DDSIP_env, DDSIP_lp, DDSIP_data->novar, index, DDSIP_data->cost + DDSIP_param->scenarios * DDSIP_param->stoccost);
+    DDSIP_InvalidateLoaded (DDSIP_bb->loaded);
+    DDSIP_Free ((void **) &(index));
+    if (status)
+        fprintf (stderr, "ERROR: Failed to change objective \n");
+    return status;
+} // DDSIP_UBPrepare
+
+//==========================================================================
+// Values the suggested first-stage solution firstval is fixed to: integers rounded, continuous variables
+// within the original bounds, everything within the bounds of the current node
+static void
+DDSIP_UBFixedValues (const double *firstval, double *values)
+{
+    int j, k;
+
+    for(j=0; j<DDSIP_bb->firstvar; j++)
+    {
+        if (DDSIP_bb->firsttype[j] == 'B' || DDSIP_bb->firsttype[j] == 'I' || DDSIP_bb->firsttype[j] == 'N')
+            values[j] = (int) floor(firstval[j] + 0.5);
+        else
+        {
+            values[j] = DDSIP_Dmax (DDSIP_bb->lborg[j],firstval[j]);
+            values[j] = DDSIP_Dmin (DDSIP_bb->uborg[j],values[j]);
+        }
+        for (k = 0; k < DDSIP_bb->curbdcnt; k++)
+        {
+            if (DDSIP_bb->curind[k] == j)
+            {
+                values[j] = DDSIP_Dmax (values[j], DDSIP_bb->curlb[k]);
+                values[j] = DDSIP_Dmin (values[j], DDSIP_bb->curub[k]);
+            }
+        }
+    }
+} // DDSIP_UBFixedValues
+
+//==========================================================================
+// Fix the first fs first-stage variables to values in DDSIP_lp
+static int
+DDSIP_UBFix (const double *values, int fs)
+{
+    int j, status;
+    double *lb, *ub;
+
+    // Upper bounds - first-stage variables are fixed, so values are the same
+    // A first-stage variable not fixed (risk models) gets its original bounds, DDSIP_lp may contain the bounds of the node
+    lb = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "lb(UpperBound)");
+    ub = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "ub(UpperBound)");
+    memcpy (lb, values, sizeof (double) * fs);
+    memcpy (ub, values, sizeof (double) * fs);
+    for (j = fs; j < DDSIP_bb->firstvar; j++)
+    {
+        lb[j] = DDSIP_bb->lborg[j];
+        ub[j] = DDSIP_bb->uborg[j];
+    }
+    status = DDSIP_ChgFirstBounds (lb, ub);
+    DDSIP_Free ((void **) &(lb));
+    DDSIP_Free ((void **) &(ub));
+    if (status)
+        fprintf (stderr, "ERROR: Failed to change bounds \n");
+    return status;
+} // DDSIP_UBFix
+
+//==========================================================================
+// Enter the evaluated suggestion sug into the hash table of suggestions, doubling the number of buckets
+// when the table gets filled
+static void
+DDSIP_SugHashAdd (sug_t *sug)
+{
+    int i;
+    sug_t **head, *tmp, *next;
+
+    if (DDSIP_bb->sugcnt >= DDSIP_bb->sughashsize)
+    {
+        head = (sug_t **) DDSIP_Alloc (sizeof (sug_t *), 2 * DDSIP_bb->sughashsize, "sughead(SugHashAdd)");
+        for (i = 0; i < DDSIP_bb->sughashsize; i++)
+        {
+            for (tmp = DDSIP_bb->sughead[i]; tmp; tmp = next)
+            {
+                next = tmp->hashnext;
+                tmp->hashnext = head[tmp->hash & (2 * DDSIP_bb->sughashsize - 1)];
+                head[tmp->hash & (2 * DDSIP_bb->sughashsize - 1)] = tmp;
+            }
+        }
+        DDSIP_Free ((void **) &(DDSIP_bb->sughead));
+        DDSIP_bb->sughead = head;
+        DDSIP_bb->sughashsize *= 2;
+    }
+    sug->hash = DDSIP_FirstHash (sug->firstval, NULL);
+    sug->hashnext = DDSIP_bb->sughead[sug->hash & (DDSIP_bb->sughashsize - 1)];
+    DDSIP_bb->sughead[sug->hash & (DDSIP_bb->sughashsize - 1)] = sug;
+    DDSIP_bb->sugcnt++;
+} // DDSIP_SugHashAdd
+
+//==========================================================================
+// Cache entry for the scenario results of the fixed first-stage solution firstval
+// A suggestion not in the cache replaces the least recently used one, the entry is moved to the front
+// Results are kept for the whole run, so a suggestion proposed again or evaluated only partially before
+// (premature stop) needs only the scenario problems not yet solved. NULL if there is no cache (DDSIP_ubcachemem).
+static ubcache_t *
+DDSIP_UBCacheGet (double *firstval)
+{
+    int j;
+    unsigned int hash;
+    ubcache_t *c;
+
+    if (!DDSIP_bb->ubcachecap)
+        return NULL;
+    hash = DDSIP_FirstHash (firstval, NULL);
+    for (c = DDSIP_bb->ubcachefirst; c; c = c->next)
+    {
+        if (c->firstval && c->hash == hash)
+        {
+            for (j = 0; j < DDSIP_bb->firstvar && c->firstval[j] == firstval[j]; j++)
+                ;
+            if (j == DDSIP_bb->firstvar)
+                break;
+        }
+    }
+    if (!c)
+    {
+        c = DDSIP_bb->ubcachelast;
+        if (!c->firstval)
+        {
+            c->firstval = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "firstval(UBCacheGet)");
+            c->done = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "done(UBCacheGet)");
+            c->mipstatus = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "mipstatus(UBCacheGet)");
+            c->objval = (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios, "objval(UBCacheGet)");
+            c->bobjval = (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios, "bobjval(UBCacheGet)");
+            c->mipx = (double **) DDSIP_Alloc (sizeof (double *), DDSIP_param->scenarios, "mipx(UBCacheGet)");
+        }
+        else if (DDSIP_param->outlev > 20)
+            fprintf (DDSIP_bb->moreoutfile, " ### replacing least recently used entry of the cache of upper bound results\n");
+        memcpy (c->firstval, firstval, sizeof (double) * DDSIP_bb->firstvar);
+        memset (c->done, 0, sizeof (int) * DDSIP_param->scenarios);
+        c->hash = hash;
+    }
+    if (c != DDSIP_bb->ubcachefirst)
+    {
+        c->prev->next = c->next;
+        if (c->next)
+            c->next->prev = c->prev;
+        else
+            DDSIP_bb->ubcachelast = c->prev;
+        c->prev = NULL;
+        c->next = DDSIP_bb->ubcachefirst;
+        DDSIP_bb->ubcachefirst->prev = c;
+        DDSIP_bb->ubcachefirst = c;
+    }
+    return c;
+} // DDSIP_UBCacheGet
+
+//==========================================================================
+// Contribution of the Lagrangean cost terms to the objective of scenario scen for the first-stage solution of the
+// cache entry c. DDSIP_ChgProb adds them to the first-stage costs in the solve step only (not in the dual, adv and
+// eev steps), and the multipliers change, so the cache keeps the values without them: the contribution is
+// subtracted when a result is stored and added when a result is taken from the cache.
+static double
+DDSIP_UBCacheLag (ubcache_t *c, int scen)
+{
+    double d = 0.;
+#ifdef CONIC_BUNDLE
+    int i;
+
+    if (DDSIP_param->cb && DDSIP_bb->DDSIP_step == solve)
+        for (i = 0; i < DDSIP_bb->firstvar; i++)
+            d += DDSIP_bb->lagcost[scen * DDSIP_bb->firstvar + i] * c->firstval[i];
+#endif
+    return d;
+} // DDSIP_UBCacheLag
+
+//==========================================================================
+// Screen the suggested solution on a stratified sample of the scenarios. The scenarios are sorted by their
+// lower bounds in the node and divided into UBSAMP/2 strata, from each stratum two scenarios are drawn with
+// probabilities proportional to the scenario probabilities. The expectation of the lower bounds plus the
+// estimated excess over them estimates the objective value, reject is set if this estimate minus UBCONF
+// times its standard deviation exceeds the best known value. solved returns the number of problems solved.
+static int
+DDSIP_UBScreen (ubcache_t *ubc, int *reject, int *solved)
+{
+    int status = 0, mipstatus, h, j, l, m, beg, end, scen;
+    double lbsum = 0., est = 0., var = 0., ph, u, objval, bobjval, d[2];
+    double *lb, *excess;
+    int *order;
+
+    *reject = *solved = 0;
+    m = DDSIP_Imax (1, DDSIP_param->ubsample / 2);
+    lb = (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios, "lb(UBScreen)");
+    excess = (double *) DDSIP_Alloc (sizeof (double), DDSIP_param->scenarios, "excess(UBScreen)");
+    order = (int *) DDSIP_Alloc (sizeof (int), DDSIP_param->scenarios, "order(UBScreen)");
+    for (scen = 0; scen < DDSIP_param->scenarios; scen++)
+    {
+        // the same bounds as in rest_bound of UpperBound
+        if (DDSIP_param->cb)
+            lb[scen] = (DDSIP_node[DDSIP_bb->curnode]->scenBoundsNoLag)[scen];
+        else
+            lb[scen] = (DDSIP_node[DDSIP_bb->curnode]->subbound)[scen];
+        if (!(lb[scen] > -DDSIP_infty))
+            goto TERMINATE;
+        lbsum += DDSIP_data->prob[scen] * lb[scen];
+        excess[scen] = -1.;
+        order[scen] = scen;
+    }
+    DDSIP_qsort_ins_D (lb, order, 0, DDSIP_param->scenarios - 1);
+
+    for (h = 0; h < m; h++)
+    {
+        beg = (h * DDSIP_param->scenarios) / m;
+        end = ((h + 1) * DDSIP_param->scenarios) / m;
+        ph = 0.;
+        for (j = beg; j < end; j++)
+            ph += DDSIP_data->prob[order[j]];
+        for (l = 0; l < 2; l++)
+        {
+            DDSIP_ubseed = DDSIP_ubseed * 1103515245u + 12345u;
+            u = ph * (DDSIP_ubseed >> 8) / 16777216.;
+            for (j = beg; j < end - 1 && u >= DDSIP_data->prob[order[j]]; j++)
+                u -= DDSIP_data->prob[order[j]];
+            scen = order[j];
+            if (excess[scen] < 0.)
+            {
+                if (ubc && ubc->done[scen])
+                    bobjval = ubc->bobjval[scen] + DDSIP_UBCacheLag (ubc, scen);
+                else
+                {
+                    if ((status = DDSIP_ChgProb (scen, 0)))
+                    {
+                        fprintf (stderr, "ERROR: Failed to change problem (UBScreen)\n");
+                        goto TERMINATE;
+                    }
+                    DDSIP_bb->scenUBIters++;
+                    (*solved)++;
+                    status = CPXmipopt (DDSIP_env, DDSIP_lp);
+                    if (DDSIP_Error (status))
+                    {
+                        fprintf (stderr, "ERROR: Failed to optimize (UBScreen)\n");
+                        goto TERMINATE;
+                    }
+                    status = 0;
+                    mipstatus = CPXgetstat (DDSIP_env, DDSIP_lp);
+                    // infeasibility is left to the evaluation in UpperBound
+                    if (DDSIP_NoSolution (mipstatus))
+                        goto TERMINATE;
+                    if ((status = CPXgetbestobjval (DDSIP_env, DDSIP_lp, &bobjval)))
+                    {
+                        fprintf (stderr, "ERROR: Failed to get value of best remaining node (UBScreen)\n");
+                        goto TERMINATE;
+                    }
+                    // the evaluation in UpperBound takes optimal results from the cache
+                    if (ubc && (mipstatus == CPXMIP_OPTIMAL || mipstatus == CPXMIP_OPTIMAL_TOL))
+                    {
+                        if (!ubc->mipx[scen])
+                            ubc->mipx[scen] = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->novar, "mipx(UBScreen)");
+                        if ((status = DDSIP_GetCpxSolution (mipstatus, &objval, &bobjval, ubc->mipx[scen])))
+                        {
+                            fprintf (stderr, "ERROR: Failed to get solution (UBScreen)\n");
+                            goto TERMINATE;
+                        }
+                        ubc->done[scen] = 1;
+                        ubc->mipstatus[scen] = mipstatus;
+                        ubc->objval[scen] = objval - DDSIP_UBCacheLag (ubc, scen);
+                        ubc->bobjval[scen] = bobjval - DDSIP_UBCacheLag (ubc, scen);
+                    }
+                }
+                excess[scen] = DDSIP_Dmax (bobjval - lb[scen], 0.);
+            }
+            d[l] = excess[scen];
+        }
+        est += ph * 0.5 * (d[0] + d[1]);
+        var += ph * ph * 0.25 * (d[0] - d[1]) * (d[0] - d[1]);
+    }
+    est += lbsum;
+    *reject = (est - DDSIP_param->ubconfidence * sqrt (var) > DDSIP_bb->bestvalue + DDSIP_param->accuracy);
+    if (DDSIP_param->outlev)
+        fprintf (DDSIP_bb->moreoutfile, "Screening on %d strata (%d problems solved): estimate %.16g, std. deviation %g%s\n",
+                 m, *solved, est, sqrt (var), *reject ? " - rejected" : "");
+
+TERMINATE:
+    DDSIP_Free ((void **) &(lb));
+    DDSIP_Free ((void **) &(excess));
+    DDSIP_Free ((void **) &(order));
+    return status;
+} // DDSIP_UBScreen
+
 //==========================================================================
 // We check if the suggested solution has already occured (return 1)
 int
 DDSIP_SolChk (double* cutViolation, int test_equality)
 {
     int i, cnt = 0;
+    unsigned int hash;
     double lhs;
-    cutpool_t *currentCut;
-    sug_t *tmp;
+    sug_t *tmp, *cand;
 
     *cutViolation = 0.;
     if (DDSIP_param->outlev >= 50)
@@ -232,163 +560,87 @@ DDSIP_SolChk (double* cutViolation, int test_equality)
         {
             if (DDSIP_bb->firsttype[i] == 'B' || DDSIP_bb->firsttype[i] == 'I' || DDSIP_bb->firsttype[i] == 'N')
             {
-                ih = (int) floor ((DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[i] + 0.5);
+                ih = (int) floor ((DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[i] + 0.5);
                 fprintf (DDSIP_bb->moreoutfile, " %21d,", ih);
             }
             else
-                fprintf (DDSIP_bb->moreoutfile, " %21.15g,", (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[i]);
+                fprintf (DDSIP_bb->moreoutfile, " %21.15g,", (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[i]);
 
             if (!((i + 1) % 5))
                 fprintf (DDSIP_bb->moreoutfile, "\n");
         }
         fprintf (DDSIP_bb->moreoutfile, "\n");
     }
-    // Check for multiple suggestion
-    if (DDSIP_bb->sug[DDSIP_bb->curnode])
+    // Check for multiple suggestion: the candidates are the entries with the same hash value in the hash table
+    // of evaluated suggestions. With test_equality the components have to agree exactly, with test_equality == 2
+    // a suggestion evaluated in the current node does not count.
+    // In case of asd the target (expected value) most probably has changed from the former nodes, so only
+    // suggestions of the current node count.
+    cand = DDSIP_bb->sug[DDSIP_bb->nodecap];
+    hash = DDSIP_FirstHash (cand->firstval, NULL);
+    for (tmp = DDSIP_bb->sughead[hash & (DDSIP_bb->sughashsize - 1)]; tmp; tmp = tmp->hashnext)
     {
-        tmp = (DDSIP_bb->sug[DDSIP_bb->curnode]);
+        if (tmp->hash != hash || tmp == cand)
+            continue;
+        if (tmp->node == DDSIP_bb->curnode ? test_equality == 2 : DDSIP_param->riskmod == 3)
+            continue;
+        cnt = 0;
         if (test_equality)
+            while (cnt < DDSIP_bb->firstvar && cand->firstval[cnt] == tmp->firstval[cnt])
+                cnt++;
+        else
+            while (cnt < DDSIP_bb->firstvar && DDSIP_Equal (cand->firstval[cnt], tmp->firstval[cnt]))
+                cnt++;
+        // solution occurred previously ?
+        if (cnt == DDSIP_bb->firstvar)
         {
-            do
+            if (tmp->node == DDSIP_bb->curnode)
             {
-                cnt = 0;
-                while (cnt < DDSIP_bb->firstvar && (DDSIP_bb->sug[DDSIP_param->nodelim + 2])->firstval[cnt] == tmp->firstval[cnt])
-                {
-                    cnt++;
-                }
-                // solution occurred previously ?
-                if (cnt == DDSIP_bb->firstvar)
-                {
-		    if (test_equality < 2)
-                    {
-                        if (DDSIP_param->outlev)
-                            fprintf (DDSIP_bb->moreoutfile, "... multiple suggestion (same node).\n");
-                        if (DDSIP_param->cpxscr || DDSIP_param->outlev > 10)
-                            printf ("... multiple suggestion (same node).\n");
-			if (test_equality != 2)
-                            DDSIP_bb->skip = 4;
-                        return 0;
-                    }
-                }
-                tmp = tmp->next;
+                if (DDSIP_param->outlev)
+                    fprintf (DDSIP_bb->moreoutfile, "... multiple suggestion (same node).\n");
+                if (DDSIP_param->cpxscr || DDSIP_param->outlev > 10)
+                    printf ("... multiple suggestion (same node).\n");
             }
-            while (tmp);
-        }
-        else
-        {
-            do
+            else
             {
-                cnt = 0;
-                while (cnt < DDSIP_bb->firstvar && DDSIP_Equal ((DDSIP_bb->sug[DDSIP_param->nodelim + 2])->firstval[cnt], tmp->firstval[cnt]))
-                {
-                    cnt++;
-                }
-                // solution occurred previously ?
-                if (cnt == DDSIP_bb->firstvar)
-                {
-                    if (DDSIP_param->outlev)
-                        fprintf (DDSIP_bb->moreoutfile, "... multiple suggestion (same node).\n");
-                    if (DDSIP_param->cpxscr || DDSIP_param->outlev > 10)
-                        printf ("... multiple suggestion (same node).\n");
-                    if (test_equality != 2)
-                        DDSIP_bb->skip = 4;
-                    return 0;
-                }
-                tmp = tmp->next;
+                if (DDSIP_param->outlev)
+                    fprintf (DDSIP_bb->moreoutfile, "... multiple suggestion (node %d).\n", tmp->node);
+                if (DDSIP_param->cpxscr || DDSIP_param->outlev > 10)
+                    printf ("... multiple suggestion (node %d).\n", tmp->node);
             }
-            while (tmp);
-        }
-    }
-    // in case of asd the target (expected value) most probably has changed from the former nodes. An identical proposal has to be checked, too
-    if (DDSIP_param->riskmod != 3)
-    {
-        for (i = 0; i < DDSIP_bb->nonode; i++)
-        {
-            if (DDSIP_bb->curnode != i && DDSIP_param->nodelim + 2 != i)
+            // the objective value of the former evaluation is the value of the heuristic
+            if (tmp->objval < DDSIP_infty)
             {
-                if (DDSIP_bb->sug[i])
-                {
-                    tmp = DDSIP_bb->sug[i];
-                    if (test_equality)
-                    {
-                        do
-                        {
-                            cnt = 0;
-                            while (cnt < DDSIP_bb->firstvar && ((DDSIP_bb->sug[DDSIP_param->nodelim + 2])->firstval[cnt] == tmp->firstval[cnt]))
-                            {
-                                cnt++;
-                            }
-                            // solution occurred previously ?
-                            if (cnt == DDSIP_bb->firstvar)
-                            {
-                                if (DDSIP_param->outlev)
-                                    fprintf (DDSIP_bb->moreoutfile, "... multiple suggestion (node %d).\n", i);
-                                if (DDSIP_param->cpxscr || DDSIP_param->outlev > 10)
-                                    printf ("... multiple suggestion (node %d).\n", i);
-                                if (test_equality != 2)
-                                    DDSIP_bb->skip = 4;
-                                return 0;
-                            }
-                            tmp = tmp->next;
-                        }
-                        while (tmp);
-                    }
-                    else
-                    {
-                        do
-                        {
-                            cnt = 0;
-                            while (cnt < DDSIP_bb->firstvar && DDSIP_Equal ((DDSIP_bb->sug[DDSIP_param->nodelim + 2])->firstval[cnt], tmp->firstval[cnt]))
-                            {
-                                cnt++;
-                            }
-                            // solution occurred previously ?
-                            if (cnt == DDSIP_bb->firstvar)
-                            {
-                                if (DDSIP_param->outlev)
-                                    fprintf (DDSIP_bb->moreoutfile, "... multiple suggestion (node %d).\n", i);
-                                if (DDSIP_param->cpxscr || DDSIP_param->outlev > 10)
-                                    printf ("... multiple suggestion (node %d).\n", i);
-                                if (test_equality != 2)
-                                    DDSIP_bb->skip = 4;
-                                return 0;
-                            }
-                            tmp = tmp->next;
-                        }
-                        while (tmp);
-                    }
-                }
+                if (DDSIP_param->outlev > 10)
+                    fprintf (DDSIP_bb->moreoutfile, "... known objective value %.16g\n", tmp->objval);
+                DDSIP_bb->heurval = DDSIP_Dmin (tmp->objval, DDSIP_bb->heurval);
             }
+            if (test_equality != 2)
+                DDSIP_bb->skip = 4;
+            return 0;
         }
     }
 
     // if cuts have been inserted test for violation
-    if (DDSIP_bb->cutpool)
+    if (DDSIP_bb->cutpool.cnt)
     {
-        currentCut = DDSIP_bb->cutpool;
-        while (currentCut)
+        DDSIP_CutPoolCheck (1, &((DDSIP_bb->sug[DDSIP_bb->nodecap])->firstval), 0., 1.e-9, &i, &lhs);
+        if (i >= 0)
         {
-            lhs = 0.;
-            for (i = 0; i < DDSIP_bb->firstvar; i++)
-            {
-                lhs += (DDSIP_bb->sug[DDSIP_param->nodelim + 2])->firstval[i] * currentCut->matval[i];
-            }
-            if (lhs < currentCut->rhs - 1.e-9*fabs(currentCut->rhs))
+            *cutViolation = lhs;
+            if (DDSIP_param->outlev)
+                fprintf (DDSIP_bb->moreoutfile, "... violates cut %d, violation %g.\n", DDSIP_bb->cutpool.number[i], *cutViolation);
+            if (DDSIP_param->cpxscr || DDSIP_param->outlev > 10)
+                printf ("... violates cut %d.\n", DDSIP_bb->cutpool.number[i]);
+            // a cut moved out of the problem due to inactivity is needed again
+            if (i >= DDSIP_bb->cutCntr)
+                DDSIP_CutPoolReAdd (i);
+            if (!(DDSIP_param->testOtherScens) || DDSIP_bb->curnode > 6 /* || DDSIP_param->heuristic < 3 */)
             {
-                *cutViolation = currentCut->rhs - lhs;
-                if (DDSIP_param->outlev)
-                    fprintf (DDSIP_bb->moreoutfile, "... violates cut %d, violation %g.\n", currentCut->number, *cutViolation);
-                if (DDSIP_param->cpxscr || DDSIP_param->outlev > 10)
-                    printf ("... violates cut %d.\n", currentCut->number);
-                if (!(DDSIP_param->testOtherScens) || DDSIP_bb->curnode > 6 /* || DDSIP_param->heuristic < 3 */)
-                {
-                    if (test_equality != 2)
-                        DDSIP_bb->skip = 4;
-                    return 0;
-                }
-                break;
+                if (test_equality != 2)
+                    DDSIP_bb->skip = 4;
+                return 0;
             }
-            currentCut = currentCut->prev;
         }
     }
 
@@ -405,17 +657,18 @@ DDSIP_UpperBound (int nrScenarios, int feasCheckOnly)
 {
     int status, scen, iscen, mipstatus = 0, nr;
     int i, j, k, Bi, Bs, fs, prematureStop = 0;
-    int *index;
     int wall_hrs, wall_mins,cpu_hrs, cpu_mins;
     int nodes_1st, nodes_2nd, timeLimit = 0;
+    int threadres = 0, cached = 0;
+    ubcache_t *ubc = NULL;
 
     double tmpbestvalue = 0., tmpfeasbound = 0., rest_bound, tmprisk = 0., tmprisk4 = -DDSIP_infty, tmpprob = 0.;
     double security_factor, bobjval, objval, time_start, time_end, time_lap, wall_secs, cpu_secs, gap, meanGap;
 
-    double *mipx, *values;
+    double *mipx, *values = NULL;
     double *subsol;
 
-    double we, wr, d, mipgap, oldviol = DDSIP_infty, viol;
+    double we, wr, d, mipgap, oldviol = DDSIP_infty, viol, sugval = DDSIP_infty, cutoff, oldcutoff;
     double rhs;
 #ifdef DEACTIVATECUTS
     double *cutrhs, *deactivatedrhs;
@@ -432,7 +685,7 @@ DDSIP_UpperBound (int nrScenarios, int feasCheckOnly)
         DDSIP_bb->curnode = 0;
         if (DDSIP_bb->DDSIP_step == adv && abs(DDSIP_param->riskmod) == 4)
         {
-            (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[DDSIP_data->firstvar] = 1.e10;
+            (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[DDSIP_data->firstvar] = 1.e10;
         }
     }
 
@@ -469,11 +722,11 @@ DDSIP_UpperBound (int nrScenarios, int feasCheckOnly)
         {
             if (DDSIP_bb->firsttype[j] == 'B' || DDSIP_bb->firsttype[j] == 'I' || DDSIP_bb->firsttype[j] == 'N')
             {
-                ih = (int) floor ((DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[j] + 0.5);
+                ih = (int) floor ((DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[j] + 0.5);
                 fprintf (DDSIP_bb->moreoutfile, " %21d", ih);
             }
             else
-                fprintf (DDSIP_bb->moreoutfile, " %21.15g", (DDSIP_bb->sug[DDSIP_param->nodelim + 2]->firstval)[j]);
+                fprintf (DDSIP_bb->moreoutfile, " %21.15g", (DDSIP_bb->sug[DDSIP_bb->nodecap]->firstval)[j]);
 
             if (!((j + 1) % 5))
                 fprintf (DDSIP_bb->moreoutfile, "\n");
@@ -497,74 +750,14 @@ DDSIP_UpperBound (int nrScenarios, int feasCheckOnly)
             fprintf (DDSIP_bb->moreoutfile, "Evaluating first-stage solution (Upper bounds):\n");
     }
 
-    status = DDSIP_SetCpxPara (DDSIP_param->cpxnoub, DDSIP_param->cpxubisdbl, DDSIP_param->cpxubwhich, DDSIP_param->cpxubwhat);
-    if (status)
-    {
-        fprintf (stderr, "ERROR: Failed to set CPLEX parameters (UB) \n");
+    if ((status = DDSIP_UBPrepare (&fs)))
         goto TERMINATE;
-    }
-    if (!DDSIP_param->scalarization)
-    {
-        // Delete risk objective and retain objective of expected value problem
-        if (DDSIP_param->riskvar)
-            DDSIP_DeleteRiskObj ();
-
-        // Some of the dual risk measures (WC, TVaR) require additional first-stage variables which need not to be
-        // fixed. Therefore ...
-        fs = DDSIP_bb->firstvar;
-        if ((abs (DDSIP_param->riskmod) == 4 || abs (DDSIP_param->riskmod) == 5) && !DDSIP_param->riskalg)
-            fs = DDSIP_bb->firstvar - 1;
-    }
-    else
-        fs = DDSIP_bb->firstvar;
-
-    // Change objective to the original one
-    index = (int *) DDSIP_Alloc (sizeof (int), DDSIP_data->novar, "index,Newobj");
-    for (j = 0; j < DDSIP_data->novar; j++)
-        index[j] = j;
-    status = CPXchgobj (DDSIP_env, DDSIP_lp, DDSIP_data->novar, index, DDSIP_data->cost + DDSIP_param->scenarios * DDSIP_param->stoccost);
-    if (status)
-    {
-        fprintf (stderr, "ERROR: Failed to change objective \n");
-        goto TERMINATE;
-    }
-    DDSIP_Free ((void **) &(index));
-    /* */
     // Heuristic returns suggested solution
     // Fix first stage variables to these values
-    // Lower bounds
     values = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "values(UpperBound)");
-    for(j=0; j<DDSIP_bb->firstvar; j++)
-    {
-        if (DDSIP_bb->firsttype[j] == 'B' || DDSIP_bb->firsttype[j] == 'I' || DDSIP_bb->firsttype[j] == 'N')
-            values[j] = (int) floor((DDSIP_bb->sug[DDSIP_param->nodelim + 2])->firstval[j] + 0.5);
-        else
-        {
-            values[j] = DDSIP_Dmax (DDSIP_bb->lborg[j],(DDSIP_bb->sug[DDSIP_param->nodelim + 2])->firstval[j]);
-            values[j] = DDSIP_Dmin (DDSIP_bb->uborg[j],values[j]);
-        }
-        for (k = 0; k < DDSIP_bb->curbdcnt; k++)
-        {
-            if (DDSIP_bb->curind[k] == j)
-            {
-                values[j] = DDSIP_Dmax (values[j], DDSIP_bb->curlb[k]);
-                values[j] = DDSIP_Dmin (values[j], DDSIP_bb->curub[k]);
-            }
-        }
-    }
-    status = CPXchgbds (DDSIP_env, DDSIP_lp, fs, DDSIP_bb->firstindex, DDSIP_bb->lbident, values);
-    if (status)
-    {
-        fprintf (stderr, "ERROR: Failed to change bounds \n");
+    DDSIP_UBFixedValues ((DDSIP_bb->sug[DDSIP_bb->nodecap])->firstval, values);
+    if ((status = DDSIP_UBFix (values, fs)))
         goto TERMINATE;
-    }
-    // Upper bounds - first-stage variables are fixed, so values are the same
-    status = CPXchgbds (DDSIP_env, DDSIP_lp, fs, DDSIP_bb->firstindex, DDSIP_bb->ubident, values);
-    if (status)
-    {
-        fprintf (stderr, "ERROR: Failed to change bounds \n");
-        goto TERMINATE;
-    }
 #ifdef DEACTIVATECUTS
     if (DDSIP_param->deactivate_cuts && feasCheckOnly < 2)
     {
@@ -616,6 +809,13 @@ DDSIP_UpperBound (int nrScenarios, int feasCheckOnly)
     }
 #endif
 
+    // results of the scenario problems from former evaluations with the same fixed first stage
+    // (values, the suggestion may have been restricted to the bounds of the node)
+    ubc = (feasCheckOnly < 1) ? DDSIP_UBCacheGet (values) : NULL;
+    // only a full evaluation takes results of the threads, a feasibility check within DDSIP_LowerBound leaves them
+    if (feasCheckOnly < 1)
+        DDSIP_ThreadsRoundReset ();
+
     // prepare for decision about stopping: rest_bound is the expectation of all the lower bounds in this node
     if (DDSIP_bb->DDSIP_step == adv || DDSIP_bb->DDSIP_step == eev || feasCheckOnly)
         rest_bound = -DDSIP_infty;
@@ -636,6 +836,40 @@ DDSIP_UpperBound (int nrScenarios, int feasCheckOnly)
                     fprintf (DDSIP_bb->moreoutfile," ------------ feasCheckOnly= %d, rest_bound= %18.12g\n", feasCheckOnly, rest_bound);
             }
 //#endif
+    // Screen the suggestion on a sample of the scenarios before evaluating all of them
+    if (DDSIP_param->ubsample && feasCheckOnly < 1 && rest_bound > -DDSIP_infty && DDSIP_bb->bestvalue < DDSIP_infty &&
+        !DDSIP_param->riskmod && !DDSIP_param->riskalg && !DDSIP_param->scalarization && DDSIP_bb->DDSIP_step != dual &&
+        DDSIP_param->scenarios > 2 * DDSIP_param->ubsample)
+    {
+        if ((status = DDSIP_UBScreen (ubc, &i, &k)))
+        {
+            fprintf (stderr, "ERROR: Failed to screen suggested solution (UpperBound) \n");
+            goto TERMINATE;
+        }
+        if (i)
+        {
+            if (!(DDSIP_bb->heurval < DDSIP_infty))
+                DDSIP_bb->skip = 100 + DDSIP_Imax (k - 1, 0);
+            prematureStop = 1;
+            goto TERMINATE;
+        }
+    }
+    // Solve the scenario problems concurrently, the results are processed in the loop below
+    if (DDSIP_param->threads > 1 && feasCheckOnly < 1 && DDSIP_param->files < 3 && !DDSIP_param->watchkappa)
+    {
+        // premature stop under the conditions of the serial loop, but not if the remaining scenarios are checked for cuts then
+        if (DDSIP_param->prematureStop && DDSIP_bb->bestvalue < DDSIP_infty && !DDSIP_param->riskalg && DDSIP_param->riskmod <= 0 &&
+            !DDSIP_param->scalarization && DDSIP_bb->DDSIP_step != dual &&
+            !(DDSIP_param->alwaysBendersCuts && (DDSIP_param->testOtherScens || DDSIP_bb->curnode < 3) && DDSIP_param->heuristic > 3 && DDSIP_param->heuristic < 21))
+            status = DDSIP_ThreadsUpperBound (rest_bound, ubc ? ubc->done : NULL);
+        else
+            status = DDSIP_ThreadsUpperBound (-DDSIP_infty, ubc ? ubc->done : NULL);
+        if (status)
+        {
+            fprintf (stderr, "ERROR: Failed to solve scenario problems concurrently (UpperBound) \n");
+            goto TERMINATE;
+        }
+    }
 
     // UpperBound single-scenario problems
     meanGap = tmpprob = tmpbestvalue = 0.;
@@ -644,15 +878,59 @@ DDSIP_UpperBound (int nrScenarios, int feasCheckOnly)
     {
         scen = DDSIP_bb->ub_scen_order[iscen];
 
+        threadres = cached = 0;
+        if (ubc && ubc->done[scen])
+        {
+            // The result is known from a former evaluation, it is processed like one of a worker thread
+            memcpy (mipx, ubc->mipx[scen], sizeof (double) * DDSIP_bb->novar);
+            status = 0;
+            mipstatus = ubc->mipstatus[scen];
+            objval = ubc->objval[scen] + DDSIP_UBCacheLag (ubc, scen);
+            bobjval = ubc->bobjval[scen] + DDSIP_UBCacheLag (ubc, scen);
+            nodes_1st = nodes_2nd = -1;
+            wr = 0.;
+            threadres = cached = 1;
+        }
+        else if (feasCheckOnly < 1)
+        {
+            // Has the problem been solved by a worker thread?
+            threadres = DDSIP_ThreadsLBResult (scen, mipx, &status, &mipstatus, &objval, &bobjval, &nodes_1st, &nodes_2nd, &wr);
+            if (!threadres && (k = DDSIP_ThreadsLBStopped (&d)))
+            {
+                if (k > 0)
+                {
+                    // A worker thread found a scenario problem without solution, handle it now
+                    scen = k - 1;
+                    for (iscen = 0; DDSIP_bb->ub_scen_order[iscen] != scen; iscen++)
+                        ;
+                    threadres = DDSIP_ThreadsLBResult (scen, mipx, &status, &mipstatus, &objval, &bobjval, &nodes_1st, &nodes_2nd, &wr);
+                }
+                else
+                {
+                    // The worker threads stopped since the suggested solution cannot be better than the best known
+                    if (!(DDSIP_bb->heurval < DDSIP_infty))
+                        DDSIP_bb->skip = 100 + iscen;
+                    if (DDSIP_param->outlev)
+                        fprintf (DDSIP_bb->moreoutfile,
+                                 "After %d scenarios lower bound for suggested solution yields expected value already greater than the best known\n (plus bound for the remaining scenarios: %.16g) (threads)\n", iscen, d);
+                    prematureStop = 1;
+                    goto TERMINATE;
+                }
+            }
+        }
+
         tmpprob += DDSIP_data->prob[scen];
 
-        status = DDSIP_ChgProb (scen, 0);
-        if (status)
+        if (!cached)
         {
-            fprintf (stderr, "ERROR: Failed to change problem \n");
-            goto TERMINATE;
+            status = DDSIP_ChgProb (scen, 0);
+            if (status)
+            {
+                fprintf (stderr, "ERROR: Failed to change problem \n");
+                goto TERMINATE;
+            }
+            nodes_1st = nodes_2nd = -1;
         }
-        nodes_1st = nodes_2nd = -1;
         if (feasCheckOnly < 1)
         {
             if (DDSIP_param-> outlev || DDSIP_param->cpxubscr)
@@ -661,6 +939,28 @@ DDSIP_UpperBound (int nrScenarios, int feasCheckOnly)
                     printf ("%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%\n");
                 printf ("Calculating objective value for scenario problem %d in node %d (heuristic %d).....\n", scen + 1,DDSIP_bb->curnode,DDSIP_param->heuristic);
             }
+            if (threadres)
+            {
+                if (!cached)
+                    DDSIP_bb->scenUBIters++;
+                time_start = DDSIP_GetCpuTime () - wr;
+                if (DDSIP_Error (status))
+                {
+                    fprintf (stderr, "ERROR: Failed to optimize (UB)\n");
+                    if (DDSIP_param->outlev)
+                        fprintf (DDSIP_bb->moreoutfile, "ERROR: Failed to optimize (UB), status= %d\n", status);
+                    goto TERMINATE;
+                }
+                // reduce the sum of the bounds rest_bound by the term for the current scenario
+                if (!DDSIP_Infeasible (mipstatus))
+                {
+                    if (DDSIP_param->cb)
+                        rest_bound -= (DDSIP_node[DDSIP_bb->curnode]->scenBoundsNoLag)[scen] * DDSIP_data->prob[scen];
+                    else
+                        rest_bound -= (DDSIP_node[DDSIP_bb->curnode]->subbound)[scen] * DDSIP_data->prob[scen];
+                }
+                goto THREAD_RESULT;
+            }
             // Debugging information
             DDSIP_PrintModFileUb (scen);
     
@@ -682,10 +982,28 @@ DDSIP_UpperBound (int nrScenarios, int feasCheckOnly)
             }
 #endif
             //
+            // Objective cutoff: a value of the scenario problem above it would give rise to a premature stop below.
+            // Not if the remaining scenarios are checked for cuts after a premature stop.
+            cutoff = DDSIP_infty;
+            if (DDSIP_param->prematureStop && DDSIP_bb->bestvalue < DDSIP_infty && rest_bound > -DDSIP_infty && !DDSIP_param->riskalg &&
+                DDSIP_param->riskmod <= 0 && iscen < DDSIP_param->scenarios - 1 && !DDSIP_param->scalarization && DDSIP_bb->DDSIP_step != dual &&
+                DDSIP_data->prob[scen] > 0. &&
+                !(DDSIP_param->alwaysBendersCuts && (DDSIP_param->testOtherScens || DDSIP_bb->curnode < 3) && DDSIP_param->heuristic > 3 && DDSIP_param->heuristic < 21))
+            {
+                if (DDSIP_param->cb)
+                    d = rest_bound - (DDSIP_node[DDSIP_bb->curnode]->scenBoundsNoLag)[scen] * DDSIP_data->prob[scen];
+                else
+                    d = rest_bound - (DDSIP_node[DDSIP_bb->curnode]->subbound)[scen] * DDSIP_data->prob[scen];
+                cutoff = (DDSIP_bb->bestvalue + DDSIP_param->accuracy - tmpbestvalue - d) / DDSIP_data->prob[scen];
+                if (DDSIP_SetCpxCutoff (cutoff, &oldcutoff) || cutoff >= oldcutoff)
+                    cutoff = DDSIP_infty;
+            }
             time_start = DDSIP_GetCpuTime ();
             // Optimize
             DDSIP_bb->scenUBIters++;
             status = CPXmipopt (DDSIP_env, DDSIP_lp);
+            if (cutoff < DDSIP_infty)
+                CPXsetdblparam (DDSIP_env, CPX_PARAM_CUTUP, oldcutoff);
             if (DDSIP_Error (status))
             {
                 fprintf (stderr, "ERROR: Failed to optimize (UB)\n");
@@ -695,6 +1013,20 @@ DDSIP_UpperBound (int nrScenarios, int feasCheckOnly)
             }
             mipstatus = CPXgetstat (DDSIP_env, DDSIP_lp);
             nodes_1st = CPXgetnodecnt (DDSIP_env,DDSIP_lp);
+            if (cutoff < DDSIP_infty && (mipstatus == CPXMIP_INFEASIBLE || mipstatus == CPXMIP_TIME_LIM_INFEAS ||
+                                         mipstatus == CPXMIP_NODE_LIM_INFEAS || mipstatus == CPXMIP_MEM_LIM_INFEAS))
+            {
+                // No solution below the cutoff, the suggested solution cannot be better than the best known.
+                // A limit reached before a solution below the cutoff was found is handled as a premature stop, too.
+                if (!(DDSIP_bb->heurval < DDSIP_infty))
+                    DDSIP_bb->skip = 100 + iscen;
+                if (DDSIP_param->outlev)
+                    fprintf (DDSIP_bb->moreoutfile,
+                             "%4d Scenario %4.0d:  no solution below cutoff %-20.14g (n:%5d, Stat.%3.0d)\nAfter %d scenarios suggested solution yields expected value already greater than the best known\n",
+                             iscen + 1, scen + 1, cutoff, nodes_1st, mipstatus, iscen + 1);
+                prematureStop = 1;
+                goto TERMINATE;
+            }
             if (!DDSIP_Infeasible (mipstatus))
             {
                 if (CPXgetmiprelgap(DDSIP_env, DDSIP_lp, &mipgap))
@@ -841,7 +1173,9 @@ DDSIP_UpperBound (int nrScenarios, int feasCheckOnly)
                         {
                             time_start = time_lap = DDSIP_GetCpuTime ();
                             CPXLPptr     DDSIP_dual_lp  = NULL;
-                            cutpool_t * newCut;
+#ifdef CHECKIDENTICAL
+                            int newCut;
+#endif
                             for (Bi = iscen + 1; Bi < DDSIP_param->scenarios; Bi++)
                             {
                                 time_lap = DDSIP_GetCpuTime ();
@@ -1010,34 +1344,34 @@ DDSIP_UpperBound (int nrScenarios, int feasCheckOnly)
                                                     // Check whether cut with identical matval was already added.
                                                     // current one may be dominated!
                                                     // This is possible with continued check of the same solution for other scens
-                                                    newCut = DDSIP_bb->cutpool;
-                                                    while (newCut)
+                                                    newCut = DDSIP_bb->cutpool.cnt - 1;
+                                                    while (newCut >= 0)
                                                     {
                                                         for (k = 0; k < DDSIP_data->firstvar; k++)
                                                         {
-                                                            if (!DDSIP_Equal (rmatval[k], newCut->matval[k]))
+                                                            if (!DDSIP_Equal (rmatval[k], DDSIP_bb->cutpool.matval[newCut * DDSIP_bb->cutpool.ld + k]))
                                                             {
 #ifdef DEBUG
 if (DDSIP_param->outlev)
 {
-  fprintf(DDSIP_bb->moreoutfile, "### 1 ### check for identical cut: Cut no. %d is different, index %d: %22.16g - %22.16g = %g \n", newCut->number, k, rmatval[k], newCut->matval[k],rmatval[k] - newCut->matval[k]);
+  fprintf(DDSIP_bb->moreoutfile, "### 1 ### check for identical cut: Cut no. %d is different, index %d: %22.16g - %22.16g = %g \n", DDSIP_bb->cutpool.number[newCut], k, rmatval[k], DDSIP_bb->cutpool.matval[newCut * DDSIP_bb->cutpool.ld + k],rmatval[k] - DDSIP_bb->cutpool.matval[newCut * DDSIP_bb->cutpool.ld + k]);
 }
 #endif
                                                                 break;
                                                             }
                                                         }
                                                         if (k < DDSIP_data->firstvar)
-                                                            newCut = newCut->prev;
+                                                            newCut--;
                                                         else
                                                         {
 ////////////////////
 if (DDSIP_param->outlev > 21)
 {
-  fprintf(DDSIP_bb->moreoutfile, "### 1 ### check for identical cut: Cut no. %d is identical, rhs was: %g, now: %g ###\n", newCut->number, newCut->rhs, rhs);
+  fprintf(DDSIP_bb->moreoutfile, "### 1 ### check for identical cut: Cut no. %d is identical, rhs was: %g, now: %g ###\n", DDSIP_bb->cutpool.number[newCut], DDSIP_bb->cutpool.rhs[newCut], rhs);
 }
 ////////////////////
-                                                            if (rhs > newCut->rhs)
-                                                                newCut->rhs = rhs;
+                                                            if (rhs > DDSIP_bb->cutpool.rhs[newCut])
+                                                                DDSIP_bb->cutpool.rhs[newCut] = rhs;
                                                             i = 0;
                                                             break;
                                                         }
@@ -1066,16 +1400,10 @@ if (DDSIP_param->outlev > 21)
                                                     else
                                                     {
                                                         DDSIP_bb->cutAdded++;
+                                                        DDSIP_ThreadsModelChanged ();
                                                     }
                                                     // store cut in bb->cutpool
-                                                    newCut = (cutpool_t*) DDSIP_Alloc(sizeof(cutpool_t), 1, "cutpool (DDSIP_UpperBound)");
-                                                    newCut->prev = DDSIP_bb->cutpool;
-                                                    newCut->matval = rmatval;
-                                                    newCut->rhs    = rhs;
-                                                    newCut->number = DDSIP_bb->cutNumber;
-                                                    newCut->Benders = 1;
-                                                    DDSIP_bb->cutpool = newCut;
-                                                    rmatval = NULL;
+                                                    DDSIP_CutPoolAdd (rmatval, rhs, DDSIP_bb->cutNumber, 1);
                                                     //shift this infeasible scenario to first place, such that next time it is checked first
                                                     if (Bi)
                                                     {
@@ -1288,11 +1616,12 @@ if (DDSIP_param->outlev > 21)
             {
                 status    = CPXdelmipstarts (DDSIP_env, DDSIP_lp, 2, k-1);
             }
+THREAD_RESULT:
             // Infeasible, unbounded .. ?
-            if (!DDSIP_Infeasible (mipstatus))
-                mipstatus = CPXgetstat (DDSIP_env, DDSIP_lp);
-            else
+            if (DDSIP_Infeasible (mipstatus))
                 DDSIP_bb->skip = -2;
+            else if (!threadres)
+                mipstatus = CPXgetstat (DDSIP_env, DDSIP_lp);
         }
         else // feasCheckOnly
         {
@@ -1318,7 +1647,9 @@ if (DDSIP_param->outlev > 21)
                 (DDSIP_param->addBendersCuts))
             {
                 CPXLPptr     DDSIP_dual_lp  = NULL;
-                cutpool_t * newCut;
+#ifdef CHECKIDENTICAL
+                int newCut;
+#endif
                 int beg, end;
                 if (feasCheckOnly)
                 {
@@ -1504,34 +1835,34 @@ if (DDSIP_param->outlev > 21)
                                         // Check whether cut with identical matval was already added.
                                         // current one may be dominated!
                                         // This is possible with continued check of the same solution for other scens
-                                        newCut = DDSIP_bb->cutpool;
-                                        while (newCut)
+                                        newCut = DDSIP_bb->cutpool.cnt - 1;
+                                        while (newCut >= 0)
                                         {
                                             for (k = 0; k < DDSIP_data->firstvar; k++)
                                             {
-                                                if (!DDSIP_Equal (rmatval[k], newCut->matval[k]))
+                                                if (!DDSIP_Equal (rmatval[k], DDSIP_bb->cutpool.matval[newCut * DDSIP_bb->cutpool.ld + k]))
                                                 {
 #ifdef DEBUG
                                                     if (DDSIP_param->outlev /*&& DDSIP_bb->curnode > 25*/)
                                                     {
-                                                      fprintf(DDSIP_bb->moreoutfile, "### 2 ### check for identical cut: Cut no. %d is different, index %d: %22.16g - %22.16g = %g \n", newCut->number, k, rmatval[k], newCut->matval[k],rmatval[k] - newCut->matval[k]);
+                                                      fprintf(DDSIP_bb->moreoutfile, "### 2 ### check for identical cut: Cut no. %d is different, index %d: %22.16g - %22.16g = %g \n", DDSIP_bb->cutpool.number[newCut], k, rmatval[k], DDSIP_bb->cutpool.matval[newCut * DDSIP_bb->cutpool.ld + k],rmatval[k] - DDSIP_bb->cutpool.matval[newCut * DDSIP_bb->cutpool.ld + k]);
                                                     }
 #endif
                                                     break;
                                                 }
                                             }
                                             if (k < DDSIP_data->firstvar)
-                                                newCut = newCut->prev;
+                                                newCut--;
                                             else
                                             {
 //////////////////// DEBUG output
                                                 if (DDSIP_param->outlev > 20)
                                                 {
-                                                  fprintf(DDSIP_bb->moreoutfile, "### 2 ### check for identical cut: Cut no. %d is identical, rhs was: %g, now: %g ###\n", newCut->number, newCut->rhs, rhs);
+                                                  fprintf(DDSIP_bb->moreoutfile, "### 2 ### check for identical cut: Cut no. %d is identical, rhs was: %g, now: %g ###\n", DDSIP_bb->cutpool.number[newCut], DDSIP_bb->cutpool.rhs[newCut], rhs);
                                                 }
 //////////////////// DEBUG output
-                                                if (rhs > newCut->rhs)
-                                                    newCut->rhs = rhs;
+                                                if (rhs > DDSIP_bb->cutpool.rhs[newCut])
+                                                    DDSIP_bb->cutpool.rhs[newCut] = rhs;
                                                 i = 0;
                                                 break;
                                             }
@@ -1559,16 +1890,10 @@ if (DDSIP_param->outlev > 21)
                                         else
                                         {
                                             DDSIP_bb->cutAdded++;
+                                            DDSIP_ThreadsModelChanged ();
                                         }
                                         // store cut in bb->cutpool
-                                        newCut = (cutpool_t*) DDSIP_Alloc(sizeof(cutpool_t), 1, "cutpool (DDSIP_UpperBound)");
-                                        newCut->prev = DDSIP_bb->cutpool;
-                                        newCut->matval = rmatval;
-                                        newCut->rhs    = rhs;
-                                        newCut->number = DDSIP_bb->cutNumber;
-                                        newCut->Benders = 1;
-                                        DDSIP_bb->cutpool = newCut;
-                                        rmatval = NULL;
+                                        DDSIP_CutPoolAdd (rmatval, rhs, DDSIP_bb->cutNumber, 1);
 		                        if (feasCheckOnly == 2 && DDSIP_bb->dualitcnt > 1)
                                         {
                                             end = DDSIP_param->scenarios;
@@ -1652,7 +1977,7 @@ if (DDSIP_param->outlev > 21)
                 for (k = 0; k < DDSIP_bb->firstvar; k++)
                 {
                     rmatind[k] = DDSIP_bb->firstindex[k];
-                    if (floor((DDSIP_bb->sug[DDSIP_param->nodelim + 2])->firstval[k] + 0.5))
+                    if (floor((DDSIP_bb->sug[DDSIP_bb->nodecap])->firstval[k] + 0.5))
                     {
                         rmatval[k] = -1.;
                         rhs -= 1.;
@@ -1747,7 +2072,6 @@ if (DDSIP_param->outlev > 21)
                 }
                 if (objv < rhs - 3e-2)
                 {
-                    cutpool_t * newCut;
                     DDSIP_bb->cutNumber++;
                     DDSIP_bb->cutCntr++;
                     sprintf (rowstore, "DDSIPIntegerCut%.04d",DDSIP_bb->cutNumber);
@@ -1761,7 +2085,6 @@ if (DDSIP_param->outlev > 21)
                             printf (" ############ adding cut %s  (objval = %g < %g) ############\n", rowstore, objv, rhs);
                     }
 #else
-                    cutpool_t * newCut;
                     DDSIP_bb->cutNumber++;
                     DDSIP_bb->cutCntr++;
                     sprintf (rowstore, "DDSIPIntegerCut%.04d",DDSIP_bb->cutNumber);
@@ -1781,16 +2104,10 @@ if (DDSIP_param->outlev > 21)
                     else
                     {
                         DDSIP_bb->cutAdded++;
+                        DDSIP_ThreadsModelChanged ();
                     }
                     // store cut in bb->cutpool
-                    newCut = (cutpool_t*) DDSIP_Alloc(sizeof(cutpool_t), 1, "cutpool (DDSIP_UpperBound)");
-                    newCut->prev = DDSIP_bb->cutpool;
-                    newCut->matval = rmatval;
-                    newCut->rhs    = rhs;
-                    newCut->number = DDSIP_bb->cutNumber;
-                    newCut->Benders = 0;
-                    DDSIP_bb->cutpool = newCut;
-                    rmatval = NULL;
+                    DDSIP_CutPoolAdd (rmatval, rhs, DDSIP_bb->cutNumber, 0);
 #ifdef CHECKINTEGERCUT
                 }
                 else
@@ -1886,10 +2203,13 @@ if (DDSIP_param->outlev > 21)
         }
         if (feasCheckOnly < 1)
         {
-            // Get solution
-            status = DDSIP_GetCpxSolution (mipstatus, &objval, &bobjval, mipx);
-            if (status)
-                goto TERMINATE;
+            // Get solution (already fetched by the worker thread)
+            if (!threadres)
+            {
+                status = DDSIP_GetCpxSolution (mipstatus, &objval, &bobjval, mipx);
+                if (status)
+                    goto TERMINATE;
+            }
 
             // Remember objective function contribution
             if (DDSIP_param->outlev > 10)
@@ -1904,6 +2224,17 @@ if (DDSIP_param->outlev > 21)
 
             subsol[scen] = objval;
 
+            if (ubc && !cached)
+            {
+                if (!ubc->mipx[scen])
+                    ubc->mipx[scen] = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->novar, "mipx(UpperBound)");
+                memcpy (ubc->mipx[scen], mipx, sizeof (double) * DDSIP_bb->novar);
+                ubc->mipstatus[scen] = mipstatus;
+                ubc->objval[scen] = objval - DDSIP_UBCacheLag (ubc, scen);
+                ubc->bobjval[scen] = bobjval - DDSIP_UBCacheLag (ubc, scen);
+                ubc->done[scen] = 1;
+            }
+
             gap = 100.0*(objval-bobjval)/(fabs(objval)+1e-4);
             meanGap += DDSIP_data->prob[scen] * gap;
             time_end = DDSIP_GetCpuTime ();
@@ -2058,6 +2389,7 @@ if (DDSIP_param->outlev > 21)
 
 
     DDSIP_bb->heurval = DDSIP_Dmin (tmpbestvalue, DDSIP_bb->heurval);
+    sugval = tmpbestvalue;
 
     DDSIP_bb->meanGapUB = DDSIP_Dmax(DDSIP_bb->meanGapUB, meanGap);
 
@@ -2112,7 +2444,7 @@ if (DDSIP_param->outlev > 21)
                 DDSIP_bb->bestriskval[j] = DDSIP_bb->curriskval[j];
 
         for (j = 0; j < DDSIP_bb->firstvar; j++)
-            DDSIP_bb->bestsol[j] = ((DDSIP_bb->sug[DDSIP_param->nodelim + 2])->firstval)[j];
+            DDSIP_bb->bestsol[j] = ((DDSIP_bb->sug[DDSIP_bb->nodecap])->firstval)[j];
 
         // compare with bound_optimal_node
         if (DDSIP_bb->bestvalue < DDSIP_bb->bound_optimal_node)
@@ -2228,9 +2560,12 @@ TERMINATE:
     // if not only feasibility was tested, add the suggested first-stage to the list of suggested solutions
     if (feasCheckOnly < 1)
     {
-        DDSIP_bb->sug[DDSIP_param->nodelim + 2]->next = DDSIP_bb->sug[DDSIP_bb->curnode];
-        DDSIP_bb->sug[DDSIP_bb->curnode] = DDSIP_bb->sug[DDSIP_param->nodelim + 2];
-        DDSIP_bb->sug[DDSIP_param->nodelim + 2] = NULL;
+        DDSIP_bb->sug[DDSIP_bb->nodecap]->node = DDSIP_bb->curnode;
+        DDSIP_bb->sug[DDSIP_bb->nodecap]->objval = sugval;
+        DDSIP_SugHashAdd (DDSIP_bb->sug[DDSIP_bb->nodecap]);
+        DDSIP_bb->sug[DDSIP_bb->nodecap]->next = DDSIP_bb->sug[DDSIP_bb->curnode];
+        DDSIP_bb->sug[DDSIP_bb->curnode] = DDSIP_bb->sug[DDSIP_bb->nodecap];
+        DDSIP_bb->sug[DDSIP_bb->nodecap] = NULL;
     }
     // Store optimal value of EEV problem
     if (DDSIP_bb->DDSIP_step == eev)
@@ -2282,6 +2617,130 @@ TERMINATE:
     return status;
 }
 
+//==========================================================================
+// Evaluate the suggestions cand[0..nocand-1] scenario by scenario: each scenario problem is loaded once and solved
+// for all suggestions still in the race by changing only the first-stage bounds. The results go into the cache of
+// upper bound results, so that the following calls of DDSIP_UpperBound for these suggestions need no further solves.
+// drop[k] = 1: the expectation of the values computed plus the bounds of the remaining scenarios exceeds the best
+//              known value, suggestion k need not be evaluated
+// drop[k] = 2: a scenario problem has no solution, this is left to DDSIP_UpperBound
+// sum[k] returns the expectation of the values computed (bounds where the result is not optimal)
+int
+DDSIP_UpperBoundBatch (int nocand, double **cand, int *drop, double *sum)
+{
+    int j, k, iscen, scen, fs, status = 0, mipstatus, alive = nocand, premature;
+    double objval, bobjval;
+    double *rest, *subbound;
+    double **values;
+    double *mipx;
+    ubcache_t **ubc;
+
+    if (nocand > DDSIP_bb->ubcachecap)
+    {
+        fprintf (stderr, "ERROR: More suggestions (%d) than entries of the upper bound cache (%d) (UpperBoundBatch)\n", nocand, DDSIP_bb->ubcachecap);
+        return 1;
+    }
+    if ((status = DDSIP_UBPrepare (&fs)))
+        return status;
+    // premature stop under the conditions of DDSIP_ThreadsUpperBound
+    premature = (DDSIP_param->prematureStop && DDSIP_bb->bestvalue < DDSIP_infty && !DDSIP_param->riskalg && DDSIP_param->riskmod <= 0 &&
+                 !DDSIP_param->scalarization && DDSIP_bb->DDSIP_step != dual);
+    subbound = DDSIP_param->cb ? DDSIP_node[DDSIP_bb->curnode]->scenBoundsNoLag : DDSIP_node[DDSIP_bb->curnode]->subbound;
+
+    mipx = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->novar, "mipx(UpperBoundBatch)");
+    rest = (double *) DDSIP_Alloc (sizeof (double), nocand, "rest(UpperBoundBatch)");
+    values = (double **) DDSIP_Alloc (sizeof (double *), nocand, "values(UpperBoundBatch)");
+    ubc = (ubcache_t **) DDSIP_Alloc (sizeof (ubcache_t *), nocand, "ubc(UpperBoundBatch)");
+    for (k = 0; k < nocand; k++)
+    {
+        values[k] = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->firstvar, "values[k](UpperBoundBatch)");
+        DDSIP_UBFixedValues (cand[k], values[k]);
+        ubc[k] = DDSIP_UBCacheGet (values[k]);
+        rest[k] = DDSIP_param->cb ? DDSIP_node[DDSIP_bb->curnode]->BoundNoLag : DDSIP_node[DDSIP_bb->curnode]->bound;
+        sum[k] = 0.;
+        drop[k] = 0;
+    }
+
+    for (iscen = 0; alive && iscen < DDSIP_param->scenarios; iscen++)
+    {
+        scen = DDSIP_bb->ub_scen_order[iscen];
+        if ((status = DDSIP_ChgProb (scen, 0)))
+        {
+            fprintf (stderr, "ERROR: Failed to change problem \n");
+            goto TERMINATE;
+        }
+        for (k = 0; k < nocand; k++)
+        {
+            if (drop[k])
+                continue;
+            if (ubc[k]->done[scen])
+            {
+                objval = ubc[k]->objval[scen] + DDSIP_UBCacheLag (ubc[k], scen);
+            }
+            else
+            {
+                if ((status = DDSIP_UBFix (values[k], fs)))
+                    goto TERMINATE;
+                DDSIP_bb->scenUBIters++;
+                status = CPXmipopt (DDSIP_env, DDSIP_lp);
+                if (DDSIP_Error (status))
+                {
+                    fprintf (stderr, "ERROR: Failed to optimize (UpperBoundBatch)\n");
+                    goto TERMINATE;
+                }
+                status = 0;
+                mipstatus = CPXgetstat (DDSIP_env, DDSIP_lp);
+                if (DDSIP_NoSolution (mipstatus))
+                {
+                    drop[k] = 2;
+                    alive--;
+                    continue;
+                }
+                if ((status = DDSIP_GetCpxSolution (mipstatus, &objval, &bobjval, mipx)))
+                    goto TERMINATE;
+                if (mipstatus == CPXMIP_OPTIMAL && bobjval > DDSIP_infty)
+                    bobjval = objval;
+                if ((j = CPXgetnummipstarts (DDSIP_env, DDSIP_lp)) > 3)
+                    CPXdelmipstarts (DDSIP_env, DDSIP_lp, 2, j - 1);
+                // only final results are cached, DDSIP_UpperBound tries a second optimization for the others
+                if (mipstatus == CPXMIP_OPTIMAL || mipstatus == CPXMIP_OPTIMAL_TOL)
+                {
+                    if (!ubc[k]->mipx[scen])
+                        ubc[k]->mipx[scen] = (double *) DDSIP_Alloc (sizeof (double), DDSIP_bb->novar, "mipx(UpperBoundBatch)");
+                    memcpy (ubc[k]->mipx[scen], mipx, sizeof (double) * DDSIP_bb->novar);
+                    ubc[k]->mipstatus[scen] = mipstatus;
+                    ubc[k]->objval[scen] = objval - DDSIP_UBCacheLag (ubc[k], scen);
+                    ubc[k]->bobjval[scen] = bobjval - DDSIP_UBCacheLag (ubc[k], scen);
+                    ubc[k]->done[scen] = 1;
+                }
+                else
+                    objval = bobjval;
+            }
+            sum[k] += objval * DDSIP_data->prob[scen];
+            rest[k] -= subbound[scen] * DDSIP_data->prob[scen];
+            if (premature && iscen < DDSIP_param->scenarios - 1 && sum[k] + rest[k] > DDSIP_bb->bestvalue + DDSIP_param->accuracy)
+            {
+                if (DDSIP_param->outlev > 10)
+                    fprintf (DDSIP_bb->moreoutfile, " ### batch: suggestion %d dropped after %d scenarios (%.16g plus bound for the remaining scenarios %.16g)\n",
+                             k + 1, iscen + 1, sum[k], sum[k] + rest[k]);
+                drop[k] = 1;
+                alive--;
+            }
+        }
+    }
+
+TERMINATE:
+    for (k = 0; k < nocand; k++)
+        DDSIP_Free ((void **) &(values[k]));
+    DDSIP_Free ((void **) &(values));
+    DDSIP_Free ((void **) &(ubc));
+    DDSIP_Free ((void **) &(rest));
+    DDSIP_Free ((void **) &(mipx));
+    if (DDSIP_RestoreBoundAndType ())
+        fprintf (stderr, "ERROR: Failed to restore bounds\n");
+    return status;
+} // DDSIP_UpperBoundBatch
+
 void DDSIP_EvaluateScenarioSolutions (int* comb)
 {
     int i, i_scen, status = 0, use_heur12 = 0;
@@ -2299,8 +2758,8 @@ void DDSIP_EvaluateScenarioSolutions (int* comb)
     DDSIP_bb->DDSIP_step = neobj;
     // Initialize, heurval contains the current heuristic solution
     DDSIP_bb->heurval = DDSIP_infty;
-    // sort scenarios according to lower bounds for the initial solution
-    if (!(DDSIP_bb->ub_sorted))
+    // sort scenarios according to lower bounds for the initial solution (an order given by PREPRO is kept)
+    if (!(DDSIP_bb->ub_sorted) && !DDSIP_param->prepro)
     {
         // in order to allow for premature cutoff: sort scenarios according to lower bound in root node in descending order
         double * bound_sort_array;
@@ -2344,7 +2803,7 @@ void DDSIP_EvaluateScenarioSolutions (int* comb)
         if (!DDSIP_Heuristics (comb, DDSIP_param->scenarios, 0))
         {
                 // Evaluate the proposed first-stage solution (if DDSIP_bb->skip was not set)
-                if (DDSIP_bb->skip != -4 && DDSIP_bb->sug[DDSIP_param->nodelim + 2])
+                if (DDSIP_bb->skip != -4 && DDSIP_bb->sug[DDSIP_bb->nodecap])
                 {
             	    if (!(status = DDSIP_UpperBound (DDSIP_param->scenarios, -1)))
             	    {
@@ -2365,7 +2824,7 @@ void DDSIP_EvaluateScenarioSolutions (int* comb)
             	    if (!DDSIP_Heuristics (comb, DDSIP_param->scenarios, 0))
             	    {
             		    // Evaluate the proposed first-stage solution (if DDSIP_bb->skip was not set)
-            		    if (DDSIP_bb->skip != -4 && DDSIP_bb->sug[DDSIP_param->nodelim + 2])
+            		    if (DDSIP_bb->skip != -4 && DDSIP_bb->sug[DDSIP_bb->nodecap])
             		    {
             			    if (!(status = DDSIP_UpperBound (DDSIP_param->scenarios, 0)) || status == 100000)
             			    {
@@ -2393,7 +2852,7 @@ void DDSIP_EvaluateScenarioSolutions (int* comb)
             	    if (!DDSIP_Heuristics (comb, DDSIP_param->scenarios, 0))
             	    {
             		    // Evaluate the proposed first-stage solution (if DDSIP_bb->skip was not set)
-            		    if (DDSIP_bb->sug[DDSIP_param->nodelim + 2])
+            		    if (DDSIP_bb->sug[DDSIP_bb->nodecap])
             		    {
             			    if (!DDSIP_UpperBound (DDSIP_param->scenarios, 0))
             			    {
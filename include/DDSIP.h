@@ -41,6 +41,11 @@ extern "C" {
         dual, solve, neobj, eev, adv
     };
 
+// Kinds of node arrays kept for reuse in the node pool
+    enum DDSIP_pool_t {
+        pool_first_sol, pool_cursubsol, pool_subbound, pool_mipstatus, pool_ref_scenobj, pool_dual, pool_scenBoundsNoLag, pool_solut, pool_kinds
+    };
+
     typedef struct
     {
 
@@ -159,6 +164,16 @@ extern "C" {
         int cb_checkBestdual;
         // upper bounds plus cuts for solution of initial evaluation in CBLowerBound up to node no
         int cb_cutnodes;
+        // number of functions (scenario groups) the dual is decomposed into, 1: one aggregated function
+        int cbfunctions;
+        // keep scenario solutions in CBLowerBound if the bound lost by the change of the multipliers
+        // is at most this tolerance relative to the scenario bound (0: re-solve all scenarios)
+        double cbkeep;
+        // maximal relative MIP gap of the scenario problems in an inexact evaluation of the dual (0: CPLEX parameters)
+        double cbinexact;
+        // keep the ConicBundle problem of a node for the next node, the models of functions whose
+        // scenario solutions are feasible in the next node are kept (0: new problem in each node)
+        int cbreuse;
 #endif
 
         // 3. Branch-and-bound
@@ -220,18 +235,26 @@ extern "C" {
         double btTolerance;
         // use premature stop in LB?
         int   prematureStop;
+        // Number of scenarios sampled for screening suggestions in UB (0: no screening)
+        int   ubsample;
+        // Multiple of the standard deviation of the screening estimate required for rejecting a suggestion
+        double ubconfidence;
         // Update LP base in every i-th iteration
         int   base;
         // Log freqeuncy: Print output every i-ht iteration
         int   logfreq;
         // Solve EEV problem
         int   expected;
-        // Sort scenarios
+        // Order of the scenarios: by bounds (0), sum of rhs (1), nearest-neighbour tour through the scenario data (2)
         int   prepro;
         // Calculate this number of quantils of the objective value distribution
         int   noquant;
         // gather kappa information (numerical problems?)
         int   watchkappa;
+        // Number of threads solving scenario problems concurrently
+        int   threads;
+        // Number of further unsolved front nodes whose scenario problems are solved by the threads in advance
+        int   threadnodes;
 
         // Time limit
         double timelim;
@@ -293,6 +316,7 @@ extern "C" {
         int numberScenReeval;
         int redundancyCheck;
         int deleteRedundantCuts;
+        int cutAge;
         double cut_security_tol;
 #endif
         // annotation file name if Benders decomposition within CPLEX should be used
@@ -349,6 +373,12 @@ extern "C" {
         int    *nacnt;
         int    *naind;
         double *naval;
+        // the entries divided by the probability of the scenario of their column (Lagrangean cost corrections)
+        double *naval_p;
+        // the matrix row-wise (subgradient), column index scen * firstvar + i
+        int    *narbeg;
+        int    *narind;
+        double *narval;
 
     } data_t;
 
@@ -356,23 +386,96 @@ extern "C" {
     {
         double * firstval;
         struct sug_l *next;
+        // Entries of the hash table of evaluated suggestions: node of the evaluation, objective value
+        // (DDSIP_infty if the evaluation was stopped early), hash value and next entry in the bucket
+        int node;
+        double objval;
+        unsigned int hash;
+        struct sug_l *hashnext;
     } sug_t;
 
+    // Results of the scenario problems for a suggested first-stage solution (see DDSIP_UBCacheGet)
+    typedef struct ubcache_l
+    {
+        double * firstval;
+        unsigned int hash;
+        // per scenario: result present, status, objective value, bound and solution of the scenario problem
+        // (objective value and bound without the Lagrangean cost terms, see DDSIP_UBCacheLag)
+        int * done;
+        int * mipstatus;
+        double * objval;
+        double * bobjval;
+        double ** mipx;
+        // least recently used order
+        struct ubcache_l *prev, *next;
+    } ubcache_t;
+
     typedef struct
     {
         double * first_sol;
         double cursubsol, subbound;
     } bestfirst_t;
  
-    typedef struct cut_tt
+    // Pool of the Benders and integer cuts, cut j < cutCntr is row nocon + j of DDSIP_lp (the newest one is the last),
+    // the cuts cutCntr..cnt-1 have been moved out of DDSIP_lp after being inactive for CUTAGE nodes (DDSIP_CutPoolAging).
+    // The coefficients are stored row by row in matval, each row has ld (firstvar rounded up to a multiple of 4)
+    // entries and starts on a 32 byte boundary, the remaining entries are zero.
+    typedef struct
     {
         double *matval;
-        double rhs;
-        int    number;
-        int    Benders;
-        struct cut_tt *prev;
+        double *rhs;
+        int    *number;
+        int    *Benders;
+        // activity of the cuts in DDSIP_lp: minimal slack at the distinct scenario solutions of the last node,
+        // number of nodes where the cut was binding, number of nodes since it was binding the last time
+        double *slack;
+        int    *binding;
+        int    *age;
+        // number of cuts, number of rows allocated, length of a row
+        int    cnt;
+        int    cap;
+        int    ld;
+        // allocated storage containing matval
+        double *matstore;
     } cutpool_t;
 
+    // Scenario data currently loaded in a problem (DDSIP_lp or the copy of a thread), see DDSIP_ChgProbLp
+    typedef struct
+    {
+        // 1 if the stochastic rhs resp. matrix entries below are those in the problem
+        int    rhsknown;
+        int    matknown;
+        double *rhs;
+        double *matval;
+        // objective coefficients of the columns, objknown[j] = 1 if obj[j] is the one in the problem
+        double *obj;
+        char   *objknown;
+        // buffers for the changed entries
+        int    *ind;
+        int    *colind;
+        double *val;
+        double *cost;
+    } loaded_t;
+
+    // Cplex parameter set currently applied in an environment, see DDSIP_SetCpxParaEnv
+    typedef struct
+    {
+        // 0 if the parameters of the environment are unknown
+        int    valid;
+        int    cnt;
+        int    *isdbl;
+        int    *which;
+        double *what;
+    } cpxstate_t;
+
+    // Arrays of pruned nodes of one kind, reused for new nodes (see DDSIP_PoolGet)
+    typedef struct
+    {
+        int    cnt;
+        int    max;
+        void   **arr;
+    } pool_t;
+
     typedef struct bbest_l
     {
         double* dual;
@@ -406,6 +509,10 @@ extern "C" {
         int    skip;
         // Number of bounds on variables at current node
         int    curbdcnt;
+        // Node the bounds curind, curlb, curub belong to (-1: none)
+        int    boundnode;
+        // 1 if lplb, lpub are the first-stage bounds set in DDSIP_lp
+        int    lpbdknown;
         // Total number of integers (for warm starts)
         int    total_int;
         // number of integers in first stage (including binaries)
@@ -416,6 +523,9 @@ extern "C" {
         int    depth;
         // total number of generated nodes
         int    nonode;
+        // Number of nodes DDSIP_node has room for, grown on demand up to the node limit
+        // (sug has one more entry: sug[nodecap] holds the suggestion to be evaluated)
+        int    nodecap;
         // Number of front nodes
         int    nofront;
         // Number of reduced front nodes (number of front nodes - number of leafs in front)
@@ -424,6 +534,10 @@ extern "C" {
         int    curnode;
         // Dimension of dual multipliers
         int    dimdual;
+        // Lagrangean cost corrections of the first-stage variables of all scenarios (scen * firstvar + i)
+        // and the multipliers they were computed for (DDSIP_LagrangeCost)
+        double *lagcost;
+        double *lagdual;
         // Indicator is 1 if a scenario has negative objective values
         int    isneg;
         // Number of dual iterations
@@ -484,6 +598,13 @@ extern "C" {
         int    *secondrowind_reverse;
         // Front of b+b-tree
         int    *front;
+        // Indexed heaps of the front nodes wrt. bound: fheap[0] least bound, fheap[1] greatest bound on top
+        // (the positions are kept in node_t: frontpos, heappos)
+        int    *fheap[2];
+        // Work array for front nodes taken from the heaps when bounding
+        int    *frontbuf;
+        // Unsolved nodes are selected in the order of their numbers, no front node below firstunsolved is unsolved
+        int    firstunsolved;
         // Indices of integer variables
         int    *intind;
         // Pointer to a vector of all integer variables in the solutions of the scenario problems
@@ -499,9 +620,20 @@ extern "C" {
         int    *solstat;
         // Indices of bounds on variables at current node
         int    *curind;
+        // Position of a first-stage variable in curind (-1: no bound) and number of nodes on the path bounding it
+        int    *curpos;
+        int    *curcnt;
 
         // Vector of scenario problem solutions
         double *firstsol;
+        // Hash table of the distinct first-stage solutions in the current node (see DDSIP_FirstHashFind):
+        // buckets with the first entry, per entry the representing scenario, the next entry and the hash value
+        int    firsthashsize;
+        int    firstcnt;
+        int    *firsthead;
+        int    *firstent;
+        int    *firstnext;
+        unsigned int *firsthash;
         // Best solution
         double *bestsol;
         // Original lower bounds
@@ -520,6 +652,9 @@ extern "C" {
         double *curlb;
         // Upper bounds on variables at current node
         double *curub;
+        // First-stage bounds set in DDSIP_lp
+        double *lplb;
+        double *lpub;
         // Values for risk measures for best upper bound
         double *bestriskval;
         // Values for risk measures for current upper bound
@@ -528,11 +663,24 @@ extern "C" {
         //double *dual;
         // First-stage costs
         double *cost;
-        // sorted list of front node indices
+        // sorted list of front node indices, only the first nofrontsorted are in order (see DDSIP_Bound)
         int *front_nodes_sorted;
+        int nofrontsorted;
+        // Sort keys of the front nodes (indexed by the node numbers)
+        double *front_node_bound;
 
         // Heuristic solution in each node
         sug_t ** sug;
+        // Hash table of all evaluated suggestions (see DDSIP_SugHashAdd), number of buckets and entries
+        sug_t ** sughead;
+        int sughashsize;
+        int sugcnt;
+        // Cache of the scenario results of evaluated suggestions, entries ordered from the most to the least
+        // recently used
+        ubcache_t * ubcache;
+        int ubcachecap;
+        ubcache_t * ubcachefirst;
+        ubcache_t * ubcachelast;
         // index of scenario giving heuristic suggestion
         int from_scenario;
 
@@ -547,6 +695,10 @@ extern "C" {
         char   *lbident;
         // Upper bound identifier for cplex routine CPXchgbd
         char   *ubident;
+        // Scenario data loaded in DDSIP_lp
+        loaded_t *loaded;
+        // Arrays of pruned nodes for reuse
+        pool_t   pool[pool_kinds];
         //
         // reference point scalarization: max = exp (0) or = risk (1)
         int      ref_max;
@@ -614,7 +766,7 @@ extern "C" {
         // number of cuts added
         int cutAdded;
         // store cuts of the UB steps for testing proposals
-        cutpool_t* cutpool;
+        cutpool_t cutpool;
         // last_weight in CB iter 1 - an eventually by CBLowerBound increased weight
         double last_weight;
         // indicator whether an optimal node (bound close enough to bestvalue and no violations) was found
@@ -646,6 +798,28 @@ extern "C" {
         int Dive;
         // could we keep solutions (for reinits)?
         int keepSols;
+        // ConicBundle functions for the scenario groups (cbfunctions > 1): keys, point of the last
+        // evaluation, its status, number of subgradients, objective values of the groups and the
+        // groups already served at this point
+        int *cbkey;
+        double *cbpoint;
+        int cbstatus;
+        int cbnewsubg;
+        double *cbgroupobj;
+        char *cbserved;
+        // Reference of the scenario solutions for keeping them in CBLowerBound (cbkeep > 0):
+        // cost corrections, bound and objective value of the last solve and its node
+        double *cbrefcost;
+        double *cbrefbound;
+        double *cbrefsubsol;
+        int *cbrefnode;
+        // ConicBundle problem kept from the last node (cbreuse): flag, evaluations done with it, cut
+        // number when kept, box of the first-stage solutions in the model of each function
+        int cbkept;
+        int cbevals;
+        int cbcuts;
+        double *cbsolmin;
+        double *cbsolmax;
         // iteration limit for CB
         int current_itlim;
 
@@ -695,6 +869,10 @@ extern "C" {
         // The lower bound in the node
         double bound;
 
+        // Position in the front and in the front heaps (-1 if not in the front)
+        int    frontpos;
+        int    heappos[2];
+
         // For the risk measure absolute semideviation
         double target;
 
@@ -734,6 +912,7 @@ extern "C" {
 // CPLEX environement and lp pointer
     extern CPXENVptr    DDSIP_env;
     extern CPXLPptr     DDSIP_lp;
+    extern cpxstate_t   DDSIP_cpxstate;
     extern CPXENVptr    DDSIP_dual_env;
     //extern CPXLPptr     DDSIP_dual_lp;
 
@@ -785,6 +964,9 @@ extern "C" {
 
     int DDSIP_Equal(double, double);
     int DDSIP_MultEqual(double *, double *);
+    unsigned int DDSIP_FirstHash(double *, int *);
+    void DDSIP_CutPoolCheck(int, double **, double, double, int *, double *);
+    void DDSIP_CutPoolActivity(double **);
     void DDSIP_qsort_ins_D(const double *, int *, int, int);
     void DDSIP_qsort_ins_A(const double *, int *, int, int);
     int  DDSIP_Error(int);
@@ -809,11 +991,19 @@ extern "C" {
 // Manage cplex parameter sets
     int  DDSIP_InitCpxPara(void);
     int  DDSIP_SetCpxPara(const int, const int*, const int*, const double*);
+    int  DDSIP_SetCpxParaEnv(CPXENVptr, cpxstate_t*, const int, const int*, const int*, const double*);
+    int  DDSIP_SetCpxCutoff(double, double *);
+    void DDSIP_FreeCpxState(cpxstate_t*);
     int  DDSIP_CpxParaPrint(void);
 
 // Initialisations and stuff
     void DDSIP_DetEqu(void);
     void DDSIP_CheckRedundancy(int);
+    void DDSIP_DeleteRedundantCuts(void);
+    void DDSIP_FreeRedundancy(void);
+    int  DDSIP_RedundancyTest(CPXENVptr, CPXLPptr, int, double *);
+    void DDSIP_CutPoolAging(void);
+    int  DDSIP_CutPoolReAdd(int);
     int  DDSIP_BbTypeInit(void);
     int  DDSIP_BranchOrder(void);
     int  DDSIP_InitStages(void);
@@ -838,13 +1028,21 @@ extern "C" {
 // B&B
     int  DDSIP_GetBranchIndex (double *);
     int  DDSIP_ChgBounds(int);
+    int  DDSIP_ChgFirstBounds(const double *, const double *);
     int  DDSIP_ChgProb(int, int);
+    int  DDSIP_ChgProbLp(CPXENVptr, CPXLPptr, loaded_t *, int, int);
+    loaded_t *DDSIP_AllocLoaded(void);
+    void DDSIP_FreeLoaded(loaded_t **);
+    void DDSIP_InvalidateLoaded(loaded_t *);
+    void DDSIP_CopyLoaded(loaded_t *, loaded_t *, int);
     int  DDSIP_LowerBound(void);
     int  DDSIP_Heuristics(int *, int, int);
     int  DDSIP_SolChk(double *, int);
     int  DDSIP_UpperBound(int, int);
+    int  DDSIP_UpperBoundBatch(int, double **, int *, double *);
     void DDSIP_EvaluateScenarioSolutions (int *);
     int  DDSIP_RestoreBoundAndType(void);
+    int  DDSIP_RestoreType(void);
     int  DDSIP_Bound(void);
     int  DDSIP_Branch(void);
     void DDSIP_PrintState(int);
@@ -855,20 +1053,42 @@ extern "C" {
     void* DDSIP_Alloc(int,int,const char *);
     void  DDSIP_Free(void **);
     void  DDSIP_FreeNode(int);
+    void  DDSIP_FirstSolRelease(double **);
+    void  DDSIP_FirstSolGroups(double **, int *, int *);
+    void* DDSIP_PoolGet(int,int,int,const char *);
+    void  DDSIP_PoolPut(int,void **);
+    void  DDSIP_FreePool(void);
     void  DDSIP_FreeFrontNodes(void);
     void  DDSIP_FreeData(void);
     void  DDSIP_FreeBb(void);
     void  DDSIP_FreeParam(void);
     void  DDSIP_FreeCutpool(void);
+    void  DDSIP_CutPoolAdd(const double *, double, int, int);
+    void  DDSIP_CutPoolDel(int);
+    void  DDSIP_CutPoolMove(int, int);
 
 // Lagrangian dual
     int DDSIP_NonAnt(void);
+    void DDSIP_NonAntTimes(double **, double *, double *);
+    void DDSIP_LagrangeCost(void);
     int DDSIP_DualUpdate(void*, double *, double, int, double *, int*, double *, double *, double *);
+    int DDSIP_DualUpdateGroup(void*, double *, double, int, double *, int*, double *, double *, double *);
     int DDSIP_DualOpt(void);
     int DDSIP_CBLowerBound(double *, double);
     int DDSIP_Contrib    (double *, int);
     int DDSIP_Contrib_LB (double *, int);
 
+// Concurrent scenario problems
+    int  DDSIP_ThreadsLowerBound(double);
+    int  DDSIP_ThreadsCBLowerBound(int, double);
+    int  DDSIP_ThreadsUpperBound(double, int *);
+    int  DDSIP_ThreadsLBResult(int, double *, int *, int *, double *, double *, int *, int *, double *);
+    int  DDSIP_ThreadsLBStopped(double *);
+    void DDSIP_ThreadsRoundReset(void);
+    int  DDSIP_ThreadsRedundancy(CPXLPptr, int, int, double *);
+    void DDSIP_ThreadsModelChanged(void);
+    void DDSIP_ThreadsFree(void);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -38,6 +38,11 @@ extern "C" {
 // Maximal number of parameters
     extern const int DDSIP_maxparam;
 
+// Number of nodes allocated initially
+    extern const int DDSIP_nodeblock;
+// Number of doubles available for the cache of upper bound results
+    extern const int DDSIP_ubcachemem;
+
 // Number of implemented risk measures
     extern const int DDSIP_maxrisk;
 